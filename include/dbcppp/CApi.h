@@ -175,9 +175,13 @@ extern "C"
     DBCPPP_API const dbcppp_Attribute* dbcppp_MessageAttributeValues_Get(const dbcppp_Message* msg, uint64_t i);
     DBCPPP_API uint64_t dbcppp_MessageAttributeValues_Size(const dbcppp_Message* msg);
     DBCPPP_API const char* dbcppp_MessageComment(const dbcppp_Message* msg);
+    DBCPPP_API const dbcppp_Signal* dbcppp_MessageSignalByName(const dbcppp_Message* msg, const char* name);
     
     DBCPPP_API const dbcppp_Network* dbcppp_NetworkLoadDBCFromFile(const char* filename);
     DBCPPP_API const dbcppp_Network* dbcppp_NetworkLoadDBCFromMemory(const char* data);
+    DBCPPP_API uint64_t dbcppp_NetworkContentHash(const char* data, uint64_t size);
+    DBCPPP_API const dbcppp_Network* dbcppp_NetworkLoadSnapshot(const char* filename, uint64_t dbc_hash);
+    DBCPPP_API int dbcppp_NetworkSaveSnapshot(const dbcppp_Network* net, const char* filename, uint64_t dbc_hash);
     DBCPPP_API const dbcppp_Network* dbcppp_NetworkCreate(
           const char* version
         , const char** new_symbols
@@ -201,6 +205,16 @@ extern "C"
     DBCPPP_API uint64_t dbcppp_NetworkValueTables_Size(const dbcppp_Network* net);
     DBCPPP_API const dbcppp_Message* dbcppp_NetworkMessages_Get(const dbcppp_Network* net, uint64_t i);
     DBCPPP_API uint64_t dbcppp_NetworkMessages_Size(const dbcppp_Network* net);    
+    DBCPPP_API const dbcppp_Message* dbcppp_NetworkMessageById(const dbcppp_Network* net, uint64_t id);
+    DBCPPP_API const dbcppp_Message* dbcppp_NetworkMessageByName(const dbcppp_Network* net, const char* name);
+    DBCPPP_API const dbcppp_Signal* dbcppp_NetworkFindSignal(const dbcppp_Network* net, const char* qualified_name);
+    DBCPPP_API const dbcppp_Node* dbcppp_NetworkNodeByName(const dbcppp_Network* net, const char* name);
+    DBCPPP_API const dbcppp_ValueTable* dbcppp_NetworkValueTableByName(const dbcppp_Network* net, const char* name);
+    DBCPPP_API const dbcppp_Message* dbcppp_NetworkParentMessage(const dbcppp_Network* net, const dbcppp_Signal* sig);
+    DBCPPP_API const dbcppp_Message* dbcppp_NetworkTransmittedMessages_Get(const dbcppp_Network* net, const dbcppp_Node* node, uint64_t i);
+    DBCPPP_API uint64_t dbcppp_NetworkTransmittedMessages_Size(const dbcppp_Network* net, const dbcppp_Node* node);
+    DBCPPP_API const dbcppp_Signal* dbcppp_NetworkReceivedSignals_Get(const dbcppp_Network* net, const dbcppp_Node* node, uint64_t i);
+    DBCPPP_API uint64_t dbcppp_NetworkReceivedSignals_Size(const dbcppp_Network* net, const dbcppp_Node* node);
     DBCPPP_API const dbcppp_EnvironmentVariable* dbcppp_NetworkEnvironmentVariables_Get(const dbcppp_Network* net, uint64_t i);
     DBCPPP_API uint64_t dbcppp_NetworkEnvironmentVariables_Size(const dbcppp_Network* net);
     DBCPPP_API const dbcppp_AttributeDefinition* dbcppp_NetworkAttributeDefinitions_Get(const dbcppp_Network* net, uint64_t i);
@@ -258,6 +272,8 @@ extern "C"
     DBCPPP_API uint64_t dbcppp_SignalReceivers_Size(const dbcppp_Signal* signal);
     DBCPPP_API const dbcppp_ValueEncodingDescription* dbcppp_SignalValueEncodingDescriptions_Get(const dbcppp_Signal* signal, uint64_t i);
     DBCPPP_API uint64_t dbcppp_SignalValueEncodingDescriptions_Size(const dbcppp_Signal* signal);
+    DBCPPP_API const dbcppp_ValueEncodingDescription* dbcppp_SignalValueEncodingDescriptionByValue(const dbcppp_Signal* signal, int64_t value);
+    DBCPPP_API const dbcppp_ValueEncodingDescription* dbcppp_SignalValueEncodingDescriptionByDescription(const dbcppp_Signal* signal, const char* description);
     DBCPPP_API const dbcppp_Attribute* dbcppp_SignalAttributeValues_Get(const dbcppp_Signal* signal, uint64_t i);
     DBCPPP_API uint64_t dbcppp_SignalAttributeValues_Size(const dbcppp_Signal* signal);
     DBCPPP_API const char* dbcppp_SignalComment(const dbcppp_Signal* sig);
@@ -296,6 +312,8 @@ extern "C"
     DBCPPP_API const dbcppp_SignalType* dbcppp_ValueTableSignalType(const dbcppp_ValueTable* value_table);
     DBCPPP_API const dbcppp_ValueEncodingDescription* dbcppp_ValueTableValueEncodingDescription_Get(const dbcppp_ValueTable* value_table, uint64_t i);
     DBCPPP_API uint64_t dbcppp_ValueTableValueEncodingDescription_Size(const dbcppp_ValueTable* value_table);
+    DBCPPP_API const dbcppp_ValueEncodingDescription* dbcppp_ValueTableValueEncodingDescriptionByValue(const dbcppp_ValueTable* value_table, int64_t value);
+    DBCPPP_API const dbcppp_ValueEncodingDescription* dbcppp_ValueTableValueEncodingDescriptionByDescription(const dbcppp_ValueTable* value_table, const char* description);
     
     DBCPPP_API const dbcppp_ValueEncodingDescription* dbcppp_ValueEncodingDescriptionCreate(uint64_t value, const char* desc);
     DBCPPP_API void dbcppp_ValueEncodingDescriptionFree(const dbcppp_ValueEncodingDescription* ved);
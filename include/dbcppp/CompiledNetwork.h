@@ -0,0 +1,281 @@
+#pragma once
+
+#include <bit>
+#include <span>
+#include <limits>
+#include <memory>
+#include <filesystem>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#if defined(_MSC_VER)
+#   include <stdlib.h>
+#endif
+
+#include "Export.h"
+#include "Network.h"
+
+namespace dbcppp
+{
+    /// \brief Immutable, decode optimized view of a network
+    ///
+    /// The hot decode state of all signals is compiled into flat 32 byte descriptors which are stored
+    /// contiguously per message, messages are stored in a table sorted by id. Cold metadata like names and
+    /// units is stored separately. The compiled network doesn't reference the network it was built from.
+    /// This is the recommended structure for decoding on the hot path.
+    ///
+    /// A compiled network loaded from a snapshot uses the descriptors and names in place from the mapped file.
+    class DBCPPP_API CompiledNetwork final
+    {
+    public:
+        using raw_t = ISignal::raw_t;
+
+        struct alignas(32) SignalDescriptor
+        {
+            enum EFlags
+                : uint8_t
+            {
+                BigEndian = 1 << 0,
+                Signed = 1 << 1,
+                Float = 1 << 2,
+                Double = 1 << 3,
+                // the signal spans 9 bytes
+                NineBytes = 1 << 4,
+                MuxSwitch = 1 << 5
+            };
+
+            uint64_t mask;
+            double factor;
+            double offset;
+            uint16_t byte_pos;
+            uint8_t fixed_start_bit_0;
+            uint8_t fixed_start_bit_1;
+            uint8_t bit_size;
+            uint8_t flags;
+            // position of the signal in the source message
+            uint16_t index;
+
+            /// \brief Decodes the raw value, the same requirements as for ISignal::Decode apply
+            inline raw_t Decode(const void* frame) const noexcept
+            {
+                const uint8_t* bytes = static_cast<const uint8_t*>(frame) + byte_pos;
+                uint64_t data;
+                std::memcpy(&data, bytes, sizeof(data));
+                data = flags & BigEndian ? ToBig(data) : ToLittle(data);
+                if (flags & NineBytes)
+                {
+                    uint64_t data1 = bytes[8];
+                    if (flags & BigEndian)
+                    {
+                        data &= mask;
+                        data <<= fixed_start_bit_0;
+                        data1 >>= fixed_start_bit_1;
+                    }
+                    else
+                    {
+                        data >>= fixed_start_bit_0;
+                        data1 &= mask;
+                        data1 <<= fixed_start_bit_1;
+                    }
+                    data |= data1;
+                    if (flags & (Float | Double))
+                    {
+                        return data;
+                    }
+                }
+                else
+                {
+                    if (flags & Double)
+                    {
+                        return data;
+                    }
+                    data >>= fixed_start_bit_0;
+                    data &= mask;
+                    if (flags & Float)
+                    {
+                        return data;
+                    }
+                }
+                if (flags & Signed)
+                {
+                    uint64_t mask_signed = ~((1ull << (bit_size - 1ull)) - 1);
+                    if (data & mask_signed)
+                    {
+                        data |= mask_signed;
+                    }
+                }
+                return data;
+            }
+            inline double RawToPhys(raw_t raw) const noexcept
+            {
+                double draw;
+                if (flags & Double)
+                {
+                    draw = std::bit_cast<double>(raw);
+                }
+                else if (flags & Float)
+                {
+                    draw = double(std::bit_cast<float>(uint32_t(raw)));
+                }
+                else if (flags & Signed)
+                {
+                    draw = double(int64_t(raw));
+                }
+                else
+                {
+                    draw = double(raw);
+                }
+                return draw * factor + offset;
+            }
+        };
+        static_assert(sizeof(SignalDescriptor) == 32);
+
+        // signals which are active for one value of the mux switch
+        struct MuxGroup
+        {
+            uint64_t switch_value;
+            uint32_t first_signal;
+            uint32_t n_signals;
+        };
+        struct Message
+        {
+            uint64_t id;
+            uint64_t message_size;
+            // the descriptors of the message are [first_signal, first_signal + n_signals), they are ordered
+            // as: always active signals with the mux switch first, the mux groups, the signals with extended
+            // multiplexing
+            uint32_t first_signal;
+            uint32_t n_signals;
+            uint32_t n_always;
+            uint32_t n_extended;
+            uint32_t first_group;
+            uint32_t n_groups;
+            // position of the message in the source network
+            uint32_t index;
+        };
+
+        /// \brief Compiles the network
+        ///
+        /// The network has to be created by this library, e.g. by a loader, INetwork::Create or Clone, other
+        /// implementations of INetwork aren't supported.
+        static std::unique_ptr<CompiledNetwork> Create(const INetwork& net);
+        /// \brief Loads the compiled network from a snapshot written by INetwork::SaveSnapshot without parsing
+        ///
+        /// @return nullptr under the same conditions as INetwork::LoadSnapshot
+        static std::unique_ptr<CompiledNetwork> LoadSnapshot(const std::filesystem::path& filename, uint64_t dbc_hash);
+
+        CompiledNetwork(const CompiledNetwork&) = delete;
+        CompiledNetwork& operator=(const CompiledNetwork&) = delete;
+        ~CompiledNetwork();
+
+        std::span<const Message> Messages() const noexcept
+        {
+            return _messages;
+        }
+        /// \brief Finds a message by a binary search in the sorted id table
+        ///
+        /// @return the message or nullptr if there is no message with this id
+        const Message* MessageById(uint64_t id) const noexcept
+        {
+            auto iter = std::lower_bound(_messages.begin(), _messages.end(), id,
+                [](const Message& msg, uint64_t id) { return msg.id < id; });
+            return iter != _messages.end() && iter->id == id ? &*iter : nullptr;
+        }
+        std::span<const SignalDescriptor> Signals(const Message& msg) const noexcept
+        {
+            return {_signals.data() + msg.first_signal, msg.n_signals};
+        }
+        std::span<const MuxGroup> MuxGroups(const Message& msg) const noexcept
+        {
+            return {_groups.data() + msg.first_group, msg.n_groups};
+        }
+        /// \brief Decodes all active signals of the message, same semantics as IMessage::DecodeAll
+        ///
+        /// @param raw buffer for the raw values in the order of the signals of the source message
+        /// @param phys buffer for the physical values or empty
+        void Decode(const Message& msg, const void* frame, std::span<raw_t> raw, std::span<double> phys) const noexcept
+        {
+            const SignalDescriptor* sigs = _signals.data() + msg.first_signal;
+            const bool convert = !phys.empty();
+            uint64_t switch_value = 0;
+            auto decode =
+                [&](const SignalDescriptor& sig)
+                {
+                    raw_t r = sig.Decode(frame);
+                    raw[sig.index] = r;
+                    if (sig.flags & SignalDescriptor::MuxSwitch)
+                    {
+                        switch_value = r;
+                    }
+                    if (convert)
+                    {
+                        phys[sig.index] = sig.RawToPhys(r);
+                    }
+                };
+            for (uint32_t i = 0; i < msg.n_always; i++)
+            {
+                decode(sigs[i]);
+            }
+            if (msg.n_groups != 0)
+            {
+                auto groups = MuxGroups(msg);
+                if (convert)
+                {
+                    const uint32_t end = msg.n_signals - msg.n_extended;
+                    for (uint32_t i = msg.n_always; i < end; i++)
+                    {
+                        phys[sigs[i].index] = std::numeric_limits<double>::quiet_NaN();
+                    }
+                }
+                auto iter = std::lower_bound(groups.begin(), groups.end(), switch_value,
+                    [](const MuxGroup& group, uint64_t value) { return group.switch_value < value; });
+                if (iter != groups.end() && iter->switch_value == switch_value)
+                {
+                    for (uint32_t i = iter->first_signal; i < iter->first_signal + iter->n_signals; i++)
+                    {
+                        decode(sigs[i]);
+                    }
+                }
+            }
+            if (msg.n_extended != 0)
+            {
+                DecodeExtended(msg, frame, raw, phys);
+            }
+        }
+
+        std::string_view Name(const Message& msg) const noexcept;
+        std::string_view Name(const SignalDescriptor& sig) const noexcept;
+        std::string_view Unit(const SignalDescriptor& sig) const noexcept;
+
+    private:
+        friend class Snapshot;
+        struct Cold;
+
+        CompiledNetwork();
+
+        static inline uint64_t ByteSwap(uint64_t value) noexcept
+        {
+#if defined(_MSC_VER)
+            return _byteswap_uint64(value);
+#else
+            return __builtin_bswap64(value);
+#endif
+        }
+        static inline uint64_t ToBig(uint64_t value) noexcept
+        {
+            return std::endian::native == std::endian::little ? ByteSwap(value) : value;
+        }
+        static inline uint64_t ToLittle(uint64_t value) noexcept
+        {
+            return std::endian::native == std::endian::big ? ByteSwap(value) : value;
+        }
+        void DecodeExtended(const Message& msg, const void* frame, std::span<raw_t> raw, std::span<double> phys) const noexcept;
+
+        // point either into the cold storage or into a mapped snapshot
+        std::span<const Message> _messages;
+        std::span<const SignalDescriptor> _signals;
+        std::span<const MuxGroup> _groups;
+        std::unique_ptr<Cold> _cold;
+    };
+}
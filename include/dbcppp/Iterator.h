@@ -1,10 +1,13 @@
-
 #pragma once
 
-#include <functional>
+#include <cstddef>
+#include <iterator>
 
 namespace dbcppp
 {
+    // Walks the elements of an Iterable by adding a constant stride to the address of the first one, so neither
+    // dereferencing nor advancing goes through a virtual call. The stride is the distance between two elements
+    // and doesn't have to be sizeof(T), e.g. for a vector of implementations of the interface T.
     template <class T>
     class Iterator
     {
@@ -15,88 +18,151 @@ namespace dbcppp
         using value_type        = T;
         using pointer           = const value_type*;
         using reference         = const value_type&;
-        using get_t             = std::function<reference (std::size_t)>;
 
-        Iterator(get_t get, std::size_t i)
-            : _get(get)
-            , _i(i)
+        Iterator() = default;
+        Iterator(pointer first, std::size_t stride, std::size_t i)
+            : _p(reinterpret_cast<const char*>(first) + i * stride)
+            , _stride(stride)
         {}
         reference operator*() const
         {
-            return _get(_i);
+            return *reinterpret_cast<pointer>(_p);
         }
         pointer operator->() const
         {
-            return &_get(_i);
+            return reinterpret_cast<pointer>(_p);
+        }
+        reference operator[](difference_type o) const
+        {
+            return *(*this + o);
         }
         self_t& operator++()
         {
-            _i++;
+            _p += _stride;
+            return *this;
+        }
+        self_t operator++(int)
+        {
+            self_t tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        self_t& operator--()
+        {
+            _p -= _stride;
             return *this;
         }
-        self_t operator+(std::size_t o)
+        self_t operator--(int)
+        {
+            self_t tmp = *this;
+            --*this;
+            return tmp;
+        }
+        self_t operator+(difference_type o) const
         {
-            return {_get, _i + o};
+            self_t result = *this;
+            return result += o;
         }
-        self_t operator-(std::size_t o)
+        friend self_t operator+(difference_type o, const self_t& rhs)
         {
-            return {_get, _i + o};
+            return rhs + o;
         }
-        difference_type operator-(const self_t& rhs)
+        self_t operator-(difference_type o) const
         {
-            return _i - rhs._i;
+            self_t result = *this;
+            return result -= o;
         }
-        self_t& operator+=(std::size_t o)
+        difference_type operator-(const self_t& rhs) const
         {
-            _i += o;
+            return _stride ? (_p - rhs._p) / difference_type(_stride) : 0;
+        }
+        self_t& operator+=(difference_type o)
+        {
+            _p += o * difference_type(_stride);
             return *this;
         }
-        self_t& operator-=(std::size_t o)
+        self_t& operator-=(difference_type o)
         {
-            _i -= o;
+            _p -= o * difference_type(_stride);
             return *this;
         }
 
         bool operator==(const self_t& rhs) const
         {
-            return _i == rhs._i;
+            return _p == rhs._p;
         }
         bool operator!=(const self_t& rhs) const
         {
             return !(*this == rhs);
         }
+        bool operator<(const self_t& rhs) const
+        {
+            return _p < rhs._p;
+        }
+        bool operator>(const self_t& rhs) const
+        {
+            return rhs < *this;
+        }
+        bool operator<=(const self_t& rhs) const
+        {
+            return !(rhs < *this);
+        }
+        bool operator>=(const self_t& rhs) const
+        {
+            return !(*this < rhs);
+        }
 
     private:
-        get_t _get;
-        std::size_t _i;
+        const char* _p = nullptr;
+        std::size_t _stride = 0;
     };
+    // A non-owning view of the elements of an object, it's invalidated when the object is changed or destroyed.
     template <class Iterator>
     class Iterable
     {
     public:
+        using value_type = typename Iterator::value_type;
+        using reference  = typename Iterator::reference;
+
         Iterable(Iterator begin, Iterator end)
             : _begin(begin)
             , _end(end)
         {}
-        Iterator& begin()
+        Iterator begin() const
         {
             return _begin;
         }
-        Iterator& end()
+        Iterator end() const
         {
             return _end;
         }
+        std::size_t size() const
+        {
+            return std::size_t(_end - _begin);
+        }
+        bool empty() const
+        {
+            return _begin == _end;
+        }
+        reference operator[](std::size_t i) const
+        {
+            return _begin[i];
+        }
 
     private:
         Iterator _begin;
         Iterator _end;
     };
 }
-#define DBCPPP_MAKE_ITERABLE(ClassName, Name, Type)                                 \
-    auto Name() const                                                               \
-    {                                                                               \
-        auto get = std::bind(&ClassName::Name##_Get, this, std::placeholders::_1);  \
-        Iterator<Type> begin(get, 0);                                               \
-        Iterator<Type> end(get, Name##_Size());                                     \
-        return Iterable(begin, end);                                                \
+// The view is taken from the address of the first two elements, so Name##_Get has to return elements which lie a
+// constant distance apart, like the elements of a vector.
+#define DBCPPP_MAKE_ITERABLE(ClassName, Name, Type)                                                   \
+    auto Name() const                                                                                 \
+    {                                                                                                 \
+        const std::size_t size = std::size_t(Name##_Size());                                          \
+        const Type* first = size ? &Name##_Get(0) : nullptr;                                          \
+        const std::size_t stride = size > 1                                                           \
+            ? std::size_t(reinterpret_cast<const char*>(&Name##_Get(1)) - reinterpret_cast<const char*>(first)) \
+            : sizeof(Type);                                                                           \
+        return Iterable(Iterator<Type>(first, stride, 0), Iterator<Type>(first, stride, size));      \
     }
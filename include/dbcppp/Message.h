@@ -3,6 +3,8 @@
 #include <cstddef>
 #include <string>
 #include <memory>
+#include <span>
+#include <string_view>
 
 #include "Export.h"
 #include "Iterator.h"
@@ -51,6 +53,63 @@ namespace dbcppp
         virtual const ISignalGroup& SignalGroups_Get(std::size_t i) const = 0;
         virtual uint64_t SignalGroups_Size() const = 0;
         virtual const ISignal* MuxSignal() const = 0;
+        /// \brief Finds the signal with the given name
+        ///
+        /// The name index is built on the first call, concurrent calls are safe.
+        ///
+        /// @return the signal or nullptr if the message doesn't contain a signal with this name
+        virtual const ISignal* SignalByName(std::string_view name) const = 0;
+
+        /// \brief Decodes all signals of the message in one pass
+        ///
+        /// Runs the decode program which is compiled once on construction of the message. The results
+        /// are stored in the same order as the signals are returned by Signals_Get.
+        /// Signals which are not active for the decoded multiplexer switch value are skipped, their raw
+        /// value is left untouched and their physical value is set to NaN. The active signals are looked
+        /// up in a dispatch table indexed by the switch value, so only they are decoded.
+        /// The same applies to signals with extended multiplexing (SG_MUL_VAL_), see ActiveSignals.
+        /// Setting the physical values of the inactive signals to NaN touches every multiplexed signal of the
+        /// message on each call, for messages with many multiplexed signals it's cheaper to decode only the raw
+        /// values and to convert the ones of the active signals, see ActiveSignals.
+        ///
+        /// @param bytes the frame data, see ISignal::Decode for the requirements
+        /// @param raw buffer for the raw values, must hold at least Signals_Size() elements
+        /// @param phys buffer for the physical values, must hold at least Signals_Size() elements or be empty,
+        ///             if empty only the raw values are decoded
+        virtual void DecodeAll(const void* bytes, std::span<ISignal::raw_t> raw, std::span<double> phys) const noexcept = 0;
+        /// \brief Decodes all signals of the message from n consecutive frames into one column per signal
+        ///
+        /// The raw values of the i-th signal are stored at columns[i * n] to columns[i * n + n - 1].
+        /// Multiplexing is not taken into account, every signal is decoded for every frame.
+        ///
+        /// @param frames pointer to the data of the first frame, see ISignal::DecodeColumn
+        /// @param stride distance in bytes between the beginning of two frames
+        /// @param n number of frames
+        /// @param columns buffer for the raw values, must hold at least Signals_Size() * n elements
+        virtual void DecodeColumns(const uint8_t* frames, std::size_t stride, std::size_t n, ISignal::raw_t* columns) const noexcept = 0;
+        /// \brief Encodes the whole frame from the physical values of all signals in one pass
+        ///
+        /// Bytes which are not covered by an encoded signal are taken from the default frame, which is built
+        /// once from the GenSigStartValue attributes of the signals.
+        /// Of the multiplexed signals only those which are active for the switch values given in phys are
+        /// encoded, see ActiveSignals. Overlapping signals are encoded in the order they are returned by
+        /// Signals_Get.
+        ///
+        /// @param phys the physical values in the same order as the signals are returned by Signals_Get,
+        ///             must hold at least Signals_Size() elements
+        /// @param frame buffer for the frame, exactly MessageSize() bytes are written
+        virtual void EncodeAll(std::span<const double> phys, void* frame) const = 0;
+        /// \brief Determines the signals which are active in the given frame
+        ///
+        /// A signal is active if it isn't multiplexed, if its multiplexer switch value matches the decoded
+        /// mux signal or, with extended multiplexing (SG_MUL_VAL_), if one of its switches is active and the
+        /// value of that switch lies in one of the given ranges. The extended multiplexing is compiled into
+        /// a graph on construction of the message, so every switch is decoded at most once.
+        ///
+        /// @param bytes the frame data, see ISignal::Decode for the requirements
+        /// @param active buffer for the indices of the active signals, must hold at least Signals_Size() elements
+        /// @return the number of active signals, their indices are stored in ascending order
+        virtual std::size_t ActiveSignals(const void* bytes, std::span<std::size_t> active) const noexcept = 0;
         
         DBCPPP_MAKE_ITERABLE(IMessage, MessageTransmitters, std::string);
         DBCPPP_MAKE_ITERABLE(IMessage, Signals, ISignal);
@@ -2,7 +2,9 @@
 
 #include <memory>
 #include <iostream>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <istream>
 #include <functional>
@@ -22,6 +24,50 @@
 
 namespace dbcppp
 {
+    /// \brief Selects the messages which are loaded from a DBC
+    ///
+    /// A message is loaded if its id is one of ids, lies in one of id_ranges or its name matches one of
+    /// name_patterns, an empty filter loads all messages. Comments, attributes, value descriptions and the other
+    /// statements referring to a message which isn't loaded are dropped as well.
+    struct DBCPPP_API DBCMessageFilter
+    {
+        /// \brief Ids as returned by IMessage::Id
+        std::vector<uint64_t> ids;
+        /// \brief Inclusive ranges of ids
+        std::vector<std::pair<uint64_t, uint64_t>> id_ranges;
+        /// \brief Patterns matching the whole name, '*' matches any sequence of characters and '?' any single one
+        std::vector<std::string> name_patterns;
+
+        bool Empty() const noexcept;
+        bool Matches(uint64_t id, std::string_view name) const noexcept;
+    };
+    /// \brief Options of the DBC loaders
+    struct DBCPPP_API DBCLoadOptions
+    {
+        /// \brief Number of threads a single DBC is parsed with, 0 uses all hardware threads
+        ///
+        /// Big DBCs are split at top level statements and the parts are parsed in parallel, the result and the
+        /// reported errors are the same as for sequential parsing.
+        std::size_t threads = 1;
+        /// \brief Parse the common statements with a hand written parser
+        ///
+        /// Messages, comments, attributes and value descriptions are parsed without the grammar, anything else
+        /// is left to it. The result and the reported errors are the same as without this option.
+        bool fast_parse = false;
+        /// \brief Messages which are loaded
+        ///
+        /// With fast_parse the messages which are filtered out are skipped while parsing, otherwise they are parsed
+        /// and dropped when the network is built.
+        DBCMessageFilter messages;
+        /// \brief Parse comments, attribute values and environment variables on their first access
+        ///
+        /// The statements are only delimited while loading and parsed with the hand written parser once any
+        /// comment, attribute value or environment variable of the network or of one of its nodes, messages or
+        /// signals is accessed, which is thread safe. The GenSigStartValue attributes are needed for encoding and
+        /// are always loaded. Errors in the lazily parsed statements aren't reported, the statements are silently
+        /// ignored instead. The DBC file stays mapped until the statements are parsed.
+        bool lazy_metadata = false;
+    };
     class DBCPPP_API INetwork
     {
     public:
@@ -37,11 +83,41 @@ namespace dbcppp
             , std::vector<std::unique_ptr<IAttribute>>&& attribute_defaults
             , std::vector<std::unique_ptr<IAttribute>>&& attribute_values
             , std::string&& comment);
-        static std::map<std::string, std::unique_ptr<INetwork>> LoadNetworkFromFile(const std::filesystem::path& filename);
-        static std::unique_ptr<INetwork> LoadDBCFromIs(std::istream& is);
+        static std::map<std::string, std::unique_ptr<INetwork>> LoadNetworkFromFile(const std::filesystem::path& filename, const DBCLoadOptions& options = {});
+        /// \brief Loads each file like LoadNetworkFromFile, the files are loaded concurrently on up to n_threads threads,
+        /// 0 uses all hardware threads
+        ///
+        /// @return the networks of each file in the order of the filenames, the map of a file which can't be loaded is empty
+        static std::vector<std::map<std::string, std::unique_ptr<INetwork>>> LoadNetworkMapsFromFiles(
+            std::span<const std::filesystem::path> filenames, std::size_t n_threads = 0, const DBCLoadOptions& options = {});
+        /// \brief Loads the files concurrently like LoadNetworkMapsFromFiles and merges all their networks into the first one
+        ///
+        /// The networks are merged in the order of the filenames, so the result doesn't depend on which file is loaded
+        /// first.
+        ///
+        /// @return nullptr if one of the files can't be loaded, an empty network if there are no files
+        static std::unique_ptr<INetwork> LoadNetworksFromFiles(
+            std::span<const std::filesystem::path> filenames, std::size_t n_threads = 0, const DBCLoadOptions& options = {});
+        static std::unique_ptr<INetwork> LoadDBCFromIs(std::istream& is, const DBCLoadOptions& options = {});
+        /// \brief Parses a DBC file, the file is memory mapped and parsed in place instead of being copied
+        ///
+        /// @return nullptr if the file can't be opened or parsed
+        static std::unique_ptr<INetwork> LoadDBCFromFile(const std::filesystem::path& filename, const DBCLoadOptions& options = {});
+        /// \brief Parses DBC content in place, the content doesn't have to be null terminated
+        static std::unique_ptr<INetwork> LoadDBCFromMemory(const char* data, std::size_t size, const DBCLoadOptions& options = {});
 #ifdef ENABLE_KCD
         static std::map<std::string, std::unique_ptr<INetwork>> LoadKCDFromIs(std::istream& is);
 #endif        
+        /// \brief Hashes DBC content, the hash identifies the DBC a snapshot was created from
+        static uint64_t ContentHash(std::string_view content);
+        /// \brief Loads a network from a snapshot written by SaveSnapshot without parsing
+        ///
+        /// The snapshot is memory mapped, its checksum is verified before it's used.
+        ///
+        /// @param dbc_hash ContentHash of the DBC the snapshot is expected to be created from
+        /// @return nullptr if the snapshot doesn't exist, is corrupted, was written by an incompatible version
+        ///         or was created from another DBC, in which case the DBC has to be parsed instead
+        static std::unique_ptr<INetwork> LoadSnapshot(const std::filesystem::path& filename, uint64_t dbc_hash);
         
         virtual std::unique_ptr<INetwork> Clone() const = 0;
 
@@ -75,11 +151,49 @@ namespace dbcppp
         DBCPPP_MAKE_ITERABLE(INetwork, AttributeDefaults, IAttribute);
         DBCPPP_MAKE_ITERABLE(INetwork, AttributeValues, IAttribute);
 
+        /// \brief Returns the message containing the signal in constant time
+        ///
+        /// Like the other relations the index is built on the first call, concurrent calls are safe.
+        ///
+        /// @return the message or nullptr if the signal doesn't belong to the network
         virtual const IMessage* ParentMessage(const ISignal* sig) const = 0;
+        /// \brief Returns the messages which are transmitted by the node, as transmitter or listed in BO_TX_BU_
+        ///
+        /// @param node a node of this network
+        virtual std::span<const IMessage* const> TransmittedMessages(const INode& node) const = 0;
+        /// \brief Returns the signals which are received by the node
+        ///
+        /// @param node a node of this network
+        virtual std::span<const ISignal* const> ReceivedSignals(const INode& node) const = 0;
+        /// \brief Finds the message with the given id in constant time
+        ///
+        /// @param id the message id as returned by IMessage::Id
+        /// @return the message or nullptr if the network doesn't contain a message with this id
+        virtual const IMessage* MessageById(uint64_t id) const = 0;
+        /// \brief Finds the message with the given name
+        ///
+        /// Like all lookups by name the index is built on the first call, concurrent calls are safe.
+        ///
+        /// @return the message or nullptr if the network doesn't contain a message with this name
+        virtual const IMessage* MessageByName(std::string_view name) const = 0;
+        /// \brief Finds a signal by its qualified name "<message name>.<signal name>"
+        ///
+        /// @return the signal or nullptr if there is no such message or signal
+        virtual const ISignal* FindSignal(std::string_view qualified_name) const = 0;
+        /// @return the node or nullptr if the network doesn't contain a node with this name
+        virtual const INode* NodeByName(std::string_view name) const = 0;
+        /// @return the value table or nullptr if the network doesn't contain a value table with this name
+        virtual const IValueTable* ValueTableByName(std::string_view name) const = 0;
 
         virtual bool operator==(const INetwork& rhs) const = 0;
         virtual bool operator!=(const INetwork& rhs) const = 0;
 
         void Merge(std::unique_ptr<INetwork>&& other);
+        /// \brief Writes a binary snapshot of the network which also contains the compiled network
+        ///
+        /// The file is replaced atomically, so concurrent loaders see either the old or the new snapshot.
+        ///
+        /// @return false if the snapshot couldn't be written
+        bool SaveSnapshot(const std::filesystem::path& filename, uint64_t dbc_hash) const;
     };
 }
\ No newline at end of file
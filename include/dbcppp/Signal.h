@@ -6,6 +6,7 @@
 #include <string>
 #include <cstddef>
 #include <span>
+#include <string_view>
 
 #include "Export.h"
 #include "Iterator.h"
@@ -86,6 +87,17 @@ namespace dbcppp
         virtual uint64_t Receivers_Size() const = 0;
         virtual const IValueEncodingDescription& ValueEncodingDescriptions_Get(std::size_t i) const = 0;
         virtual uint64_t ValueEncodingDescriptions_Size() const = 0;
+        /// \brief Finds the value encoding description (VAL_) of a value
+        ///
+        /// Small enums are looked up in a dense array, all others in a sorted flat map.
+        ///
+        /// @param value the raw value, decoded signed values can be passed as they are returned by Decode
+        /// @return the description or nullptr if there is none for this value
+        virtual const IValueEncodingDescription* ValueEncodingDescriptionByValue(int64_t value) const = 0;
+        /// \brief Finds the value encoding description (VAL_) by its text, e.g. to encode from strings
+        ///
+        /// @return the description or nullptr if there is none with this text
+        virtual const IValueEncodingDescription* ValueEncodingDescriptionByDescription(std::string_view description) const = 0;
         virtual const IAttribute& AttributeValues_Get(std::size_t i) const = 0;
         virtual uint64_t AttributeValues_Size() const = 0;
         virtual const std::string& Comment() const = 0;
@@ -114,11 +126,28 @@ namespace dbcppp
         ///               (like the Unix CAN frame does store the data)
         using raw_t = uint64_t;
         inline raw_t Decode(const void* bytes) const noexcept { return _decode(this, reinterpret_cast<const uint8_t*>(bytes) + _byte_pos); }
+        /// \brief Writes the raw value into the given n byte array
+        ///
+        /// The counterpart of Decode. The bits which don't belong to the signal are left untouched.
+        /// Only the bytes the signal spans are read and written, so the buffer has to reach to the last
+        /// byte of the signal, e.g. a buffer of MessageSize() bytes.
         inline void Encode(raw_t raw, void* buffer) const noexcept { return _encode(this, raw, buffer); }
         
         inline uint64_t BytePos() const noexcept { return _byte_pos; }
         inline raw_t DecodeSeries(const void* bytes) const noexcept { return _decode(this, bytes); }
 
+        /// \brief Extracts the raw values of this signal from n consecutive frames
+        ///
+        /// Decodes the signal from n frames which are stored stride bytes apart and writes the n raw values
+        /// into out. Depending on the build this function uses SIMD instructions to decode multiple frames at once.
+        /// !!! Note: Every frame has to fulfill the requirements of Decode !!!
+        ///
+        /// @param frames pointer to the data of the first frame
+        /// @param stride distance in bytes between the beginning of two frames
+        /// @param n number of frames
+        /// @param out buffer for the raw values, must hold at least n elements
+        inline void DecodeColumn(const uint8_t* frames, std::size_t stride, std::size_t n, raw_t* out) const noexcept { _decode_column(this, frames, stride, n, out); }
+
         inline double RawToPhys(raw_t raw) const noexcept { return _raw_to_phys(this, raw); }
         inline raw_t PhysToRaw(double phys) const noexcept { return _phys_to_raw(this, phys); }
         
@@ -130,6 +159,7 @@ namespace dbcppp
     protected:
         // instead of using virtuals dynamic dispatching use function pointers
         raw_t (*_decode)(const ISignal* sig, const void* bytes) noexcept {nullptr};
+        void (*_decode_column)(const ISignal* sig, const uint8_t* frames, std::size_t stride, std::size_t n, raw_t* out) noexcept {nullptr};
         void (*_encode)(const ISignal* sig, raw_t raw, void* buffer) noexcept {nullptr};
         double (*_raw_to_phys)(const ISignal* sig, raw_t raw) noexcept {nullptr};
         raw_t (*_phys_to_raw)(const ISignal* sig, double phys) noexcept {nullptr};
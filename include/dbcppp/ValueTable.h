@@ -4,6 +4,7 @@
 #include <string>
 #include <memory>
 #include <optional>
+#include <string_view>
 
 #include "Export.h"
 #include "SignalType.h"
@@ -26,6 +27,10 @@ namespace dbcppp
         virtual std::optional<std::reference_wrapper<const ISignalType>> SignalType() const = 0;
         virtual const IValueEncodingDescription& ValueEncodingDescriptions_Get(std::size_t i) const = 0;
         virtual uint64_t ValueEncodingDescriptions_Size() const = 0;
+        /// \brief Finds the value encoding description of a value, see ISignal::ValueEncodingDescriptionByValue
+        virtual const IValueEncodingDescription* ValueEncodingDescriptionByValue(int64_t value) const = 0;
+        /// \brief Finds the value encoding description by its text
+        virtual const IValueEncodingDescription* ValueEncodingDescriptionByDescription(std::string_view description) const = 0;
 
         DBCPPP_MAKE_ITERABLE(IValueTable, ValueEncodingDescriptions, IValueEncodingDescription);
         
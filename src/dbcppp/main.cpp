@@ -58,15 +58,13 @@ int main(int argc, char** argv)
             return 1;
         }
         const auto& format = vm["format"].as<std::string>();
-        auto dbcs = vm["dbc"].as<std::vector<std::string>>();
-        auto net = dbcppp::INetwork::Create({}, {}, dbcppp::IBitTiming::Create(0, 0, 0), {}, {}, {}, {}, {}, {}, {}, {});
-        for (const auto& dbc : dbcs)
+        const auto& dbcs = vm["dbc"].as<std::vector<std::string>>();
+        std::vector<std::filesystem::path> dbc_files(dbcs.begin(), dbcs.end());
+        auto net = dbcppp::INetwork::LoadNetworksFromFiles(dbc_files);
+        if (!net)
         {
-            auto nets = dbcppp::INetwork::LoadNetworkFromFile(dbc);
-            for (auto& other : nets)
-            {
-                net->Merge(std::move(other.second));
-            }
+            std::cout << "error: could not load the DBCs" << std::endl;
+            return 1;
         }
         if (format == "C")
         {
@@ -111,37 +109,44 @@ int main(int argc, char** argv)
             std::string name;
             std::unique_ptr<dbcppp::INetwork> net;
         };
-        std::unordered_map<std::string, Bus> buses;
+        std::vector<std::string> bus_names;
+        std::vector<std::filesystem::path> dbc_files;
         for (const auto& opt_bus : opt_buses)
         {
             std::istringstream ss(opt_bus);
-            std::string opt;
-            Bus b;
-            if (std::getline(ss, opt, ':'))
+            std::string name;
+            std::string dbc;
+            if (!std::getline(ss, name, ':') || !std::getline(ss, dbc))
             {
-                b.name = opt;
+                std::cout << "error: could parse bus parameter" << std::endl;
+                return 1;
             }
-            else
+            bus_names.push_back(name);
+            dbc_files.push_back(dbc);
+        }
+        // the DBCs are loaded concurrently, the DBCs of a bus which is given several times are merged
+        auto nets = dbcppp::INetwork::LoadNetworkMapsFromFiles(dbc_files);
+        std::unordered_map<std::string, Bus> buses;
+        for (std::size_t i = 0; i < nets.size(); i++)
+        {
+            if (nets[i].empty())
             {
-                std::cout << "error: could parse bus parameter" << std::endl;
+                std::cout << "error: could not load DBC '" << dbc_files[i].string() << "'" << std::endl;
                 return 1;
             }
-            if (std::getline(ss, opt))
+            auto& b = buses[bus_names[i]];
+            b.name = bus_names[i];
+            for (auto& [_, net] : nets[i])
             {
-                std::ifstream fdbc(opt);
-                b.net = dbcppp::INetwork::LoadDBCFromIs(fdbc);
                 if (!b.net)
                 {
-                    std::cout << "error: could not load DBC '" << opt << "'" << std::endl;
-                    return 1;
+                    b.net = std::move(net);
+                }
+                else
+                {
+                    b.net->Merge(std::move(net));
                 }
             }
-            else
-            {
-                std::cout << "error: could parse bus parameter" << std::endl;
-                return 1;
-            }
-            buses.insert(std::make_pair(b.name, std::move(b)));
         }
         // example line: vcan0  123   [3]  11 22 33
         std::regex regex_candump_line(
@@ -178,27 +183,21 @@ int main(int argc, char** argv)
                 {
                     data[i] = uint8_t(std::strtol(cm[4 + i].str().c_str(), nullptr, 16));
                 }
-                auto beg_msg = bus->second.net->Messages().begin();
-                auto end_msg = bus->second.net->Messages().end();
-                auto iter = std::find_if(beg_msg, end_msg, [&](const dbcppp::IMessage& msg) { return msg.Id() == msg_id; });
-                if (iter != end_msg)
+                const dbcppp::IMessage* msg = bus->second.net->MessageById(msg_id);
+                if (msg)
                 {
-                    const dbcppp::IMessage* msg = &*iter;
                     std::cout << line << " :: " << msg->Name() << "(";
                     bool first = true;
-                    const auto* mux_sig = msg->MuxSignal();
 
                     auto print_signal =
                         [&data](const dbcppp::ISignal& sig, bool first)
                         {
                             if (!first) std::cout << ", ";
                             auto raw = sig.Decode(&data[0]);
-                            auto beg_ved = sig.ValueEncodingDescriptions().begin();
-                            auto end_ved = sig.ValueEncodingDescriptions().end();
-                            auto iter = std::find_if(beg_ved, end_ved, [&](const dbcppp::IValueEncodingDescription& ved) { return ved.Value() == raw; });
-                            if (iter != end_ved)
+                            const auto* ved = sig.ValueEncodingDescriptionByValue(int64_t(raw));
+                            if (ved)
                             {
-                                std::cout << sig.Name() << ": '" << iter->Description() << "' " << sig.Unit();
+                                std::cout << sig.Name() << ": '" << ved->Description() << "' " << sig.Unit();
                             }
                             else
                             {
@@ -211,62 +210,12 @@ int main(int argc, char** argv)
                             }
                         };
 
-                    for (const dbcppp::ISignal& sig : msg->Signals())
+                    std::vector<std::size_t> active(msg->Signals_Size());
+                    std::size_t n_active = msg->ActiveSignals(&data[0], active);
+                    for (std::size_t i = 0; i < n_active; i++)
                     {
-                        if (sig.MultiplexerIndicator() != dbcppp::ISignal::EMultiplexer::MuxValue)
-                        {
-                            print_signal(sig, first);
-                            first = false;
-                        }
-                        else if (mux_sig && sig.SignalMultiplexerValues_Size() == 0 &&
-                            sig.MultiplexerSwitchValue() == mux_sig->Decode(&data[0]))
-                        {
-                            print_signal(sig, first);
-                            first = false;
-                        }
-                        else
-                        {
-                            std::function<bool(const dbcppp::ISignal&)> check_signal_multiplexer_values;
-                            check_signal_multiplexer_values =
-                                [&](const dbcppp::ISignal& sig)
-                                    -> bool
-                                {
-                                    for (const auto& smv : sig.SignalMultiplexerValues())
-                                    {
-                                        auto sig_beg = msg->Signals().begin();
-                                        auto sig_end = msg->Signals().end();
-                                        auto sig_iter = std::find_if(sig_beg, sig_end,
-                                            [&](const auto& sig)
-                                            {
-                                                return sig.Name() == smv.SwitchName();
-                                            });
-                                        if (sig_iter != sig_end)
-                                        {
-                                            for (auto ranges : smv.ValueRanges())
-                                            {
-                                                auto raw = sig_iter->Decode(&data[0]);
-                                                if (ranges.from >= raw && ranges.to <= raw)
-                                                {
-                                                    if (sig_iter->SignalMultiplexerValues_Size() != 0)
-                                                    {
-                                                        return check_signal_multiplexer_values(*sig_iter);
-                                                    }
-                                                    else
-                                                    {
-                                                        return true;
-                                                    }
-                                                }
-                                            }
-                                        }
-                                    }
-                                    return false;
-                                };
-                            if (check_signal_multiplexer_values(sig))
-                            {
-                                print_signal(sig, first);
-                                first = false;
-                            }
-                        }
+                        print_signal(msg->Signals_Get(active[i]), first);
+                        first = false;
                     }
                     std::cout << ")\n";
                 }
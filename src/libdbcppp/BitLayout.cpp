@@ -0,0 +1,58 @@
+#include <algorithm>
+#include "BitLayout.h"
+
+using namespace dbcppp;
+
+BitLayout::BitLayout(const IMessage& msg)
+    : _n_bits(msg.MessageSize() * 8)
+{
+    for (const ISignal& sig : msg.Signals())
+    {
+        _signals.push_back(&sig);
+        if (sig.MultiplexerIndicator() == ISignal::EMultiplexer::MuxValue)
+        {
+            _switch_values.push_back(sig.MultiplexerSwitchValue());
+        }
+    }
+    std::sort(_switch_values.begin(), _switch_values.end());
+    _switch_values.erase(std::unique(_switch_values.begin(), _switch_values.end()), _switch_values.end());
+    _owners.assign((_switch_values.size() + 1) * _n_bits, npos);
+    for (uint32_t i = 0; i < _signals.size(); i++)
+    {
+        const ISignal& sig = *_signals[i];
+        std::size_t row = 0;
+        if (sig.MultiplexerIndicator() == ISignal::EMultiplexer::MuxValue)
+        {
+            auto iter = std::lower_bound(_switch_values.begin(), _switch_values.end(), sig.MultiplexerSwitchValue());
+            row = 1 + (iter - _switch_values.begin());
+        }
+        uint32_t* owners = _owners.data() + row * _n_bits;
+        ForEachBit(sig,
+            [&](uint64_t bit)
+            {
+                // the signals are visited in order, so the first one keeps the bit
+                if (bit < _n_bits && owners[bit] == npos)
+                {
+                    owners[bit] = i;
+                }
+            });
+    }
+}
+const ISignal* BitLayout::Owner(std::size_t bit, std::optional<uint64_t> switch_value) const
+{
+    if (bit >= _n_bits)
+    {
+        return nullptr;
+    }
+    uint32_t owner = _owners[bit];
+    if (switch_value)
+    {
+        auto iter = std::lower_bound(_switch_values.begin(), _switch_values.end(), *switch_value);
+        if (iter != _switch_values.end() && *iter == *switch_value)
+        {
+            std::size_t row = 1 + (iter - _switch_values.begin());
+            owner = std::min(owner, _owners[row * _n_bits + bit]);
+        }
+    }
+    return owner != npos ? _signals[owner] : nullptr;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <optional>
+
+#include "../../include/dbcppp/Message.h"
+
+namespace dbcppp
+{
+    // Which signal occupies each bit of a message, built in a single pass over the signals. Bit i is bit i % 8 of
+    // byte i / 8. Multiplexed signals only occupy their bits for their switch value, overlapping signals share a
+    // bit which belongs to the first of them in the message then. Bits outside of the message are left out.
+    class BitLayout
+    {
+    public:
+        BitLayout(const IMessage& msg);
+
+        // the switch values of the multiplexed signals in ascending order
+        const std::vector<uint64_t>& SwitchValues() const noexcept
+        {
+            return _switch_values;
+        }
+        std::size_t Size() const noexcept
+        {
+            return _n_bits;
+        }
+        // the signal occupying the bit, without a switch value the multiplexed signals are left out
+        const ISignal* Owner(std::size_t bit, std::optional<uint64_t> switch_value = std::nullopt) const;
+
+        // calls f with the bits of the signal from its start bit on, big endian signals are walked through their
+        // bytes from the most to the least significant bit
+        template <class F>
+        static void ForEachBit(const ISignal& sig, F&& f)
+        {
+            uint64_t bit = sig.StartBit();
+            for (uint64_t n = 0; n < sig.BitSize(); n++)
+            {
+                f(bit);
+                if (sig.ByteOrder() == ISignal::EByteOrder::LittleEndian)
+                {
+                    bit++;
+                }
+                else
+                {
+                    bit = bit % 8 == 0 ? bit + 15 : bit - 1;
+                }
+            }
+        }
+
+    private:
+        static constexpr uint32_t npos = uint32_t(-1);
+
+        std::size_t _n_bits;
+        std::vector<const ISignal*> _signals;
+        std::vector<uint64_t> _switch_values;
+        // one row of _n_bits signal positions for the signals which aren't multiplexed followed by one row per
+        // switch value for the multiplexed ones
+        std::vector<uint32_t> _owners;
+    };
+}
@@ -551,6 +551,11 @@ extern "C"
         auto msgi = reinterpret_cast<const MessageImpl*>(msg);
         return msgi->Comment().c_str();
     }
+    DBCPPP_API const dbcppp_Signal* dbcppp_MessageSignalByName(const dbcppp_Message* msg, const char* name)
+    {
+        auto msgi = reinterpret_cast<const MessageImpl*>(msg);
+        return reinterpret_cast<const dbcppp_Signal*>(msgi->SignalByName(name));
+    }
 
     DBCPPP_API const dbcppp_Network* dbcppp_NetworkCreate(
           const char* version
@@ -688,6 +693,61 @@ extern "C"
         auto neti = reinterpret_cast<const NetworkImpl*>(net);
         return neti->Messages_Size();
     }
+    DBCPPP_API const dbcppp_Message* dbcppp_NetworkMessageById(const dbcppp_Network* net, uint64_t id)
+    {
+        auto neti = reinterpret_cast<const NetworkImpl*>(net);
+        return reinterpret_cast<const dbcppp_Message*>(neti->MessageById(id));
+    }
+    DBCPPP_API const dbcppp_Message* dbcppp_NetworkMessageByName(const dbcppp_Network* net, const char* name)
+    {
+        auto neti = reinterpret_cast<const NetworkImpl*>(net);
+        return reinterpret_cast<const dbcppp_Message*>(neti->MessageByName(name));
+    }
+    DBCPPP_API const dbcppp_Signal* dbcppp_NetworkFindSignal(const dbcppp_Network* net, const char* qualified_name)
+    {
+        auto neti = reinterpret_cast<const NetworkImpl*>(net);
+        return reinterpret_cast<const dbcppp_Signal*>(neti->FindSignal(qualified_name));
+    }
+    DBCPPP_API const dbcppp_Node* dbcppp_NetworkNodeByName(const dbcppp_Network* net, const char* name)
+    {
+        auto neti = reinterpret_cast<const NetworkImpl*>(net);
+        return reinterpret_cast<const dbcppp_Node*>(neti->NodeByName(name));
+    }
+    DBCPPP_API const dbcppp_ValueTable* dbcppp_NetworkValueTableByName(const dbcppp_Network* net, const char* name)
+    {
+        auto neti = reinterpret_cast<const NetworkImpl*>(net);
+        return reinterpret_cast<const dbcppp_ValueTable*>(neti->ValueTableByName(name));
+    }
+    DBCPPP_API const dbcppp_Message* dbcppp_NetworkParentMessage(const dbcppp_Network* net, const dbcppp_Signal* sig)
+    {
+        auto neti = reinterpret_cast<const NetworkImpl*>(net);
+        auto sigi = reinterpret_cast<const SignalImpl*>(sig);
+        return reinterpret_cast<const dbcppp_Message*>(neti->ParentMessage(sigi));
+    }
+    DBCPPP_API const dbcppp_Message* dbcppp_NetworkTransmittedMessages_Get(const dbcppp_Network* net, const dbcppp_Node* node, uint64_t i)
+    {
+        auto neti = reinterpret_cast<const NetworkImpl*>(net);
+        auto nodei = reinterpret_cast<const NodeImpl*>(node);
+        return reinterpret_cast<const dbcppp_Message*>(neti->TransmittedMessages(*nodei)[i]);
+    }
+    DBCPPP_API uint64_t dbcppp_NetworkTransmittedMessages_Size(const dbcppp_Network* net, const dbcppp_Node* node)
+    {
+        auto neti = reinterpret_cast<const NetworkImpl*>(net);
+        auto nodei = reinterpret_cast<const NodeImpl*>(node);
+        return neti->TransmittedMessages(*nodei).size();
+    }
+    DBCPPP_API const dbcppp_Signal* dbcppp_NetworkReceivedSignals_Get(const dbcppp_Network* net, const dbcppp_Node* node, uint64_t i)
+    {
+        auto neti = reinterpret_cast<const NetworkImpl*>(net);
+        auto nodei = reinterpret_cast<const NodeImpl*>(node);
+        return reinterpret_cast<const dbcppp_Signal*>(neti->ReceivedSignals(*nodei)[i]);
+    }
+    DBCPPP_API uint64_t dbcppp_NetworkReceivedSignals_Size(const dbcppp_Network* net, const dbcppp_Node* node)
+    {
+        auto neti = reinterpret_cast<const NetworkImpl*>(net);
+        auto nodei = reinterpret_cast<const NodeImpl*>(node);
+        return neti->ReceivedSignals(*nodei).size();
+    }
     DBCPPP_API const dbcppp_EnvironmentVariable* dbcppp_NetworkEnvironmentVariables_Get(const dbcppp_Network* net, uint64_t i)
     {
         auto neti = reinterpret_cast<const NetworkImpl*>(net);
@@ -977,6 +1037,16 @@ extern "C"
         auto sigi = reinterpret_cast<const SignalImpl*>(signal);
         return sigi->ValueEncodingDescriptions_Size();
     }
+    DBCPPP_API const dbcppp_ValueEncodingDescription* dbcppp_SignalValueEncodingDescriptionByValue(const dbcppp_Signal* signal, int64_t value)
+    {
+        auto sigi = reinterpret_cast<const SignalImpl*>(signal);
+        return reinterpret_cast<const dbcppp_ValueEncodingDescription*>(sigi->ValueEncodingDescriptionByValue(value));
+    }
+    DBCPPP_API const dbcppp_ValueEncodingDescription* dbcppp_SignalValueEncodingDescriptionByDescription(const dbcppp_Signal* signal, const char* description)
+    {
+        auto sigi = reinterpret_cast<const SignalImpl*>(signal);
+        return reinterpret_cast<const dbcppp_ValueEncodingDescription*>(sigi->ValueEncodingDescriptionByDescription(description));
+    }
     DBCPPP_API const dbcppp_Attribute* dbcppp_SignalAttributeValues_Get(const dbcppp_Signal* signal, uint64_t i)
     {
         auto sigi = reinterpret_cast<const SignalImpl*>(signal);
@@ -1174,6 +1244,16 @@ extern "C"
         auto vti = reinterpret_cast<const ValueTableImpl*>(value_table);
         return vti->ValueEncodingDescriptions_Size();
     }
+    DBCPPP_API const dbcppp_ValueEncodingDescription* dbcppp_ValueTableValueEncodingDescriptionByValue(const dbcppp_ValueTable* value_table, int64_t value)
+    {
+        auto vti = reinterpret_cast<const ValueTableImpl*>(value_table);
+        return reinterpret_cast<const dbcppp_ValueEncodingDescription*>(vti->ValueEncodingDescriptionByValue(value));
+    }
+    DBCPPP_API const dbcppp_ValueEncodingDescription* dbcppp_ValueTableValueEncodingDescriptionByDescription(const dbcppp_ValueTable* value_table, const char* description)
+    {
+        auto vti = reinterpret_cast<const ValueTableImpl*>(value_table);
+        return reinterpret_cast<const dbcppp_ValueEncodingDescription*>(vti->ValueEncodingDescriptionByDescription(description));
+    }
     DBCPPP_API const dbcppp_ValueEncodingDescription* dbcppp_ValueEncodingDescriptionCreate(uint64_t value, const char* desc)
     {
         auto ved = IValueEncodingDescription::Create(value, desc);
@@ -0,0 +1,246 @@
+#include <cassert>
+#include <stdexcept>
+#include "CompiledNetworkImpl.h"
+#include "MessageImpl.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    bool is_simple_mux_value(const ISignal& sig)
+    {
+        return sig.MultiplexerIndicator() == ISignal::EMultiplexer::MuxValue
+            && sig.SignalMultiplexerValues_Size() == 0;
+    }
+    // same case distinction as in the constructor of SignalImpl
+    bool spans_nine_bytes(const ISignal& sig)
+    {
+        uint64_t start_bit = sig.StartBit();
+        uint64_t bit_size = sig.BitSize();
+        uint64_t nbytes;
+        if (sig.ByteOrder() == ISignal::EByteOrder::LittleEndian)
+        {
+            nbytes = (start_bit % 8 + bit_size + 7) / 8;
+        }
+        else
+        {
+            nbytes = (bit_size + (7 - start_bit % 8) + 7) / 8;
+        }
+        uint64_t byte_pos = start_bit / 8;
+        return byte_pos + nbytes > 8 && byte_pos % 8 + nbytes > 8 && nbytes > 8;
+    }
+    CompiledNetwork::SignalDescriptor make_descriptor(const SignalImpl& sig, std::size_t index, bool mux_switch)
+    {
+        using SignalDescriptor = CompiledNetwork::SignalDescriptor;
+        SignalDescriptor desc;
+        desc.mask = sig._mask;
+        desc.factor = sig.Factor();
+        desc.offset = sig.Offset();
+        desc.byte_pos = uint16_t(sig.BytePos());
+        desc.fixed_start_bit_0 = uint8_t(sig._fixed_start_bit_0);
+        // the second start bit is only set for signals spanning nine bytes
+        desc.fixed_start_bit_1 = spans_nine_bytes(sig) ? uint8_t(sig._fixed_start_bit_1) : 0;
+        desc.bit_size = uint8_t(sig.BitSize());
+        desc.flags = 0;
+        desc.index = uint16_t(index);
+        if (sig.ByteOrder() == ISignal::EByteOrder::BigEndian)
+        {
+            desc.flags |= SignalDescriptor::BigEndian;
+        }
+        if (sig.ValueType() == ISignal::EValueType::Signed)
+        {
+            desc.flags |= SignalDescriptor::Signed;
+        }
+        switch (sig.ExtendedValueType())
+        {
+        case ISignal::EExtendedValueType::Integer: break;
+        case ISignal::EExtendedValueType::Float:  desc.flags |= SignalDescriptor::Float; break;
+        case ISignal::EExtendedValueType::Double: desc.flags |= SignalDescriptor::Double; break;
+        }
+        if (spans_nine_bytes(sig))
+        {
+            desc.flags |= SignalDescriptor::NineBytes;
+        }
+        if (mux_switch)
+        {
+            desc.flags |= SignalDescriptor::MuxSwitch;
+        }
+        return desc;
+    }
+}
+
+std::unique_ptr<CompiledNetwork> CompiledNetwork::Create(const INetwork& net)
+{
+    std::unique_ptr<CompiledNetwork> result{new CompiledNetwork()};
+    Cold& cold = *result->_cold;
+
+    std::vector<uint32_t> order(net.Messages_Size());
+    for (std::size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = uint32_t(i);
+    }
+    // for duplicated ids the first message wins the lookup
+    std::stable_sort(order.begin(), order.end(),
+        [&](uint32_t lhs, uint32_t rhs) { return net.Messages_Get(lhs).Id() < net.Messages_Get(rhs).Id(); });
+
+    cold.messages.reserve(order.size());
+    cold.message_names.reserve(order.size());
+    cold.extended.reserve(order.size());
+    for (uint32_t msg_index : order)
+    {
+        assert(dynamic_cast<const MessageImpl*>(&net.Messages_Get(msg_index)));
+        const MessageImpl& msgi = static_cast<const MessageImpl&>(net.Messages_Get(msg_index));
+        const auto& signals = msgi.signals();
+        if (signals.size() > std::numeric_limits<uint16_t>::max() + 1ull)
+        {
+            throw std::length_error("message \"" + msgi.Name() + "\" has too many signals to be compiled");
+        }
+        const ISignal* mux_signal = msgi.MuxSignal();
+
+        Message msg;
+        msg.id = msgi.Id();
+        msg.message_size = msgi.MessageSize();
+        msg.first_signal = uint32_t(cold.signals.size());
+        msg.first_group = uint32_t(cold.groups.size());
+        msg.index = msg_index;
+
+        std::vector<uint32_t> always;
+        std::vector<std::pair<uint64_t, uint32_t>> mux_values;
+        std::vector<uint32_t> extended;
+        for (std::size_t i = 0; i < signals.size(); i++)
+        {
+            const SignalImpl& sig = signals[i];
+            if (sig.SignalMultiplexerValues_Size() != 0)
+            {
+                extended.push_back(uint32_t(i));
+            }
+            else if (is_simple_mux_value(sig))
+            {
+                mux_values.emplace_back(sig.MultiplexerSwitchValue(), uint32_t(i));
+            }
+            else
+            {
+                always.push_back(uint32_t(i));
+            }
+        }
+        // the mux switch is decoded first, the rest is ordered by the position in the frame
+        auto by_position =
+            [&](uint32_t lhs, uint32_t rhs)
+            {
+                bool lhs_switch = &signals[lhs] == mux_signal;
+                bool rhs_switch = &signals[rhs] == mux_signal;
+                if (lhs_switch != rhs_switch)
+                {
+                    return lhs_switch;
+                }
+                return signals[lhs].BytePos() < signals[rhs].BytePos();
+            };
+        std::stable_sort(always.begin(), always.end(), by_position);
+        std::stable_sort(mux_values.begin(), mux_values.end(),
+            [&](const auto& lhs, const auto& rhs)
+            {
+                if (lhs.first != rhs.first)
+                {
+                    return lhs.first < rhs.first;
+                }
+                return signals[lhs.second].BytePos() < signals[rhs.second].BytePos();
+            });
+
+        std::vector<uint32_t> descriptors(signals.size());
+        auto add =
+            [&](uint32_t i)
+            {
+                const SignalImpl& sig = signals[i];
+                descriptors[i] = uint32_t(cold.signals.size() - msg.first_signal);
+                cold.signals.push_back(make_descriptor(sig, i, &sig == mux_signal));
+                cold.signal_names.push_back(cold.strings.emplace_back(sig.Name()));
+                cold.units.push_back(cold.strings.emplace_back(sig.Unit()));
+            };
+        for (uint32_t i : always)
+        {
+            add(i);
+        }
+        for (const auto& [switch_value, i] : mux_values)
+        {
+            if (cold.groups.size() == msg.first_group || cold.groups.back().switch_value != switch_value)
+            {
+                MuxGroup group;
+                group.switch_value = switch_value;
+                group.first_signal = uint32_t(cold.signals.size() - msg.first_signal);
+                group.n_signals = 0;
+                cold.groups.push_back(group);
+            }
+            cold.groups.back().n_signals++;
+            add(i);
+        }
+        for (uint32_t i : extended)
+        {
+            add(i);
+        }
+        msg.n_signals = uint32_t(signals.size());
+        msg.n_always = uint32_t(always.size());
+        msg.n_extended = uint32_t(extended.size());
+        msg.n_groups = uint32_t(cold.groups.size() - msg.first_group);
+
+        std::unique_ptr<Cold::ExtendedMux> extended_mux;
+        if (!extended.empty())
+        {
+            extended_mux = std::make_unique<Cold::ExtendedMux>();
+            extended_mux->graph = msgi.extended_mux_graph();
+            // the scratch space of the graph isn't shared with the message
+            extended_mux->graph.AllocateScratch();
+            extended_mux->descriptors = std::move(descriptors);
+        }
+        cold.messages.push_back(msg);
+        cold.message_names.push_back(cold.strings.emplace_back(msgi.Name()));
+        cold.extended.push_back(std::move(extended_mux));
+    }
+    result->_messages = cold.messages;
+    result->_signals = cold.signals;
+    result->_groups = cold.groups;
+    return result;
+}
+CompiledNetwork::CompiledNetwork()
+    : _cold(std::make_unique<Cold>())
+{}
+CompiledNetwork::~CompiledNetwork() = default;
+std::string_view CompiledNetwork::Name(const Message& msg) const noexcept
+{
+    return _cold->message_names[&msg - _messages.data()];
+}
+std::string_view CompiledNetwork::Name(const SignalDescriptor& sig) const noexcept
+{
+    return _cold->signal_names[&sig - _signals.data()];
+}
+std::string_view CompiledNetwork::Unit(const SignalDescriptor& sig) const noexcept
+{
+    return _cold->units[&sig - _signals.data()];
+}
+void CompiledNetwork::DecodeExtended(const Message& msg, const void* frame, std::span<raw_t> raw, std::span<double> phys) const noexcept
+{
+    const Cold::ExtendedMux& extended = *_cold->extended[&msg - _messages.data()];
+    const SignalDescriptor* sigs = _signals.data() + msg.first_signal;
+    extended.graph.Evaluate(
+        [&](uint32_t i) { return sigs[extended.descriptors[i]].Decode(frame); },
+        [&](const uint8_t* active)
+        {
+            const SignalDescriptor* ext = sigs + (msg.n_signals - msg.n_extended);
+            for (uint32_t i = 0; i < msg.n_extended; i++)
+            {
+                const SignalDescriptor& sig = ext[i];
+                if (active[i])
+                {
+                    raw_t r = sig.Decode(frame);
+                    raw[sig.index] = r;
+                    if (!phys.empty())
+                    {
+                        phys[sig.index] = sig.RawToPhys(r);
+                    }
+                }
+                else if (!phys.empty())
+                {
+                    phys[sig.index] = std::numeric_limits<double>::quiet_NaN();
+                }
+            }
+        });
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "../../include/dbcppp/CompiledNetwork.h"
+#include "ExtendedMuxGraph.h"
+#include "MappedFile.h"
+
+namespace dbcppp
+{
+    struct CompiledNetwork::Cold
+    {
+        struct ExtendedMux
+        {
+            ExtendedMuxGraph graph;
+            // position of the descriptor of the i-th signal of the source message relative to first_signal
+            std::vector<uint32_t> descriptors;
+        };
+
+        // storage of a network compiled by Create, unused if the network is loaded from a snapshot
+        std::vector<Message> messages;
+        std::vector<SignalDescriptor> signals;
+        std::vector<MuxGroup> groups;
+        std::deque<std::string> strings;
+        // keeps the snapshot alive which the spans and names point into
+        std::shared_ptr<const MappedFile> snapshot;
+
+        std::vector<std::string_view> message_names;
+        // indexed like CompiledNetwork::_signals
+        std::vector<std::string_view> signal_names;
+        std::vector<std::string_view> units;
+        // indexed like CompiledNetwork::_messages, only set for messages with extended multiplexing
+        std::vector<std::unique_ptr<ExtendedMux>> extended;
+    };
+}
@@ -3,8 +3,13 @@
 #include <fstream>
 #include <variant>
 #include <sstream>
-#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <string_view>
+#include <type_traits>
 #include <span>
+#include <algorithm>
+#include <cstring>
 
 #include <boost/variant.hpp>
 
@@ -12,18 +17,38 @@
 #include "../../include/dbcppp/CApi.h"
 
 #include "DBCX3.h"
+#include "MappedFile.h"
+#include "NetworkImpl.h"
+#include "LazyMetadata.h"
 
 using namespace dbcppp;
 using namespace dbcppp::DBCX3::AST;
 
 
+// hashes the keys of the NetIndex, strings are viewed in place in the AST
+struct NetIndexHash
+{
+    std::size_t operator()(uint64_t id) const noexcept
+    {
+        // message ids mostly differ in the low bits only
+        return std::size_t(id * 0x9E3779B97F4A7C15ull);
+    }
+    std::size_t operator()(std::string_view name) const noexcept
+    {
+        return std::hash<std::string_view>()(name);
+    }
+    std::size_t operator()(const std::pair<uint64_t, std::string_view>& key) const noexcept
+    {
+        return (*this)(key.second) ^ (*this)(key.first);
+    }
+};
 struct NetIndex
 {
-    explicit NetIndex(const G_Network& gnet)
+    explicit NetIndex(G_Network& gnet)
     {
         for (size_t i = 0; i < gnet.attribute_values.size(); ++i)
         {
-            const auto& c = gnet.attribute_values[i];
+            auto& c = gnet.attribute_values[i];
             if (auto p = boost::get<G_AttributeNode>(&c))
                 attribute_nodes[p->node_name].emplace_back(p);
             else if (auto p = boost::get<G_AttributeSignal>(&c))
@@ -36,7 +61,7 @@ struct NetIndex
 
         for (size_t i = 0; i < gnet.value_descriptions_sig_env_var.size(); ++i)
         {
-            const auto& c = gnet.value_descriptions_sig_env_var[i];
+            auto& c = gnet.value_descriptions_sig_env_var[i];
             if (auto p = boost::get<G_ValueDescriptionSignal>(&c.description))
                 value_description_signals[ValueDescriptionSignalKey{ p->message_id, p->signal_name }] = p;
             else if (auto p = boost::get<G_ValueDescriptionEnvVar>(&c.description))
@@ -45,7 +70,7 @@ struct NetIndex
 
         for (size_t i = 0; i < gnet.comments.size(); ++i)
         {
-            const auto& c = gnet.comments[i];
+            auto& c = gnet.comments[i];
             if (auto p = boost::get<G_CommentSignal>(&c.comment))
                 comment_signals[CommentSignalKey{ p->message_id, p->signal_name }] = p;
             else if (auto p = boost::get<G_CommentNode>(&c.comment))
@@ -56,85 +81,101 @@ struct NetIndex
                 comment_env_vars[p->env_var_name] = p;
         }
 
+        signal_extended_value_types.reserve(gnet.signal_extended_value_types.size());
         for (size_t i = 0; i < gnet.signal_extended_value_types.size(); ++i)
         {
-            const auto& c = gnet.signal_extended_value_types[i];
+            auto& c = gnet.signal_extended_value_types[i];
             signal_extended_value_types[SignalExtendedValueTypeKey{ c.message_id, c.signal_name }] = &c;
         }
 
         for (size_t i = 0; i < gnet.signal_multiplexer_values.size(); ++i)
         {
-            const auto& c = gnet.signal_multiplexer_values[i];
+            auto& c = gnet.signal_multiplexer_values[i];
             signal_multiplexer_values[SignalMultiplexerValueKey{ c.message_id, c.signal_name }].emplace_back(&c);
         }
 
+        message_transmitters.reserve(gnet.message_transmitters.size());
         for (size_t i = 0; i < gnet.message_transmitters.size(); ++i)
         {
-            const auto& c = gnet.message_transmitters[i];
+            auto& c = gnet.message_transmitters[i];
             message_transmitters[c.id] = &c;
         }
 
         for (size_t i = 0; i < gnet.signal_groups.size(); ++i)
         {
-            const auto& c = gnet.signal_groups[i];
+            auto& c = gnet.signal_groups[i];
             signal_groups[c.message_id].emplace_back(&c);
         }
+
+        signal_types.reserve(gnet.signal_types.size());
+        for (size_t i = 0; i < gnet.signal_types.size(); ++i)
+        {
+            // the first signal type of a value table wins
+            auto& c = gnet.signal_types[i];
+            signal_types.emplace(c.value_table_name, &c);
+        }
     }
 
-    using AttributeNodeKey = std::string;
-    std::map<AttributeNodeKey, std::vector<const G_AttributeNode*>> attribute_nodes;
+    template <class K, class V>
+    using Map = std::unordered_map<K, V, NetIndexHash>;
+
+    using AttributeNodeKey = std::string_view;
+    Map<AttributeNodeKey, std::vector<G_AttributeNode*>> attribute_nodes;
 
-    using AttributeSignalKey = std::pair<uint64_t, std::string>;
-    std::map<AttributeSignalKey, std::vector<const G_AttributeSignal*>> attribute_signals;
+    using AttributeSignalKey = std::pair<uint64_t, std::string_view>;
+    Map<AttributeSignalKey, std::vector<G_AttributeSignal*>> attribute_signals;
 
-    using ValueDescriptionSignalKey = std::pair<uint64_t, std::string>;
-    std::map<ValueDescriptionSignalKey, const G_ValueDescriptionSignal*> value_description_signals;
+    using ValueDescriptionSignalKey = std::pair<uint64_t, std::string_view>;
+    Map<ValueDescriptionSignalKey, G_ValueDescriptionSignal*> value_description_signals;
 
-    using CommentSignalKey = std::pair<uint64_t, std::string>;
-    std::map<CommentSignalKey, const G_CommentSignal*> comment_signals;
+    using CommentSignalKey = std::pair<uint64_t, std::string_view>;
+    Map<CommentSignalKey, G_CommentSignal*> comment_signals;
 
-    using CommentNodeKey = std::string;
-    std::map<CommentNodeKey, const G_CommentNode*> comment_nodes;
+    using CommentNodeKey = std::string_view;
+    Map<CommentNodeKey, G_CommentNode*> comment_nodes;
 
-    using SignalExtendedValueTypeKey = std::pair<uint64_t, std::string>;
-    std::map<SignalExtendedValueTypeKey, const G_SignalExtendedValueType*> signal_extended_value_types;
+    using SignalExtendedValueTypeKey = std::pair<uint64_t, std::string_view>;
+    Map<SignalExtendedValueTypeKey, G_SignalExtendedValueType*> signal_extended_value_types;
 
-    using SignalMultiplexerValueKey = std::pair<uint64_t, std::string>;
-    std::map<SignalMultiplexerValueKey, std::vector<const G_SignalMultiplexerValue*>> signal_multiplexer_values;
+    using SignalMultiplexerValueKey = std::pair<uint64_t, std::string_view>;
+    Map<SignalMultiplexerValueKey, std::vector<G_SignalMultiplexerValue*>> signal_multiplexer_values;
 
     using MessageTransmitterKey = uint64_t;
-    std::map<MessageTransmitterKey, const G_MessageTransmitter*> message_transmitters;
+    Map<MessageTransmitterKey, G_MessageTransmitter*> message_transmitters;
 
     using AttributeMessageKey = uint64_t;
-    std::map<AttributeMessageKey, std::vector<const G_AttributeMessage*>> attribute_messages;
+    Map<AttributeMessageKey, std::vector<G_AttributeMessage*>> attribute_messages;
 
     using CommentMessageKey = uint64_t;
-    std::map<CommentMessageKey, const G_CommentMessage*> comment_messages;
+    Map<CommentMessageKey, G_CommentMessage*> comment_messages;
 
     using SignalGroupKey = uint64_t;
-    std::map<SignalGroupKey, std::vector<const G_SignalGroup*>> signal_groups;
+    Map<SignalGroupKey, std::vector<G_SignalGroup*>> signal_groups;
 
-    using ValueDescriptionEnvVarKey = std::string;
-    std::map<ValueDescriptionEnvVarKey, const G_ValueDescriptionEnvVar*> value_description_env_vars;
+    using ValueDescriptionEnvVarKey = std::string_view;
+    Map<ValueDescriptionEnvVarKey, G_ValueDescriptionEnvVar*> value_description_env_vars;
 
-    using AttributeEnvVarKey = std::string;
-    std::map<AttributeEnvVarKey, std::vector<const G_AttributeEnvVar*>> attribute_env_vars;
+    using AttributeEnvVarKey = std::string_view;
+    Map<AttributeEnvVarKey, std::vector<G_AttributeEnvVar*>> attribute_env_vars;
 
-    using CommentEnvVarKey = std::string;
-    std::map<CommentEnvVarKey, const G_CommentEnvVar*> comment_env_vars;
+    using CommentEnvVarKey = std::string_view;
+    Map<CommentEnvVarKey, G_CommentEnvVar*> comment_env_vars;
+
+    using SignalTypeKey = std::string_view;
+    Map<SignalTypeKey, G_SignalType*> signal_types;
 };
 
 template<typename K, typename T>
-std::span<T const* const> ni_find(const std::map<K, std::vector<const T*>>& m, const K& key)
+std::span<T* const> ni_find(const NetIndex::Map<K, std::vector<T*>>& m, const std::type_identity_t<K>& key)
 {
     auto it = m.find(key);
     if (it == m.end())
         return {};
-    return std::span<T const* const>(it->second.data(), it->second.size());
+    return std::span<T* const>(it->second.data(), it->second.size());
 }
 
 template<typename K, typename T>
-const T* ni_find(const std::map<K, const T*>& m, const K& key)
+T* ni_find(const NetIndex::Map<K, T*>& m, const std::type_identity_t<K>& key)
 {
     auto it = m.find(key);
     if (it == m.end())
@@ -142,30 +183,45 @@ const T* ni_find(const std::map<K, const T*>& m, const K& key)
     return it->second;
 }
 
-static auto getVersion(const G_Network& gnet)
+// counts the owners of each key, comments and attributes of keys which are shared by more than one owner
+// are copied to each of them instead of being moved out of the AST
+template<typename K, typename Range, typename Proj>
+NetIndex::Map<K, std::size_t> count_keys(const Range& range, Proj proj)
 {
-    return gnet.version.version;
+    NetIndex::Map<K, std::size_t> counts;
+    counts.reserve(range.size());
+    for (const auto& x : range)
+        counts[proj(x)]++;
+    return counts;
 }
-static auto getNewSymbols(const G_Network& gnet)
+
+template<typename T>
+T take(T& value, bool consume)
 {
-    std::vector<std::string> nodes;
-    for (const auto& ns : gnet.new_symbols)
-    {
-        nodes.push_back(ns);
-    }
-    return nodes;
+    return consume ? std::move(value) : value;
 }
-static auto getSignalType(const G_Network& gnet, const G_ValueTable& vt)
+
+// frees the memory of an AST section or an index after it has been folded into the network
+template<typename T>
+void release(T& value)
+{
+    T().swap(value);
+}
+
+static auto getVersion(G_Network& gnet)
+{
+    return std::move(gnet.version.version);
+}
+static auto getNewSymbols(G_Network& gnet)
+{
+    return std::move(gnet.new_symbols);
+}
+static auto getSignalType(const G_ValueTable& vt, const NetIndex& ni)
 {
     std::optional<std::unique_ptr<ISignalType>> signal_type;
-    auto iter = std::find_if(gnet.signal_types.begin(), gnet.signal_types.end(),
-        [&](const auto& st)
-        {
-            return st.value_table_name == vt.name;
-        });
-    if (iter != gnet.signal_types.end())
+    if (auto p = ni_find(ni.signal_types, vt.name))
     {
-        auto& st = *iter;
+        auto& st = *p;
         signal_type = ISignalType::Create(
               std::string(st.name)
             , st.size
@@ -181,20 +237,21 @@ static auto getSignalType(const G_Network& gnet, const G_ValueTable& vt)
     }
     return signal_type;
 }
-static auto getValueTables(const G_Network& gnet)
+static auto getValueTables(G_Network& gnet, const NetIndex& ni)
 {
     std::vector<std::unique_ptr<IValueTable>> value_tables;
-    for (const auto& vt : gnet.value_tables)
+    value_tables.reserve(gnet.value_tables.size());
+    for (auto& vt : gnet.value_tables)
     {
-        auto sig_type = getSignalType(gnet, vt);
+        auto sig_type = getSignalType(vt, ni);
         std::vector<std::unique_ptr<IValueEncodingDescription>> copy_ved;
-        for (const auto& ved : vt.value_encoding_descriptions)
+        copy_ved.reserve(vt.value_encoding_descriptions.size());
+        for (auto& ved : vt.value_encoding_descriptions)
         {
-            auto desc = ved.description;
-            auto pved = IValueEncodingDescription::Create(ved.value, std::move(desc));
+            auto pved = IValueEncodingDescription::Create(ved.value, std::move(ved.description));
             copy_ved.push_back(std::move(pved));
         }
-        auto nvt = IValueTable::Create(std::string(vt.name), std::move(sig_type), std::move(copy_ved));
+        auto nvt = IValueTable::Create(std::move(vt.name), std::move(sig_type), std::move(copy_ved));
         value_tables.push_back(std::move(nvt));
     }
     return value_tables;
@@ -243,70 +300,72 @@ auto boost_variant_to_std_variant(const boost::variant<Args...>& old)
 }
 #endif
 
-static auto getAttributeValues(std::span<G_AttributeNode const* const> pp)
+static auto getAttributeValues(std::span<G_AttributeNode* const> pp, bool consume)
 {
     std::vector<std::unique_ptr<IAttribute>> attribute_values;
     attribute_values.reserve(pp.size());
-    for (const G_AttributeNode* p : pp)
+    for (G_AttributeNode* p : pp)
     {
-        auto attribute = IAttribute::Create(std::string(p->attribute_name), IAttributeDefinition::EObjectType::Node, p->value);
+        auto attribute = IAttribute::Create(take(p->attribute_name, consume), IAttributeDefinition::EObjectType::Node, take(p->value, consume));
         attribute_values.push_back(std::move(attribute));
     }
     return attribute_values;
 }
-static auto getComment(const G_CommentNode* p)
+static auto getComment(G_CommentNode* p, bool consume)
 {
     std::string comment;
     if (p)
     {
-        comment = p->comment;
+        comment = take(p->comment, consume);
     }
     return comment;
 }
-static auto getNodes(const G_Network& gnet, const NetIndex& ni)
+static auto getNodes(G_Network& gnet, const NetIndex& ni)
 {
     std::vector<std::unique_ptr<INode>> nodes;
-    for (const auto& n : gnet.nodes)
+    nodes.reserve(gnet.nodes.size());
+    auto names = count_keys<std::string_view>(gnet.nodes, [](const G_Node& n) -> std::string_view { return n.name; });
+    for (auto& n : gnet.nodes)
     {
-        auto comment = getComment(ni_find(ni.comment_nodes, n.name));
-        auto attribute_values = getAttributeValues(ni_find(ni.attribute_nodes, n.name));
-        auto nn = INode::Create(std::string(n.name), std::move(comment), std::move(attribute_values));
+        bool consume = names[n.name] == 1;
+        auto comment = getComment(ni_find(ni.comment_nodes, n.name), consume);
+        auto attribute_values = getAttributeValues(ni_find(ni.attribute_nodes, n.name), consume);
+        auto nn = INode::Create(std::move(n.name), std::move(comment), std::move(attribute_values));
         nodes.push_back(std::move(nn));
     }
     return nodes;
 }
-static auto getAttributeValues(std::span<G_AttributeSignal const* const> pp)
+static auto getAttributeValues(std::span<G_AttributeSignal* const> pp, bool consume)
 {
     std::vector<std::unique_ptr<IAttribute>> attribute_values;
     attribute_values.reserve(pp.size());
-    for (const G_AttributeSignal* p : pp)
+    for (G_AttributeSignal* p : pp)
     {
-        auto attribute = IAttribute::Create(std::string(p->attribute_name), IAttributeDefinition::EObjectType::Signal, p->value);
+        auto attribute = IAttribute::Create(take(p->attribute_name, consume), IAttributeDefinition::EObjectType::Signal, take(p->value, consume));
         attribute_values.push_back(std::move(attribute));
     }
     return attribute_values;
 }
-static auto getValueDescriptions(const G_ValueDescriptionSignal* p)
+static auto getValueDescriptions(G_ValueDescriptionSignal* p, bool consume)
 {
     std::vector<std::unique_ptr<IValueEncodingDescription>> value_descriptions;
     if(p)
 	{
         value_descriptions.reserve(p->value_descriptions.size());
-        for (const auto& vd : p->value_descriptions)
+        for (auto& vd : p->value_descriptions)
         {
-            auto desc = vd.description;
-            auto pvd = IValueEncodingDescription::Create(vd.value, std::move(desc));
+            auto pvd = IValueEncodingDescription::Create(vd.value, take(vd.description, consume));
             value_descriptions.push_back(std::move(pvd));
         }
     }
     return value_descriptions;
 }
-static auto getComment(const G_CommentSignal* p)
+static auto getComment(G_CommentSignal* p, bool consume)
 {
     std::string comment;
     if (p)
     {
-        comment = p->comment;
+        comment = take(p->comment, consume);
     }
     return comment;
 }
@@ -323,14 +382,15 @@ static auto getSignalExtendedValueType(const G_SignalExtendedValueType* p)
     }
     return extended_value_type;
 }
-static auto getSignalMultiplexerValues(std::span<G_SignalMultiplexerValue const* const> pp)
+static auto getSignalMultiplexerValues(std::span<G_SignalMultiplexerValue* const> pp, bool consume)
 {
     std::vector<std::unique_ptr<ISignalMultiplexerValue>> signal_multiplexer_values;
     signal_multiplexer_values.reserve(pp.size());
-    for (const G_SignalMultiplexerValue* p : pp)
+    for (G_SignalMultiplexerValue* p : pp)
     {
-        auto switch_name = p->switch_name;
+        auto switch_name = take(p->switch_name, consume);
         std::vector<ISignalMultiplexerValue::Range> value_ranges;
+        value_ranges.reserve(p->value_ranges.size());
         for (const auto& r : p->value_ranges)
         {
             value_ranges.push_back({ r.from, r.to });
@@ -343,18 +403,30 @@ static auto getSignalMultiplexerValues(std::span<G_SignalMultiplexerValue const*
     return signal_multiplexer_values;
 }
 
-static auto getSignals(const G_Network& gnet, const G_Message& m, const NetIndex& ni)
+static bool hasUniqueSignalNames(const G_Message& m)
 {
-    std::vector<std::unique_ptr<ISignal>> signals;
+    std::vector<std::string_view> names;
+    names.reserve(m.signals.size());
     for (const G_Signal& s : m.signals)
     {
-        std::vector<std::string> receivers;
-        auto attribute_values = getAttributeValues(ni_find(ni.attribute_signals, { m.id, s.name }));
-        auto value_descriptions = getValueDescriptions(ni_find(ni.value_description_signals, { m.id, s.name }));
+        names.push_back(s.name);
+    }
+    std::sort(names.begin(), names.end());
+    return std::adjacent_find(names.begin(), names.end()) == names.end();
+}
+static auto getSignals(G_Message& m, const NetIndex& ni, bool consume)
+{
+    std::vector<std::unique_ptr<ISignal>> signals;
+    signals.reserve(m.signals.size());
+    consume = consume && hasUniqueSignalNames(m);
+    for (G_Signal& s : m.signals)
+    {
+        auto attribute_values = getAttributeValues(ni_find(ni.attribute_signals, { m.id, s.name }), consume);
+        auto value_descriptions = getValueDescriptions(ni_find(ni.value_description_signals, { m.id, s.name }), consume);
         auto extended_value_type = getSignalExtendedValueType(ni_find(ni.signal_extended_value_types, { m.id, s.name }));
         auto multiplexer_indicator = ISignal::EMultiplexer::NoMux;
-        auto comment = getComment(ni_find(ni.comment_signals, { m.id, s.name }));
-        auto signal_multiplexer_values = getSignalMultiplexerValues(ni_find(ni.signal_multiplexer_values, { m.id, s.name }));
+        auto comment = getComment(ni_find(ni.comment_signals, { m.id, s.name }), consume);
+        auto signal_multiplexer_values = getSignalMultiplexerValues(ni_find(ni.signal_multiplexer_values, { m.id, s.name }), consume);
         uint64_t multiplexer_switch_value = 0;
         if (s.multiplexer_indicator)
         {
@@ -370,14 +442,10 @@ static auto getSignals(const G_Network& gnet, const G_Message& m, const NetIndex
                 multiplexer_switch_value = std::atoi(value.c_str());
             }
         }
-        for (const auto& n : s.receivers)
-        {
-            receivers.push_back(n);
-        }
 
         auto ns = ISignal::Create(
               m.size
-            , std::string(s.name)
+            , std::move(s.name)
             , multiplexer_indicator
             , multiplexer_switch_value
             , s.start_bit
@@ -388,8 +456,8 @@ static auto getSignals(const G_Network& gnet, const G_Message& m, const NetIndex
             , s.offset
             , s.minimum
             , s.maximum
-            , std::string(s.unit)
-            , std::move(receivers)
+            , std::move(s.unit)
+            , std::move(s.receivers)
             , std::move(attribute_values)
             , std::move(value_descriptions)
             , std::move(comment)
@@ -397,69 +465,65 @@ static auto getSignals(const G_Network& gnet, const G_Message& m, const NetIndex
             , std::move(signal_multiplexer_values));
         if (ns->Error(ISignal::EErrorCode::SignalExceedsMessageSize))
         {
-            std::cout << "Warning: The signals '" << m.name << "::" << s.name << "'"
+            std::cout << "Warning: The signals '" << m.name << "::" << ns->Name() << "'"
                 << " start_bit + bit_size exceeds the byte size of the message! Ignoring this error will lead to garbage data when using the decode function of this signal." << std::endl;
         }
         if (ns->Error(ISignal::EErrorCode::WrongBitSizeForExtendedDataType))
         {
-            std::cout << "Warning: The signals '" << m.name << "::" << s.name << "'"
+            std::cout << "Warning: The signals '" << m.name << "::" << ns->Name() << "'"
                 << " bit_size does not fit the bit size of the specified ExtendedValueType." << std::endl;
         }
         if (ns->Error(ISignal::EErrorCode::MaschinesFloatEncodingNotSupported))
         {
-            std::cout << "Warning: Signal '" << m.name << "::" << s.name << "'"
+            std::cout << "Warning: Signal '" << m.name << "::" << ns->Name() << "'"
                 << " This warning appears when a signal uses type float but the system this programm is running on does not uses IEEE 754 encoding for floats." << std::endl;
         }
         if (ns->Error(ISignal::EErrorCode::MaschinesDoubleEncodingNotSupported))
         {
-            std::cout << "Warning: Signal '" << m.name << "::" << s.name << "'"
+            std::cout << "Warning: Signal '" << m.name << "::" << ns->Name() << "'"
                 << " This warning appears when a signal uses type double but the system this programm is running on does not uses IEEE 754 encoding for doubles." << std::endl;
         }
         signals.push_back(std::move(ns));
     }
     return signals;
 }
-static auto getMessageTransmitters(const G_MessageTransmitter* p)
+static auto getMessageTransmitters(G_MessageTransmitter* p, bool consume)
 {
     std::vector<std::string> message_transmitters;
     if (p)
     {
-        message_transmitters.reserve(p->transmitters.size());
-        for (const auto& t : p->transmitters)
-        {
-            message_transmitters.push_back(t);
-        }
+        message_transmitters = take(p->transmitters, consume);
     }
     return message_transmitters;
 }
-static auto getAttributeValues(std::span<G_AttributeMessage const* const> pp)
+static auto getAttributeValues(std::span<G_AttributeMessage* const> pp, bool consume)
 {
     std::vector<std::unique_ptr<IAttribute>> attribute_values;
     attribute_values.reserve(pp.size());
-    for (const G_AttributeMessage* p : pp)
+    for (G_AttributeMessage* p : pp)
     {
-        auto attribute = IAttribute::Create(std::string(p->attribute_name), IAttributeDefinition::EObjectType::Message, p->value);
+        auto attribute = IAttribute::Create(take(p->attribute_name, consume), IAttributeDefinition::EObjectType::Message, take(p->value, consume));
         attribute_values.push_back(std::move(attribute));
     }
     return attribute_values;
 }
-static auto getComment(const G_CommentMessage* p)
+static auto getComment(G_CommentMessage* p, bool consume)
 {
     std::string comment;
     if (p)
     {
-        comment = p->comment;
+        comment = take(p->comment, consume);
     }
     return comment;
 }
-static auto getSignalGroups(std::span<G_SignalGroup const* const> pp)
+static auto getSignalGroups(std::span<G_SignalGroup* const> pp, bool consume)
 {
     std::vector<std::unique_ptr<ISignalGroup>> signal_groups;
     signal_groups.reserve(pp.size());
-    for (const G_SignalGroup* p : pp)
+    for (G_SignalGroup* p : pp)
     {
-        auto name = p->signal_group_name;
-        auto signal_names = p->signal_names;
+        auto name = take(p->signal_group_name, consume);
+        auto signal_names = take(p->signal_names, consume);
         auto signal_group = ISignalGroup::Create(
             p->message_id
             , std::move(name)
@@ -469,21 +533,25 @@ static auto getSignalGroups(std::span<G_SignalGroup const* const> pp)
     }
     return signal_groups;
 }
-static auto getMessages(const G_Network& gnet, const NetIndex& ni)
+static auto getMessages(G_Network& gnet, const NetIndex& ni)
 {
     std::vector<std::unique_ptr<IMessage>> messages;
-    for (const auto& m : gnet.messages)
+    messages.reserve(gnet.messages.size());
+    auto ids = count_keys<uint64_t>(gnet.messages, [](const G_Message& m) { return m.id; });
+    for (auto& m : gnet.messages)
     {
-        auto message_transmitters = getMessageTransmitters(ni_find(ni.message_transmitters, m.id));
-        auto signals = getSignals(gnet, m, ni);
-        auto attribute_values = getAttributeValues(ni_find(ni.attribute_messages, m.id));
-        auto comment = getComment(ni_find(ni.comment_messages, m.id));
-        auto signal_groups = getSignalGroups(ni_find(ni.signal_groups, m.id));
+        bool consume = ids[m.id] == 1;
+        auto message_transmitters = getMessageTransmitters(ni_find(ni.message_transmitters, m.id), consume);
+        auto signals = getSignals(m, ni, consume);
+        auto attribute_values = getAttributeValues(ni_find(ni.attribute_messages, m.id), consume);
+        auto comment = getComment(ni_find(ni.comment_messages, m.id), consume);
+        auto signal_groups = getSignalGroups(ni_find(ni.signal_groups, m.id), consume);
+        release(m.signals);
         auto msg = IMessage::Create(
               m.id
-            , std::string(m.name)
+            , std::move(m.name)
             , m.size
-            , std::string(m.transmitter)
+            , std::move(m.transmitter)
             , std::move(message_transmitters)
             , std::move(signals)
             , std::move(attribute_values)
@@ -497,52 +565,55 @@ static auto getMessages(const G_Network& gnet, const NetIndex& ni)
     }
     return messages;
 }
-static auto getValueDescriptions(const G_ValueDescriptionEnvVar* p)
+static auto getValueDescriptions(G_ValueDescriptionEnvVar* p, bool consume)
 {
     std::vector<std::unique_ptr<IValueEncodingDescription>> value_descriptions;
     if (p)
     {
         value_descriptions.reserve(p->value_descriptions.size());
-        for (const auto& vd : p->value_descriptions)
+        for (auto& vd : p->value_descriptions)
         {
-            auto desc = vd.description;
-            auto pvd = IValueEncodingDescription::Create(vd.value, std::move(desc));
+            auto pvd = IValueEncodingDescription::Create(vd.value, take(vd.description, consume));
             value_descriptions.push_back(std::move(pvd));
         }
     }
     return value_descriptions;
 }
-static auto getAttributeValues(std::span<G_AttributeEnvVar const* const> pp)
+static auto getAttributeValues(std::span<G_AttributeEnvVar* const> pp, bool consume)
 {
     std::vector<std::unique_ptr<IAttribute>> attribute_values;
     attribute_values.reserve(pp.size());
-    for (const G_AttributeEnvVar* p : pp)
+    for (G_AttributeEnvVar* p : pp)
     {
-        auto attribute = IAttribute::Create(std::string(p->attribute_name), IAttributeDefinition::EObjectType::EnvironmentVariable, p->value);
+        auto attribute = IAttribute::Create(take(p->attribute_name, consume), IAttributeDefinition::EObjectType::EnvironmentVariable, take(p->value, consume));
         attribute_values.push_back(std::move(attribute));
     }
     return attribute_values;
 }
-static auto getComment(const G_CommentEnvVar* p)
+static auto getComment(G_CommentEnvVar* p, bool consume)
 {
     std::string comment;
     if (p)
     {
-        comment = p->comment;
+        comment = take(p->comment, consume);
     }
     return comment;
 }
-static auto getEnvironmentVariables(const G_Network& gnet, const NetIndex& ni)
+static auto getEnvironmentVariables(G_Network& gnet, const NetIndex& ni)
 {
     std::vector<std::unique_ptr<IEnvironmentVariable>> environment_variables;
-    for (const auto& ev : gnet.environment_variables)
+    environment_variables.reserve(gnet.environment_variables.size());
+    auto names = count_keys<std::string_view>(gnet.environment_variables,
+        [](const G_EnvironmentVariable& ev) -> std::string_view { return ev.name; });
+    for (auto& ev : gnet.environment_variables)
     {
         IEnvironmentVariable::EVarType var_type;
         IEnvironmentVariable::EAccessType access_type;
-        std::vector<std::string> access_nodes = ev.access_nodes;
-        auto value_descriptions = getValueDescriptions(ni_find(ni.value_description_env_vars, ev.name));
-        auto attribute_values = getAttributeValues(ni_find(ni.attribute_env_vars, ev.name));
-        auto comment = getComment(ni_find(ni.comment_env_vars, ev.name));
+        bool consume = names[ev.name] == 1;
+        std::vector<std::string> access_nodes = std::move(ev.access_nodes);
+        auto value_descriptions = getValueDescriptions(ni_find(ni.value_description_env_vars, ev.name), consume);
+        auto attribute_values = getAttributeValues(ni_find(ni.attribute_env_vars, ev.name), consume);
+        auto comment = getComment(ni_find(ni.comment_env_vars, ev.name), consume);
         uint64_t data_size = 0;
         switch (ev.var_type)
         {
@@ -569,11 +640,11 @@ static auto getEnvironmentVariables(const G_Network& gnet, const NetIndex& ni)
             }
         }
         auto env_var = IEnvironmentVariable::Create(
-              std::string(ev.name)
+              std::move(ev.name)
             , var_type
             , ev.minimum
             , ev.maximum
-            , std::string(ev.unit)
+            , std::move(ev.unit)
             , ev.initial_value
             , ev.id
             , access_type
@@ -586,7 +657,7 @@ static auto getEnvironmentVariables(const G_Network& gnet, const NetIndex& ni)
     }
     return environment_variables;
 }
-static auto getAttributeDefinitions(const G_Network& gnet)
+static auto getAttributeDefinitions(G_Network& gnet)
 {
     std::vector<std::unique_ptr<IAttributeDefinition>> attribute_definitions;
     struct VisitorValueType
@@ -616,20 +687,18 @@ static auto getAttributeDefinitions(const G_Network& gnet)
         {
             return IAttributeDefinition::ValueTypeString();
         }
-        IAttributeDefinition::value_type_t operator()(const G_AttributeValueTypeEnum& cn)
+        IAttributeDefinition::value_type_t operator()(G_AttributeValueTypeEnum& cn)
         {
             IAttributeDefinition::ValueTypeEnum vt;
-            for (auto& e : cn.values)
-            {
-                vt.values.emplace_back(e);
-            }
+            vt.values = std::move(cn.values);
             return vt;
         }
     };
-    for (const auto& ad : gnet.attribute_definitions)
+    attribute_definitions.reserve(gnet.attribute_definitions.size());
+    for (auto& ad : gnet.attribute_definitions)
     {
         IAttributeDefinition::EObjectType object_type;
-        auto cvt = ad.value_type;
+        auto& cvt = ad.value_type;
         if (!ad.object_type)
         {
             object_type = IAttributeDefinition::EObjectType::Network;
@@ -651,92 +720,374 @@ static auto getAttributeDefinitions(const G_Network& gnet)
             object_type = IAttributeDefinition::EObjectType::EnvironmentVariable;
         }
         VisitorValueType vvt;
-        auto nad = IAttributeDefinition::Create(std::move(std::string(ad.name)), object_type, boost::apply_visitor(vvt, cvt.value));
+        auto nad = IAttributeDefinition::Create(std::move(ad.name), object_type, boost::apply_visitor(vvt, cvt.value));
         attribute_definitions.push_back(std::move(nad));
     }
     return attribute_definitions;
 }
-static auto getAttributeDefaults(const G_Network& gnet)
+static auto getAttributeDefaults(G_Network& gnet)
 {
     std::vector<std::unique_ptr<IAttribute>> attribute_defaults;
+    attribute_defaults.reserve(gnet.attribute_defaults.size());
     for (auto& ad : gnet.attribute_defaults)
     {
-        auto nad = IAttribute::Create(std::string(ad.name), IAttributeDefinition::EObjectType::Network, ad.value);
+        auto nad = IAttribute::Create(std::move(ad.name), IAttributeDefinition::EObjectType::Network, std::move(ad.value));
         attribute_defaults.push_back(std::move(nad));
     }
     return attribute_defaults;
 }
-static auto getAttributeValues(const G_Network& gnet)
+static auto getAttributeValues(G_Network& gnet)
 {
     std::vector<std::unique_ptr<IAttribute>> attribute_values;
-    for (const auto& av : gnet.attribute_values)
+    for (auto& av : gnet.attribute_values)
     {
         if (auto pan = boost::get<G_AttributeNetwork>(&av))
         {
-            auto av_ = *pan;
             auto attribute = IAttribute::Create(
-                std::string(av_.attribute_name)
+                std::move(pan->attribute_name)
                 , IAttributeDefinition::EObjectType::Network
-                , av_.value);
+                , std::move(pan->value));
             attribute_values.push_back(std::move(attribute));
         }
     }
     return attribute_values;
 }
-static auto getComment(const G_Network& gnet)
+static auto getComment(G_Network& gnet)
 {
     std::string comment;
-    for (const auto& c : gnet.comments)
+    for (auto& c : gnet.comments)
     {
         if (auto pcn = boost::get<G_CommentNetwork>(&c.comment))
         {
-            comment = pcn->comment;
+            comment = std::move(pcn->comment);
             break;
         }
     }
     return comment;
 }
 
-std::unique_ptr<INetwork> DBCAST2Network(const G_Network& gnet)
+// drops the messages the filter doesn't match and the statements referring to them before they are indexed
+static void filterMessages(G_Network& gnet, const DBCMessageFilter& filter)
 {
+    if (filter.Empty())
+    {
+        return;
+    }
+    std::erase_if(gnet.messages, [&](const G_Message& m) { return !filter.Matches(m.id, m.name); });
+    std::unordered_set<uint64_t, NetIndexHash> ids;
+    ids.reserve(gnet.messages.size());
+    for (const auto& m : gnet.messages)
+    {
+        ids.insert(m.id);
+    }
+    auto dropped = [&](uint64_t id) { return !ids.contains(id); };
+    std::erase_if(gnet.message_transmitters, [&](const G_MessageTransmitter& mt) { return dropped(mt.id); });
+    std::erase_if(gnet.signal_extended_value_types, [&](const G_SignalExtendedValueType& evt) { return dropped(evt.message_id); });
+    std::erase_if(gnet.signal_multiplexer_values, [&](const G_SignalMultiplexerValue& smv) { return dropped(smv.message_id); });
+    std::erase_if(gnet.signal_groups, [&](const G_SignalGroup& sg) { return dropped(sg.message_id); });
+    std::erase_if(gnet.comments,
+        [&](const G_Comment& c)
+        {
+            if (auto p = boost::get<G_CommentMessage>(&c.comment))
+                return dropped(p->message_id);
+            if (auto p = boost::get<G_CommentSignal>(&c.comment))
+                return dropped(p->message_id);
+            return false;
+        });
+    std::erase_if(gnet.attribute_values,
+        [&](const variant_attribute_t& av)
+        {
+            if (auto p = boost::get<G_AttributeMessage>(&av))
+                return dropped(p->message_id);
+            if (auto p = boost::get<G_AttributeSignal>(&av))
+                return dropped(p->message_id);
+            return false;
+        });
+    std::erase_if(gnet.value_descriptions_sig_env_var,
+        [&](const G_ValueDescriptionSigEnvVar& vd)
+        {
+            auto p = boost::get<G_ValueDescriptionSignal>(&vd.description);
+            return p && dropped(p->message_id);
+        });
+}
+
+// Consumes the AST: strings and vectors are moved into the network and each section of the AST is freed
+// as soon as it's folded in, so the AST and the network don't have to fit into memory side by side.
+std::unique_ptr<INetwork> DBCAST2Network(G_Network&& gnet, const DBCMessageFilter& filter)
+{
+    filterMessages(gnet, filter);
     NetIndex ni { gnet };
 
+    auto version = getVersion(gnet);
+    auto new_symbols = getNewSymbols(gnet);
+    auto bit_timing = getBitTiming(gnet);
+    auto value_tables = getValueTables(gnet, ni);
+    release(ni.signal_types);
+    release(gnet.signal_types);
+    release(gnet.value_tables);
+
+    auto messages = getMessages(gnet, ni);
+    release(ni.attribute_signals);
+    release(ni.value_description_signals);
+    release(ni.comment_signals);
+    release(ni.signal_extended_value_types);
+    release(ni.signal_multiplexer_values);
+    release(ni.message_transmitters);
+    release(ni.attribute_messages);
+    release(ni.comment_messages);
+    release(ni.signal_groups);
+    release(gnet.messages);
+    release(gnet.message_transmitters);
+    release(gnet.signal_extended_value_types);
+    release(gnet.signal_multiplexer_values);
+    release(gnet.signal_groups);
+
+    auto nodes = getNodes(gnet, ni);
+    release(ni.attribute_nodes);
+    release(ni.comment_nodes);
+    release(gnet.nodes);
+    auto environment_variables = getEnvironmentVariables(gnet, ni);
+    release(ni.value_description_env_vars);
+    release(ni.attribute_env_vars);
+    release(ni.comment_env_vars);
+    release(gnet.environment_variables);
+    release(gnet.environment_variable_datas);
+    auto attribute_values = getAttributeValues(gnet);
+    auto comment = getComment(gnet);
+    release(gnet.attribute_values);
+    release(gnet.value_descriptions_sig_env_var);
+    release(gnet.comments);
+
+    auto attribute_definitions = getAttributeDefinitions(gnet);
+    release(gnet.attribute_definitions);
+    auto attribute_defaults = getAttributeDefaults(gnet);
+    release(gnet.attribute_defaults);
+
     return INetwork::Create(
-          getVersion(gnet)
-        , getNewSymbols(gnet)
-        , getBitTiming(gnet)
-        , getNodes(gnet, ni)
-        , getValueTables(gnet)
-        , getMessages(gnet, ni)
-        , getEnvironmentVariables(gnet, ni)
-        , getAttributeDefinitions(gnet)
-        , getAttributeDefaults(gnet)
-        , getAttributeValues(gnet)
-        , getComment(gnet));
+          std::move(version)
+        , std::move(new_symbols)
+        , std::move(bit_timing)
+        , std::move(nodes)
+        , std::move(value_tables)
+        , std::move(messages)
+        , std::move(environment_variables)
+        , std::move(attribute_definitions)
+        , std::move(attribute_defaults)
+        , std::move(attribute_values)
+        , std::move(comment));
 }
 
-std::unique_ptr<INetwork> INetwork::LoadDBCFromIs(std::istream& is)
+// matches '*' and '?' wildcards, backtracks to the last '*' on a mismatch
+static bool matchesPattern(std::string_view pattern, std::string_view name)
 {
-    std::string str((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
-    std::unique_ptr<dbcppp::INetwork> network;
-    if (auto gnet = dbcppp::DBCX3::ParseFromMemory(str.c_str(), str.c_str() + str.size()))
+    std::size_t p = 0;
+    std::size_t n = 0;
+    std::size_t star = std::string_view::npos;
+    std::size_t star_n = 0;
+    while (n < name.size())
+    {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n]))
+        {
+            p++;
+            n++;
+        }
+        else if (p < pattern.size() && pattern[p] == '*')
+        {
+            star = p++;
+            star_n = n;
+        }
+        else if (star != std::string_view::npos)
+        {
+            p = star + 1;
+            n = ++star_n;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*')
+    {
+        p++;
+    }
+    return p == pattern.size();
+}
+bool DBCMessageFilter::Empty() const noexcept
+{
+    return ids.empty() && id_ranges.empty() && name_patterns.empty();
+}
+bool DBCMessageFilter::Matches(uint64_t id, std::string_view name) const noexcept
+{
+    if (Empty())
+    {
+        return true;
+    }
+    if (std::find(ids.begin(), ids.end(), id) != ids.end())
+    {
+        return true;
+    }
+    for (const auto& [first, last] : id_ranges)
+    {
+        if (id >= first && id <= last)
+        {
+            return true;
+        }
+    }
+    for (const auto& pattern : name_patterns)
+    {
+        if (matchesPattern(pattern, name))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename T, typename I>
+static void appendImpl(std::vector<T>& impls, std::vector<std::unique_ptr<I>>&& objs)
+{
+    impls.reserve(impls.size() + objs.size());
+    for (auto& obj : objs)
+    {
+        impls.push_back(std::move(static_cast<T&>(*obj)));
+    }
+}
+// moves the statements parsed by the lazy metadata into the network the same way DBCAST2Network does
+static void moveMetadataIntoNetwork(NetworkImpl& net, G_Network&& gnet)
+{
+    NetIndex ni { gnet };
+
+    auto node_names = count_keys<std::string_view>(net.nodes(), [](const NodeImpl& n) -> std::string_view { return n.Name(); });
+    for (auto& node : net.nodes())
+    {
+        bool consume = node_names[node.Name()] == 1;
+        node.comment() = getComment(ni_find(ni.comment_nodes, node.Name()), consume);
+        appendImpl(node.attributeValues(), getAttributeValues(ni_find(ni.attribute_nodes, node.Name()), consume));
+    }
+    auto ids = count_keys<uint64_t>(net.messages(), [](const MessageImpl& m) { return m.Id(); });
+    for (auto& msg : net.messages())
+    {
+        bool consume = ids[msg.Id()] == 1;
+        msg.comment() = getComment(ni_find(ni.comment_messages, msg.Id()), consume);
+        appendImpl(msg.attributeValues(), getAttributeValues(ni_find(ni.attribute_messages, msg.Id()), consume));
+        auto signal_names = count_keys<std::string_view>(msg.signals(), [](const SignalImpl& s) -> std::string_view { return s.Name(); });
+        for (auto& sig : msg.signals())
+        {
+            bool consume_signal = consume && signal_names[sig.Name()] == 1;
+            sig.comment() = getComment(ni_find(ni.comment_signals, { msg.Id(), sig.Name() }), consume_signal);
+            appendImpl(sig.attributeValues(), getAttributeValues(ni_find(ni.attribute_signals, { msg.Id(), sig.Name() }), consume_signal));
+        }
+    }
+    appendImpl(net.environmentVariables(), getEnvironmentVariables(gnet, ni));
+    appendImpl(net.attributeValues(), getAttributeValues(gnet));
+    net.comment() = getComment(gnet);
+}
+// statements which can't be parsed are silently ignored, the accessors which trigger the parsing have no way to
+// report them, the order of the grammar isn't enforced
+static G_Network parseColdStatements(const std::vector<std::string_view>& statements)
+{
+    std::string content;
+    for (auto statement : statements)
+    {
+        content.append(statement);
+        content.push_back('\n');
+    }
+    if (auto gnet = dbcppp::DBCX3::FastParsePart(content.data(), content.data(), content.data() + content.size(), false))
+    {
+        return std::move(*gnet);
+    }
+    G_Network gnet;
+    for (auto statement : statements)
+    {
+        auto part = dbcppp::DBCX3::FastParsePart(statement.data(), statement.data(), statement.data() + statement.size(), false);
+        int any_section = -1;
+        if (part)
+        {
+            dbcppp::DBCX3::AppendStatements(gnet, *part, any_section);
+        }
+    }
+    return gnet;
+}
+LazyMetadata::LazyMetadata(NetworkImpl& network, std::shared_ptr<const void> owner, std::vector<std::string_view>&& statements)
+    : _network(network)
+    , _owner(std::move(owner))
+    , _statements(std::move(statements))
+{}
+void LazyMetadata::Load() const
+{
+    std::call_once(_loaded,
+        [this]
+        {
+            moveMetadataIntoNetwork(_network, parseColdStatements(_statements));
+            release(_statements);
+            _owner.reset();
+        });
+}
+
+// owner keeps the content alive for the lazy metadata, without one the unparsed statements are copied
+static std::unique_ptr<INetwork> loadDBC(const char* data, std::size_t size, const DBCLoadOptions& options, std::shared_ptr<const void> owner)
+{
+    const DBCMessageFilter* filter = options.messages.Empty() ? nullptr : &options.messages;
+    std::vector<std::string_view> cold;
+    auto gnet = dbcppp::DBCX3::ParseFromMemory(data, data + size, options.threads, options.fast_parse, filter,
+        options.lazy_metadata ? &cold : nullptr);
+    if (!gnet)
     {
-        network = DBCAST2Network(*gnet);
+        return nullptr;
+    }
+    auto network = DBCAST2Network(std::move(*gnet), options.messages);
+    if (!cold.empty())
+    {
+        if (!owner)
+        {
+            std::size_t cold_size = 0;
+            for (auto statement : cold)
+            {
+                cold_size += statement.size();
+            }
+            auto copy = std::make_shared<std::string>();
+            copy->reserve(cold_size);
+            for (auto& statement : cold)
+            {
+                std::size_t offset = copy->size();
+                copy->append(statement);
+                statement = std::string_view(copy->data() + offset, statement.size());
+            }
+            owner = std::move(copy);
+        }
+        auto& net = static_cast<NetworkImpl&>(*network);
+        net.SetLazyMetadata(std::make_shared<LazyMetadata>(net, std::move(owner), std::move(cold)));
     }
     return network;
 }
+std::unique_ptr<INetwork> INetwork::LoadDBCFromIs(std::istream& is, const DBCLoadOptions& options)
+{
+    std::string str((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    return LoadDBCFromMemory(str.c_str(), str.size(), options);
+}
+std::unique_ptr<INetwork> INetwork::LoadDBCFromFile(const std::filesystem::path& filename, const DBCLoadOptions& options)
+{
+    auto file = MappedFile::Open(filename);
+    if (!file)
+    {
+        return nullptr;
+    }
+    return loadDBC(file->data(), file->size(), options, file);
+}
+std::unique_ptr<INetwork> INetwork::LoadDBCFromMemory(const char* data, std::size_t size, const DBCLoadOptions& options)
+{
+    return loadDBC(data, size, options, nullptr);
+}
 extern "C"
 {
     DBCPPP_API const dbcppp_Network* dbcppp_NetworkLoadDBCFromFile(const char* filename)
     {
-        std::ifstream is(filename);
-        auto net = INetwork::LoadDBCFromIs(is);
+        auto net = INetwork::LoadDBCFromFile(filename);
         return reinterpret_cast<const dbcppp_Network*>(net.release());
     }
     DBCPPP_API const dbcppp_Network* dbcppp_NetworkLoadDBCFromMemory(const char* data)
     {
-        std::istringstream iss(data);
-        auto net = INetwork::LoadDBCFromIs(iss);
+        auto net = INetwork::LoadDBCFromMemory(data, std::strlen(data));
         return reinterpret_cast<const dbcppp_Network*>(net.release());
     }
 }
\ No newline at end of file
@@ -0,0 +1,832 @@
+#include <cstring>
+#include <charconv>
+#include <string_view>
+
+#include "../../include/dbcppp/Network.h"
+#include "DBCX3.h"
+
+using namespace dbcppp::DBCX3::AST;
+
+namespace
+{
+    // character classes of the grammar
+    bool is_space(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+    }
+    bool is_blank(char c)
+    {
+        return c == ' ' || c == '\t';
+    }
+    bool is_digit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+    bool is_identifier_begin(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+    bool is_identifier(char c)
+    {
+        return is_identifier_begin(c) || is_digit(c);
+    }
+
+    // Hand written parser for the statements which make up most of a DBC. It accepts a subset of what the
+    // grammar accepts and produces the same AST for it, without position annotations. Whenever it's not
+    // sure to parse a statement the same way as the grammar does, it fails and leaves the statement to it.
+    class FastParser
+    {
+    public:
+        FastParser(const char* begin, const char* end, const dbcppp::DBCMessageFilter* filter, std::vector<std::string_view>* cold)
+            : _p(begin)
+            , _end(end)
+            , _filter(filter)
+            , _cold(cold)
+        {}
+
+        const char* pos() const
+        {
+            return _p;
+        }
+        void seek(const char* p)
+        {
+            _p = p;
+        }
+        // skips spaces and comments like the skipper of the grammar, fails on unterminated block comments
+        bool skip()
+        {
+            while (_p != _end)
+            {
+                if (is_space(*_p))
+                {
+                    _p++;
+                }
+                else if (*_p == '/' && _end - _p > 1 && _p[1] == '/')
+                {
+                    while (_p != _end && *_p != '\n' && *_p != '\r')
+                    {
+                        _p++;
+                    }
+                }
+                else if (*_p == '/' && _end - _p > 1 && _p[1] == '*')
+                {
+                    std::size_t depth = 1;
+                    for (_p += 2; depth != 0; )
+                    {
+                        if (_end - _p < 2)
+                        {
+                            return false;
+                        }
+                        if (_p[0] == '/' && _p[1] == '*')
+                        {
+                            depth++;
+                            _p += 2;
+                        }
+                        else if (_p[0] == '*' && _p[1] == '/')
+                        {
+                            depth--;
+                            _p += 2;
+                        }
+                        else
+                        {
+                            _p++;
+                        }
+                    }
+                }
+                else
+                {
+                    break;
+                }
+            }
+            return true;
+        }
+        // parses one statement and appends it to part, or appends it unparsed to the cold statements
+        bool statement(G_Network& part)
+        {
+            const char* begin = _p;
+            std::string_view keyword = this->keyword();
+            if (_cold && is_cold(keyword))
+            {
+                if (!skip_statement())
+                {
+                    return false;
+                }
+                _cold->emplace_back(begin, _p - begin);
+                return true;
+            }
+            if (keyword == "BO_")
+            {
+                G_Message m;
+                bool keep;
+                if (!message(m, keep))
+                {
+                    return false;
+                }
+                if (keep)
+                {
+                    part.messages.push_back(std::move(m));
+                }
+                return true;
+            }
+            if (keyword == "CM_")
+            {
+                G_Comment c;
+                return comment(c) && (part.comments.push_back(std::move(c)), true);
+            }
+            if (keyword == "BA_")
+            {
+                variant_attribute_t a;
+                return attribute_value_ent(a) && (part.attribute_values.push_back(std::move(a)), true);
+            }
+            if (keyword == "VAL_")
+            {
+                G_ValueDescriptionSigEnvVar vd;
+                return value_description(vd) && (part.value_descriptions_sig_env_var.push_back(std::move(vd)), true);
+            }
+            if (keyword == "BA_DEF_")
+            {
+                G_AttributeDefinition ad;
+                return attribute_definition(ad) && (part.attribute_definitions.push_back(std::move(ad)), true);
+            }
+            if (keyword == "BA_DEF_DEF_")
+            {
+                G_Attribute a;
+                return attribute_default(a) && (part.attribute_defaults.push_back(std::move(a)), true);
+            }
+            if (keyword == "SIG_VALTYPE_")
+            {
+                G_SignalExtendedValueType evt;
+                return signal_extended_value_type(evt) && (part.signal_extended_value_types.push_back(std::move(evt)), true);
+            }
+            if (keyword == "BO_TX_BU_")
+            {
+                G_MessageTransmitter mt;
+                return message_transmitter(mt) && (part.message_transmitters.push_back(std::move(mt)), true);
+            }
+            if (keyword == "VAL_TABLE_")
+            {
+                G_ValueTable vt;
+                return value_table(vt) && (part.value_tables.push_back(std::move(vt)), true);
+            }
+            return false;
+        }
+
+    private:
+        // Statements which aren't needed to decode and encode. The GenSigStartValue attributes are kept since
+        // they make up the default frame of the encoder.
+        bool is_cold(std::string_view keyword)
+        {
+            if (keyword == "CM_" || keyword == "EV_" || keyword == "ENVVAR_DATA_")
+            {
+                return true;
+            }
+            const char* save = _p;
+            bool cold = false;
+            if (keyword == "BA_")
+            {
+                std::string name;
+                cold = quoted_string(name) && name != "GenSigStartValue";
+            }
+            else if (keyword == "VAL_")
+            {
+                // value descriptions of environment variables
+                cold = skip() && _p != _end && !is_digit(*_p);
+            }
+            _p = save;
+            return cold;
+        }
+        // skips to the first ';' outside of strings and comments
+        bool skip_statement()
+        {
+            while (_p != _end)
+            {
+                if (*_p == ';')
+                {
+                    _p++;
+                    return true;
+                }
+                if (*_p == '"')
+                {
+                    for (_p++; _p != _end && *_p != '"'; _p++)
+                    {
+                        if (*_p == '\\' && _end - _p > 1 && (_p[1] == '\\' || _p[1] == '"'))
+                        {
+                            _p++;
+                        }
+                    }
+                    if (_p == _end)
+                    {
+                        return false;
+                    }
+                    _p++;
+                }
+                else if (*_p == '/' && _end - _p > 1 && (_p[1] == '/' || _p[1] == '*'))
+                {
+                    if (!skip())
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    _p++;
+                }
+            }
+            return false;
+        }
+        // keyword of the statement, only keywords followed by a space are accepted
+        std::string_view keyword()
+        {
+            const char* begin = _p;
+            const char* p = _p;
+            while (p != _end && is_identifier(*p))
+            {
+                p++;
+            }
+            if (p == _end || !is_space(*p))
+            {
+                return {};
+            }
+            _p = p;
+            return std::string_view(begin, p - begin);
+        }
+        // object type literal of comments and attributes, only followed by a space it's sure to be one
+        bool object_type(std::string_view type)
+        {
+            if (std::size_t(_end - _p) <= type.size() || std::memcmp(_p, type.data(), type.size()) != 0 || !is_space(_p[type.size()]))
+            {
+                return false;
+            }
+            _p += type.size();
+            return true;
+        }
+        bool lit(char c)
+        {
+            if (!skip() || _p == _end || *_p != c)
+            {
+                return false;
+            }
+            _p++;
+            return true;
+        }
+        bool eol_or_eoi()
+        {
+            while (_p != _end && is_blank(*_p))
+            {
+                _p++;
+            }
+            if (_p == _end)
+            {
+                return true;
+            }
+            if (*_p == '\r')
+            {
+                _p++;
+                if (_p != _end && *_p == '\n')
+                {
+                    _p++;
+                }
+                return true;
+            }
+            if (*_p == '\n')
+            {
+                _p++;
+                return true;
+            }
+            return false;
+        }
+        bool identifier_here(std::string& out)
+        {
+            if (_p == _end || !is_identifier_begin(*_p))
+            {
+                return false;
+            }
+            const char* begin = _p++;
+            while (_p != _end && is_identifier(*_p))
+            {
+                _p++;
+            }
+            out.assign(begin, _p);
+            return true;
+        }
+        bool identifier(std::string& out)
+        {
+            return skip() && identifier_here(out);
+        }
+        bool quoted_string(std::string& out)
+        {
+            if (!skip() || _p == _end || *_p != '"')
+            {
+                return false;
+            }
+            _p++;
+            // memchr is vectorized, most strings don't contain escapes and are copied at once
+            const char* quote = static_cast<const char*>(std::memchr(_p, '"', _end - _p));
+            if (!quote)
+            {
+                return false;
+            }
+            if (!std::memchr(_p, '\\', quote - _p))
+            {
+                out.assign(_p, quote);
+                _p = quote + 1;
+                return true;
+            }
+            out.clear();
+            while (_p != _end)
+            {
+                if (*_p == '"')
+                {
+                    _p++;
+                    return true;
+                }
+                if (*_p == '\\' && _end - _p > 1 && (_p[1] == '\\' || _p[1] == '"'))
+                {
+                    _p++;
+                }
+                out.push_back(*_p++);
+            }
+            return false;
+        }
+        // numbers glued to an identifier or a dot are left to the grammar
+        bool is_delimiter(const char* p) const
+        {
+            return p == _end || !(is_identifier(*p) || *p == '.');
+        }
+        bool unsigned_int(uint64_t& out)
+        {
+            if (!skip())
+            {
+                return false;
+            }
+            auto [p, ec] = std::from_chars(_p, _end, out);
+            if (ec != std::errc() || !is_delimiter(p))
+            {
+                return false;
+            }
+            _p = p;
+            return true;
+        }
+        bool signed_int(int64_t& out)
+        {
+            if (!skip())
+            {
+                return false;
+            }
+            const char* begin = _p;
+            if (begin != _end && *begin == '+')
+            {
+                begin++;
+                if (begin != _end && *begin == '-')
+                {
+                    return false;
+                }
+            }
+            auto [p, ec] = std::from_chars(begin, _end, out);
+            if (ec != std::errc() || !is_delimiter(p))
+            {
+                return false;
+            }
+            _p = p;
+            return true;
+        }
+        // The grammar accumulates the digits in a double and scales it by a power of ten afterwards. With up
+        // to 15 significant digits and a scale of up to 10^22 both are exact and the result is correctly
+        // rounded, just like the one of from_chars. Other numbers are left to the grammar.
+        bool real(double& out)
+        {
+            if (!skip() || _p == _end)
+            {
+                return false;
+            }
+            // from_chars doesn't accept a plus sign
+            const char* begin = *_p == '+' ? _p + 1 : _p;
+            const char* p = *_p == '+' || *_p == '-' ? _p + 1 : _p;
+            int n_digits = 0;
+            int n_significant = 0;
+            int n_fraction = 0;
+            auto digits =
+                [&](int* count)
+                {
+                    for (; p != _end && is_digit(*p); p++)
+                    {
+                        n_digits++;
+                        if (n_significant != 0 || *p != '0')
+                        {
+                            n_significant++;
+                        }
+                        if (count)
+                        {
+                            (*count)++;
+                        }
+                    }
+                };
+            digits(nullptr);
+            if (p != _end && *p == '.')
+            {
+                p++;
+                digits(&n_fraction);
+            }
+            if (n_digits == 0)
+            {
+                return false;
+            }
+            int exponent = 0;
+            if (p != _end && (*p == 'e' || *p == 'E'))
+            {
+                const char* e = p + 1;
+                bool negative = false;
+                if (e != _end && (*e == '+' || *e == '-'))
+                {
+                    negative = *e == '-';
+                    e++;
+                }
+                const char* exponent_begin = e;
+                for (; e != _end && is_digit(*e) && e - exponent_begin < 4; e++)
+                {
+                    exponent = exponent * 10 + (*e - '0');
+                }
+                if (e == exponent_begin || (e != _end && is_digit(*e)))
+                {
+                    return false;
+                }
+                exponent = negative ? -exponent : exponent;
+                p = e;
+            }
+            if (n_significant > 15 || exponent - n_fraction > 22 || exponent - n_fraction < -22 || !is_delimiter(p))
+            {
+                return false;
+            }
+            auto [q, ec] = std::from_chars(begin, p, out, std::chars_format::general);
+            if (ec != std::errc() || q != p)
+            {
+                return false;
+            }
+            _p = p;
+            return true;
+        }
+        // the grammar tries double_ first, so numeric attribute values are always doubles
+        bool attribute_value(variant_attr_value_t& out)
+        {
+            if (!skip() || _p == _end)
+            {
+                return false;
+            }
+            if (*_p == '"')
+            {
+                std::string value;
+                return quoted_string(value) && (out = std::move(value), true);
+            }
+            double value;
+            return real(value) && (out = value, true);
+        }
+        template <class ValueDescription>
+        bool value_descriptions(std::vector<ValueDescription>& out)
+        {
+            while (true)
+            {
+                if (!skip() || _p == _end)
+                {
+                    return false;
+                }
+                if (*_p == ';')
+                {
+                    _p++;
+                    return true;
+                }
+                ValueDescription vd;
+                if (!signed_int(vd.value) || !quoted_string(vd.description))
+                {
+                    return false;
+                }
+                out.push_back(std::move(vd));
+            }
+        }
+
+        // the signals of messages which are filtered out are parsed but not kept
+        bool message(G_Message& m, bool& keep)
+        {
+            if (!unsigned_int(m.id) || !identifier(m.name) || !lit(':') || !unsigned_int(m.size))
+            {
+                return false;
+            }
+            // the transmitter has to be on the same line
+            while (_p != _end && is_blank(*_p))
+            {
+                _p++;
+            }
+            if (!identifier_here(m.transmitter) || !eol_or_eoi())
+            {
+                return false;
+            }
+            keep = !_filter || _filter->Matches(m.id, m.name);
+            while (true)
+            {
+                const char* save = _p;
+                if (!skip() || !object_type("SG_"))
+                {
+                    _p = save;
+                    return true;
+                }
+                G_Signal s;
+                if (!signal(s))
+                {
+                    return false;
+                }
+                if (keep)
+                {
+                    m.signals.push_back(std::move(s));
+                }
+            }
+        }
+        bool signal(G_Signal& s)
+        {
+            if (!identifier(s.name) || !skip())
+            {
+                return false;
+            }
+            if (_p != _end && is_identifier_begin(*_p))
+            {
+                std::string multiplexer_indicator;
+                identifier_here(multiplexer_indicator);
+                s.multiplexer_indicator = std::move(multiplexer_indicator);
+            }
+            if (!lit(':') || !unsigned_int(s.start_bit) || !lit('|') || !unsigned_int(s.signal_size) || !lit('@'))
+            {
+                return false;
+            }
+            if (!skip() || _p == _end || (*_p != '0' && *_p != '1'))
+            {
+                return false;
+            }
+            s.byte_order = *_p++;
+            if (!skip() || _p == _end || (*_p != '+' && *_p != '-'))
+            {
+                return false;
+            }
+            s.value_type = *_p++;
+            if (!lit('(') || !real(s.factor) || !lit(',') || !real(s.offset) || !lit(')')
+                || !lit('[') || !real(s.minimum) || !lit('|') || !real(s.maximum) || !lit(']')
+                || !quoted_string(s.unit))
+            {
+                return false;
+            }
+            // the receivers have to be on the same line
+            std::string receiver;
+            do
+            {
+                while (_p != _end && is_blank(*_p))
+                {
+                    _p++;
+                }
+                if (!identifier_here(receiver))
+                {
+                    return false;
+                }
+                s.receivers.push_back(std::move(receiver));
+                while (_p != _end && is_blank(*_p))
+                {
+                    _p++;
+                }
+            } while (_p != _end && *_p == ',' && ++_p);
+            return eol_or_eoi();
+        }
+        bool comment(G_Comment& c)
+        {
+            if (!skip())
+            {
+                return false;
+            }
+            if (object_type("BU_"))
+            {
+                G_CommentNode cn;
+                return identifier(cn.node_name) && quoted_string(cn.comment) && lit(';') && (c.comment = std::move(cn), true);
+            }
+            if (object_type("BO_"))
+            {
+                G_CommentMessage cm;
+                return unsigned_int(cm.message_id) && quoted_string(cm.comment) && lit(';') && (c.comment = std::move(cm), true);
+            }
+            if (object_type("SG_"))
+            {
+                G_CommentSignal cs;
+                return unsigned_int(cs.message_id) && identifier(cs.signal_name) && quoted_string(cs.comment) && lit(';')
+                    && (c.comment = std::move(cs), true);
+            }
+            if (object_type("EV_"))
+            {
+                G_CommentEnvVar ce;
+                return identifier(ce.env_var_name) && quoted_string(ce.comment) && lit(';') && (c.comment = std::move(ce), true);
+            }
+            G_CommentNetwork cn;
+            return quoted_string(cn.comment) && lit(';') && (c.comment = std::move(cn), true);
+        }
+        bool attribute_definition(G_AttributeDefinition& ad)
+        {
+            if (!skip())
+            {
+                return false;
+            }
+            for (const char* type : {"BU_", "BO_", "SG_", "EV_"})
+            {
+                if (object_type(type))
+                {
+                    ad.object_type = std::string(type);
+                    break;
+                }
+            }
+            std::string value_type;
+            if (!quoted_string(ad.name) || !identifier(value_type))
+            {
+                return false;
+            }
+            if (value_type == "INT")
+            {
+                G_AttributeValueTypeInt vt;
+                return signed_int(vt.minimum) && signed_int(vt.maximum) && lit(';') && (ad.value_type.value = vt, true);
+            }
+            if (value_type == "HEX")
+            {
+                G_AttributeValueTypeHex vt;
+                return signed_int(vt.minimum) && signed_int(vt.maximum) && lit(';') && (ad.value_type.value = vt, true);
+            }
+            if (value_type == "FLOAT")
+            {
+                G_AttributeValueTypeFloat vt;
+                return real(vt.minimum) && real(vt.maximum) && lit(';') && (ad.value_type.value = vt, true);
+            }
+            if (value_type == "STRING")
+            {
+                return lit(';') && (ad.value_type.value = G_AttributeValueTypeString(), true);
+            }
+            if (value_type == "ENUM")
+            {
+                G_AttributeValueTypeEnum vt;
+                std::string value;
+                do
+                {
+                    if (!quoted_string(value))
+                    {
+                        return false;
+                    }
+                    vt.values.push_back(std::move(value));
+                } while (lit(','));
+                return lit(';') && (ad.value_type.value = std::move(vt), true);
+            }
+            return false;
+        }
+        bool attribute_default(G_Attribute& a)
+        {
+            return quoted_string(a.name) && attribute_value(a.value) && lit(';');
+        }
+        bool attribute_value_ent(variant_attribute_t& out)
+        {
+            std::string name;
+            if (!quoted_string(name) || !skip())
+            {
+                return false;
+            }
+            if (object_type("BU_"))
+            {
+                G_AttributeNode a;
+                a.attribute_name = std::move(name);
+                return identifier(a.node_name) && attribute_value(a.value) && lit(';') && (out = std::move(a), true);
+            }
+            if (object_type("BO_"))
+            {
+                G_AttributeMessage a;
+                a.attribute_name = std::move(name);
+                return unsigned_int(a.message_id) && attribute_value(a.value) && lit(';') && (out = std::move(a), true);
+            }
+            if (object_type("SG_"))
+            {
+                G_AttributeSignal a;
+                a.attribute_name = std::move(name);
+                return unsigned_int(a.message_id) && identifier(a.signal_name) && attribute_value(a.value) && lit(';')
+                    && (out = std::move(a), true);
+            }
+            if (object_type("EV_"))
+            {
+                G_AttributeEnvVar a;
+                a.attribute_name = std::move(name);
+                return identifier(a.env_var_name) && attribute_value(a.value) && lit(';') && (out = std::move(a), true);
+            }
+            G_AttributeNetwork a;
+            a.attribute_name = std::move(name);
+            return attribute_value(a.value) && lit(';') && (out = std::move(a), true);
+        }
+        bool value_description(G_ValueDescriptionSigEnvVar& out)
+        {
+            if (!skip() || _p == _end)
+            {
+                return false;
+            }
+            if (is_digit(*_p))
+            {
+                G_ValueDescriptionSignal vd;
+                return unsigned_int(vd.message_id) && identifier(vd.signal_name) && value_descriptions(vd.value_descriptions)
+                    && (out.description = std::move(vd), true);
+            }
+            G_ValueDescriptionEnvVar vd;
+            return identifier(vd.env_var_name) && value_descriptions(vd.value_descriptions)
+                && (out.description = std::move(vd), true);
+        }
+        bool signal_extended_value_type(G_SignalExtendedValueType& evt)
+        {
+            return unsigned_int(evt.message_id) && identifier(evt.signal_name) && lit(':') && unsigned_int(evt.value) && lit(';');
+        }
+        bool message_transmitter(G_MessageTransmitter& mt)
+        {
+            if (!unsigned_int(mt.id) || !lit(':'))
+            {
+                return false;
+            }
+            std::string transmitter;
+            do
+            {
+                if (!identifier(transmitter))
+                {
+                    return false;
+                }
+                mt.transmitters.push_back(std::move(transmitter));
+            } while (lit(','));
+            return lit(';');
+        }
+        bool value_table(G_ValueTable& vt)
+        {
+            return identifier(vt.name) && value_descriptions(vt.value_encoding_descriptions);
+        }
+
+        const char* _p;
+        const char* _end;
+        const dbcppp::DBCMessageFilter* _filter;
+        std::vector<std::string_view>* _cold;
+    };
+}
+
+std::optional<G_Network> dbcppp::DBCX3::FastParsePart(const char* content_begin, const char* begin, const char* end, bool with_header,
+    const dbcppp::DBCMessageFilter* filter, std::vector<std::string_view>* cold)
+{
+    G_Network gnet;
+    G_Network part;
+    int last_section = -1;
+    // statements which aren't parsed by hand are collected and parsed with the grammar at once
+    const char* pending = with_header ? begin : nullptr;
+    auto flush =
+        [&](const char* pending_end)
+        {
+            if (!pending)
+            {
+                return true;
+            }
+            auto parsed = ParsePart(content_begin, pending, pending_end, with_header);
+            pending = nullptr;
+            if (!parsed)
+            {
+                return false;
+            }
+            if (with_header)
+            {
+                gnet.version = std::move(parsed->version);
+                gnet.new_symbols = std::move(parsed->new_symbols);
+                gnet.bit_timing = std::move(parsed->bit_timing);
+                gnet.nodes = std::move(parsed->nodes);
+                with_header = false;
+            }
+            return AppendStatements(gnet, *parsed, last_section);
+        };
+
+    FastParser parser(with_header ? FindNextStatement(begin, end) : begin, end, filter, cold);
+    while (true)
+    {
+        if (!parser.skip())
+        {
+            return std::nullopt;
+        }
+        const char* statement = parser.pos();
+        if (statement == end)
+        {
+            break;
+        }
+        if (parser.statement(part))
+        {
+            if (!flush(statement) || !AppendStatements(gnet, part, last_section))
+            {
+                return std::nullopt;
+            }
+        }
+        else
+        {
+            if (!pending)
+            {
+                pending = statement;
+            }
+            parser.seek(FindNextStatement(statement, end));
+        }
+    }
+    if (!flush(end))
+    {
+        return std::nullopt;
+    }
+    return gnet;
+}
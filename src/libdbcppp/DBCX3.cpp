@@ -1,10 +1,15 @@
 
+#include <thread>
+#include <sstream>
+#include <algorithm>
+#include <string_view>
 #include <boost/spirit/home/x3.hpp>
 #include <boost/fusion/include/adapt_struct.hpp>
 #include <boost/spirit/home/x3/support/utility/error_reporting.hpp>
 #include <boost/spirit/home/x3/support/utility/annotate_on_success.hpp>
 #include <boost/fusion/include/io.hpp>
 
+#include "Helper.h"
 #include "NetworkImpl.h"
 #include "DBCX3.h"
 
@@ -108,6 +113,7 @@ namespace dbcppp::DBCX3::Grammar
     static const rule<struct TagSignalSignalGroup, G_SignalGroup> signal_group("SignalGroup");
     
     static const rule<struct TagNetwork, G_Network> network("Network");
+    static const rule<struct TagNetworkBody, G_Network> network_body("NetworkBody");
 
     static const auto network_def =
           version
@@ -125,6 +131,29 @@ namespace dbcppp::DBCX3::Grammar
         > *attribute_default
         > *attribute_value_ent
 
+        > *value_description_sig_env_var
+        > *signal_group
+        > *signal_extended_value_type
+        > *signal_multiplexer_value
+        > eoi
+        ;
+    // the statements following the header, used to parse the chunks of a DBC which is parsed in parallel
+    static const auto network_body_def =
+          attr(G_Version())
+        > attr(std::vector<std::string>())
+        > attr(boost::optional<G_BitTiming>())
+        > attr(std::vector<G_Node>())
+        > *value_table
+        > *message
+        > *message_transmitter
+        > *environment_variable
+        > *environment_variable_data
+        > *signal_type
+        > *comment
+        > *attribute_definition
+        > *attribute_default
+        > *attribute_value_ent
+
         > *value_description_sig_env_var
         > *signal_group
         > *signal_extended_value_type
@@ -375,6 +404,7 @@ namespace dbcppp::DBCX3::Grammar
     BOOST_SPIRIT_DEFINE(signal_multiplexer_value);
     BOOST_SPIRIT_DEFINE(signal_group);
     BOOST_SPIRIT_DEFINE(network);
+    BOOST_SPIRIT_DEFINE(network_body);
 
     struct TagCharString                    : error_handler, annotate_on_success {};
     struct TagCIdentifier                   : error_handler, annotate_on_success {};
@@ -451,6 +481,7 @@ namespace dbcppp::DBCX3::Grammar
     struct TagRange                         : error_handler, annotate_on_success {};
     struct TagSignalMultiplexerValue        : error_handler, annotate_on_success {};
     struct TagNetwork                       : error_handler, annotate_on_success {};
+    struct TagNetworkBody                   : error_handler, annotate_on_success {};
 }
 std::optional<dbcppp::DBCX3::AST::G_Network> dbcppp::DBCX3::ParseFromMemory(const char* begin, const char* end)
 {
@@ -469,4 +500,279 @@ std::optional<dbcppp::DBCX3::AST::G_Network> dbcppp::DBCX3::ParseFromMemory(cons
         return gnet;
     }
     return std::nullopt;
-}
\ No newline at end of file
+}
+namespace
+{
+    using namespace dbcppp::DBCX3::AST;
+
+    // parses [begin, end) with the error handler positioned relative to the whole content, errors of parts are
+    // only reported by the sequential fallback
+    template <class Rule>
+    std::optional<G_Network> parse_part(const char* content_begin, const char* begin, const char* end, const Rule& rule)
+    {
+        using boost::spirit::x3::with;
+        using boost::spirit::x3::error_handler_tag;
+        using error_handler_type = boost::spirit::x3::error_handler<const char*>;
+        std::ostringstream errors;
+        error_handler_type error_handler(content_begin, end, errors);
+        auto const parser =
+            with<error_handler_tag>(std::ref(error_handler))
+            [
+                rule
+            ];
+        G_Network gnet;
+        if (phrase_parse(begin, end, parser, dbcppp::DBCX3::Grammar::skipper, gnet) && begin == end)
+        {
+            return gnet;
+        }
+        return std::nullopt;
+    }
+    // statements following the header which a DBC can be split at if they start at the beginning of a line
+    bool starts_statement(const char* p, const char* end)
+    {
+        static constexpr std::string_view keywords[] =
+        {
+            "VAL_TABLE_", "BO_", "BO_TX_BU_", "EV_", "ENVVAR_DATA_", "SGTYPE_", "CM_", "BA_DEF_",
+            "BA_DEF_DEF_", "BA_DEF_DEF_REL_", "BA_", "VAL_", "SIG_GROUP_", "SIG_VALTYPE_", "SG_MUL_VAL_"
+        };
+        std::string_view rest(p, end - p);
+        for (auto keyword : keywords)
+        {
+            if (rest.size() > keyword.size() && rest.starts_with(keyword))
+            {
+                char c = rest[keyword.size()];
+                if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+    // returns the beginnings of the chunks, a chunk begins with the first statement at the beginning of a line
+    // after begin + i * (end - begin) / n_chunks
+    std::vector<const char*> find_chunks(const char* begin, const char* end, std::size_t n_chunks)
+    {
+        std::vector<const char*> chunks{begin};
+        const std::size_t chunk_size = std::size_t(end - begin) / n_chunks;
+        const char* target = begin + chunk_size;
+        for (const char* p = begin; chunks.size() < n_chunks; )
+        {
+            p = dbcppp::DBCX3::FindNextStatement(p, end);
+            if (p == end)
+            {
+                break;
+            }
+            if (p >= target)
+            {
+                chunks.push_back(p);
+                target = p + chunk_size;
+            }
+        }
+        return chunks;
+    }
+    // position of the first and the last statement of the part in the order of the grammar
+    std::pair<int, int> statement_range(const G_Network& gnet)
+    {
+        const std::size_t sizes[] =
+        {
+              gnet.value_tables.size()
+            , gnet.messages.size()
+            , gnet.message_transmitters.size()
+            , gnet.environment_variables.size()
+            , gnet.environment_variable_datas.size()
+            , gnet.signal_types.size()
+            , gnet.comments.size()
+            , gnet.attribute_definitions.size()
+            , gnet.attribute_defaults.size()
+            , gnet.attribute_values.size()
+            , gnet.value_descriptions_sig_env_var.size()
+            , gnet.signal_groups.size()
+            , gnet.signal_extended_value_types.size()
+            , gnet.signal_multiplexer_values.size()
+        };
+        int first = -1;
+        int last = -1;
+        for (int i = 0; i < int(std::size(sizes)); i++)
+        {
+            if (sizes[i] != 0)
+            {
+                first = first == -1 ? i : first;
+                last = i;
+            }
+        }
+        return {first, last};
+    }
+    template <class T>
+    void append(std::vector<T>& lhs, std::vector<T>& rhs)
+    {
+        lhs.insert(lhs.end(), std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()));
+        rhs.clear();
+    }
+}
+
+const char* dbcppp::DBCX3::FindNextStatement(const char* p, const char* end)
+{
+    for (; p < end; p++)
+    {
+        switch (*p)
+        {
+        case '"':
+            // same escapes as the quoted_string rule
+            for (p++; p < end && *p != '"'; p++)
+            {
+                if (*p == '\\' && p + 1 < end && (p[1] == '"' || p[1] == '\\'))
+                {
+                    p++;
+                }
+            }
+            break;
+        case '/':
+            if (p + 1 < end && p[1] == '/')
+            {
+                while (p < end && *p != '\n')
+                {
+                    p++;
+                }
+                p--;
+            }
+            else if (p + 1 < end && p[1] == '*')
+            {
+                // block comments can be nested
+                std::size_t depth = 1;
+                for (p += 2; p < end && depth != 0; p++)
+                {
+                    if (*p == '/' && p + 1 < end && p[1] == '*')
+                    {
+                        depth++;
+                        p++;
+                    }
+                    else if (*p == '*' && p + 1 < end && p[1] == '/')
+                    {
+                        depth--;
+                        p++;
+                    }
+                }
+                p--;
+            }
+            break;
+        case '\n':
+            if (starts_statement(p + 1, end))
+            {
+                return p + 1;
+            }
+            break;
+        }
+    }
+    return end;
+}
+bool dbcppp::DBCX3::AppendStatements(AST::G_Network& gnet, AST::G_Network& part, int& last_section)
+{
+    auto range = statement_range(part);
+    if (range.first == -1)
+    {
+        return true;
+    }
+    if (range.first < last_section)
+    {
+        return false;
+    }
+    last_section = range.second;
+    append(gnet.value_tables, part.value_tables);
+    append(gnet.messages, part.messages);
+    append(gnet.message_transmitters, part.message_transmitters);
+    append(gnet.environment_variables, part.environment_variables);
+    append(gnet.environment_variable_datas, part.environment_variable_datas);
+    append(gnet.signal_types, part.signal_types);
+    append(gnet.comments, part.comments);
+    append(gnet.attribute_definitions, part.attribute_definitions);
+    append(gnet.attribute_defaults, part.attribute_defaults);
+    append(gnet.attribute_values, part.attribute_values);
+    append(gnet.value_descriptions_sig_env_var, part.value_descriptions_sig_env_var);
+    append(gnet.signal_groups, part.signal_groups);
+    append(gnet.signal_extended_value_types, part.signal_extended_value_types);
+    append(gnet.signal_multiplexer_values, part.signal_multiplexer_values);
+    return true;
+}
+std::optional<dbcppp::DBCX3::AST::G_Network> dbcppp::DBCX3::ParsePart(const char* content_begin, const char* begin, const char* end, bool with_header)
+{
+    return with_header
+        ? parse_part(content_begin, begin, end, Grammar::network)
+        : parse_part(content_begin, begin, end, Grammar::network_body);
+}
+std::optional<dbcppp::DBCX3::AST::G_Network> dbcppp::DBCX3::ParseFromMemory(const char* begin, const char* end, std::size_t n_threads,
+    bool fast, const DBCMessageFilter* filter, std::vector<std::string_view>* cold)
+{
+    // smaller chunks don't amortize the thread
+    constexpr std::size_t min_chunk_size = 256 * 1024;
+    fast = fast || cold;
+    // the sequential parser parses all statements
+    auto parse_sequential =
+        [&]
+        {
+            if (cold)
+            {
+                cold->clear();
+            }
+            return ParseFromMemory(begin, end);
+        };
+    if (n_threads == 0)
+    {
+        n_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    std::size_t n_chunks = std::min(n_threads, std::size_t(end - begin) / min_chunk_size);
+    if (n_chunks <= 1)
+    {
+        if (fast)
+        {
+            if (auto gnet = FastParsePart(begin, begin, end, true, filter, cold))
+            {
+                return gnet;
+            }
+        }
+        return parse_sequential();
+    }
+    auto chunks = find_chunks(begin, end, n_chunks);
+    chunks.push_back(end);
+    std::vector<std::optional<G_Network>> results(chunks.size() - 1);
+    std::vector<std::vector<std::string_view>> colds(cold ? results.size() : 0);
+    auto parse =
+        [&](std::size_t i)
+        {
+            try
+            {
+                results[i] = fast
+                    ? FastParsePart(begin, chunks[i], chunks[i + 1], i == 0, filter, cold ? &colds[i] : nullptr)
+                    : ParsePart(begin, chunks[i], chunks[i + 1], i == 0);
+            }
+            catch (...)
+            {
+                results[i] = std::nullopt;
+            }
+        };
+    ParallelFor(results.size(), results.size(), parse);
+
+    // the statements have to be in the order of the grammar across the chunks, otherwise the sequential
+    // parser reports the error at the right position
+    for (const auto& result : results)
+    {
+        if (!result)
+        {
+            return parse_sequential();
+        }
+    }
+    G_Network gnet = std::move(*results[0]);
+    int last_section = statement_range(gnet).second;
+    for (std::size_t i = 1; i < results.size(); i++)
+    {
+        if (!AppendStatements(gnet, *results[i], last_section))
+        {
+            return parse_sequential();
+        }
+    }
+    for (auto& part : colds)
+    {
+        cold->insert(cold->end(), part.begin(), part.end());
+    }
+    return gnet;
+}
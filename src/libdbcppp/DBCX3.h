@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <optional>
+#include <string_view>
 #include <vector>
 
 #include <boost/variant.hpp>
@@ -9,6 +11,8 @@
 
 namespace dbcppp
 {
+    struct DBCMessageFilter;
+
     namespace DBCX3
     {
         namespace AST
@@ -312,5 +316,25 @@ namespace dbcppp
             };
         }
         std::optional<AST::G_Network> DBCPPP_API ParseFromMemory(const char* begin, const char* end);
+        // splits big contents at top level statements and parses the parts on up to n_threads threads, 0 uses all
+        // hardware threads, fast uses FastParsePart for the parts, falls back to the sequential parser if the parts
+        // can't be parsed on their own, cold is only filled by FastParsePart and implies fast
+        std::optional<AST::G_Network> DBCPPP_API ParseFromMemory(const char* begin, const char* end, std::size_t n_threads,
+            bool fast = false, const DBCMessageFilter* filter = nullptr, std::vector<std::string_view>* cold = nullptr);
+
+        // parses [begin, end) of the content starting at content_begin, with the header in front of the statements if
+        // with_header, errors aren't reported
+        std::optional<AST::G_Network> ParsePart(const char* content_begin, const char* begin, const char* end, bool with_header);
+        // same as ParsePart, but the common statements are parsed by hand and only the others with the grammar,
+        // messages the filter doesn't match are skipped by the hand written parser, statements which aren't needed
+        // to decode and encode are appended unparsed to cold instead if it's given
+        std::optional<AST::G_Network> FastParsePart(const char* content_begin, const char* begin, const char* end, bool with_header,
+            const DBCMessageFilter* filter = nullptr, std::vector<std::string_view>* cold = nullptr);
+        // returns the beginning of the first statement at the beginning of a line after p or end, p mustn't be inside of
+        // a quoted string or a comment
+        const char* FindNextStatement(const char* p, const char* end);
+        // moves the statements of part behind the ones of gnet, returns false if they wouldn't be in the order of the
+        // grammar, last_section is the section of the last statement in gnet
+        bool AppendStatements(AST::G_Network& gnet, AST::G_Network& part, int& last_section);
     }
 }
\ No newline at end of file
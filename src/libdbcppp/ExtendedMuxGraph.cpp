@@ -0,0 +1,157 @@
+#include <string>
+#include <unordered_map>
+#include "ExtendedMuxGraph.h"
+
+using namespace dbcppp;
+
+void ExtendedMuxGraph::Build(const std::vector<SignalImpl>& signals, const ISignal* mux_signal)
+{
+    _n_extended = 0;
+    _nodes.clear();
+    _conditions.clear();
+    _ranges.clear();
+
+    std::unordered_map<std::string, uint32_t> signal_by_name;
+    for (std::size_t i = 0; i < signals.size(); i++)
+    {
+        signal_by_name.emplace(signals[i].Name(), uint32_t(i));
+    }
+    auto find_switch =
+        [&](const ISignalMultiplexerValue& smv)
+        {
+            auto iter = signal_by_name.find(smv.SwitchName());
+            return iter != signal_by_name.end() ? iter->second : npos;
+        };
+    const uint32_t mux_index = mux_signal
+        ? uint32_t(static_cast<const SignalImpl*>(mux_signal) - signals.data())
+        : npos;
+
+    // depth first search from the signals with extended multiplexing, the post order is a topological order
+    // in which every switch comes before the signals depending on it, dependencies closing a cycle are dropped
+    enum class EColor : uint8_t { White, Gray, Black };
+    std::vector<EColor> color(signals.size(), EColor::White);
+    std::vector<uint32_t> position(signals.size(), npos);
+    std::vector<uint32_t> order;
+    auto visit =
+        [&](auto& self, uint32_t i) -> void
+        {
+            if (color[i] != EColor::White)
+            {
+                return;
+            }
+            color[i] = EColor::Gray;
+            const SignalImpl& sig = signals[i];
+            if (sig.SignalMultiplexerValues_Size() != 0)
+            {
+                for (const auto& smv : sig.SignalMultiplexerValues())
+                {
+                    uint32_t sw = find_switch(smv);
+                    if (sw != npos)
+                    {
+                        self(self, sw);
+                    }
+                }
+            }
+            else if (sig.MultiplexerIndicator() == ISignal::EMultiplexer::MuxValue && mux_index != npos)
+            {
+                self(self, mux_index);
+            }
+            color[i] = EColor::Black;
+            position[i] = uint32_t(order.size());
+            order.push_back(i);
+        };
+    std::vector<uint32_t> ordinal(signals.size(), npos);
+    for (std::size_t i = 0; i < signals.size(); i++)
+    {
+        if (signals[i].SignalMultiplexerValues_Size() != 0)
+        {
+            ordinal[i] = uint32_t(_n_extended++);
+            visit(visit, uint32_t(i));
+        }
+    }
+
+    _nodes.reserve(order.size());
+    for (uint32_t i : order)
+    {
+        const SignalImpl& sig = signals[i];
+        Node node;
+        node.signal = i;
+        node.ordinal = ordinal[i];
+        node.first_condition = uint32_t(_conditions.size());
+        node.always = false;
+        node.is_switch = false;
+        if (sig.SignalMultiplexerValues_Size() != 0)
+        {
+            for (const auto& smv : sig.SignalMultiplexerValues())
+            {
+                uint32_t sw = find_switch(smv);
+                if (sw == npos || position[sw] >= position[i])
+                {
+                    continue;
+                }
+                std::vector<Range> ranges;
+                for (const auto& r : smv.ValueRanges())
+                {
+                    if (r.from <= r.to)
+                    {
+                        ranges.push_back({uint64_t(r.from), uint64_t(r.to)});
+                    }
+                }
+                std::sort(ranges.begin(), ranges.end(),
+                    [](const Range& lhs, const Range& rhs) { return lhs.from < rhs.from; });
+                Condition cond;
+                cond.switch_node = position[sw];
+                cond.first_range = uint32_t(_ranges.size());
+                for (const auto& r : ranges)
+                {
+                    // overlapping or adjacent, r.from is greater than 0 if the second test is reached, so that
+                    // neither side can overflow
+                    if (_ranges.size() > cond.first_range &&
+                        (r.from <= _ranges.back().to || r.from - 1 <= _ranges.back().to))
+                    {
+                        _ranges.back().to = std::max(_ranges.back().to, r.to);
+                    }
+                    else
+                    {
+                        _ranges.push_back(r);
+                    }
+                }
+                cond.n_ranges = uint32_t(_ranges.size() - cond.first_range);
+                _conditions.push_back(cond);
+            }
+        }
+        else if (sig.MultiplexerIndicator() == ISignal::EMultiplexer::MuxValue)
+        {
+            if (mux_index != npos)
+            {
+                Condition cond;
+                cond.switch_node = position[mux_index];
+                cond.first_range = uint32_t(_ranges.size());
+                cond.n_ranges = 1;
+                _ranges.push_back({sig.MultiplexerSwitchValue(), sig.MultiplexerSwitchValue()});
+                _conditions.push_back(cond);
+            }
+        }
+        else
+        {
+            node.always = true;
+        }
+        node.n_conditions = uint32_t(_conditions.size() - node.first_condition);
+        _nodes.push_back(node);
+    }
+    for (const auto& cond : _conditions)
+    {
+        _nodes[cond.switch_node].is_switch = true;
+    }
+    AllocateScratch();
+}
+void ExtendedMuxGraph::AllocateScratch()
+{
+    _scratch.reset();
+    if (_nodes.size() > max_small_nodes || _n_extended > max_small_extended)
+    {
+        _scratch = std::make_shared<Scratch>();
+        _scratch->states.resize(_nodes.size());
+        _scratch->active.resize(_n_extended);
+    }
+}
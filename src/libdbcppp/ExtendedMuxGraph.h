@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "SignalImpl.h"
+
+namespace dbcppp
+{
+    // Compiled form of the extended multiplexing (SG_MUL_VAL_) of a message.
+    // The signals with extended multiplexing and all switches they depend on are stored as nodes in
+    // topological order, so a single pass decodes every switch at most once and resolves the value
+    // ranges of the conditions through a sorted interval table.
+    class ExtendedMuxGraph
+    {
+    public:
+        static constexpr uint32_t npos = uint32_t(-1);
+
+        // the ordinal of a signal with extended multiplexing is its position among all signals
+        // with extended multiplexing of the message
+        void Build(const std::vector<SignalImpl>& signals, const ISignal* mux_signal);
+        inline std::size_t Size() const noexcept
+        {
+            return _n_extended;
+        }
+        // get_raw(i) returns the raw value of the i-th signal of the message, f(active) is called with a flag for
+        // every signal with extended multiplexing which is set if the signal is active, active[ordinal].
+        // Nothing is allocated, graphs which are too big for the stack are evaluated in the scratch space which
+        // is allocated on Build, concurrent evaluations of such a graph wait for each other.
+        template <class GetRaw, class F>
+        void Evaluate(GetRaw&& get_raw, F&& f) const
+        {
+            if (!_scratch)
+            {
+                std::array<State, max_small_nodes> states;
+                std::array<uint8_t, max_small_extended> active;
+                Run(get_raw, states.data(), active.data());
+                f(static_cast<const uint8_t*>(active.data()));
+                return;
+            }
+            ScratchLock lock(*_scratch);
+            Run(get_raw, _scratch->states.data(), _scratch->active.data());
+            f(static_cast<const uint8_t*>(_scratch->active.data()));
+        }
+        // allocates the scratch space if the graph is too big for the stack, copies of the graph share it
+        void AllocateScratch();
+
+    private:
+        friend class Snapshot;
+
+        struct Node
+        {
+            uint32_t signal;
+            uint32_t ordinal;
+            uint32_t first_condition;
+            uint32_t n_conditions;
+            bool always;
+            bool is_switch;
+        };
+        // the node is active if the switch node is active and its value lies in one of the ranges
+        struct Condition
+        {
+            uint32_t switch_node;
+            uint32_t first_range;
+            uint32_t n_ranges;
+        };
+        struct Range
+        {
+            uint64_t from;
+            uint64_t to;
+        };
+        struct State
+        {
+            bool active;
+            uint64_t value;
+        };
+        struct Scratch
+        {
+            std::vector<State> states;
+            std::vector<uint8_t> active;
+            std::atomic_flag busy;
+        };
+        class ScratchLock
+        {
+        public:
+            ScratchLock(Scratch& scratch) noexcept
+                : _scratch(scratch)
+            {
+                while (_scratch.busy.test_and_set(std::memory_order_acquire))
+                {
+                    _scratch.busy.wait(true, std::memory_order_relaxed);
+                }
+            }
+            ~ScratchLock()
+            {
+                _scratch.busy.clear(std::memory_order_release);
+                _scratch.busy.notify_one();
+            }
+
+        private:
+            Scratch& _scratch;
+        };
+
+        static constexpr std::size_t max_small_nodes = 64;
+        static constexpr std::size_t max_small_extended = 256;
+
+        template <class GetRaw>
+        void Run(GetRaw& get_raw, State* states, uint8_t* active) const
+        {
+            for (std::size_t i = 0; i < _nodes.size(); i++)
+            {
+                const Node& node = _nodes[i];
+                bool is_active = node.always;
+                for (uint32_t j = node.first_condition; !is_active && j < node.first_condition + node.n_conditions; j++)
+                {
+                    const Condition& cond = _conditions[j];
+                    const State& state = states[cond.switch_node];
+                    is_active = state.active && InRanges(cond, state.value);
+                }
+                states[i].active = is_active;
+                if (is_active && node.is_switch)
+                {
+                    states[i].value = get_raw(node.signal);
+                }
+                if (node.ordinal != npos)
+                {
+                    active[node.ordinal] = is_active;
+                }
+            }
+        }
+
+        inline bool InRanges(const Condition& cond, uint64_t value) const noexcept
+        {
+            // the ranges of a condition are sorted and don't overlap
+            auto beg = _ranges.begin() + cond.first_range;
+            auto end = beg + cond.n_ranges;
+            auto iter = std::upper_bound(beg, end, value, [](uint64_t v, const Range& r) { return v < r.from; });
+            return iter != beg && (iter - 1)->to >= value;
+        }
+
+        std::size_t _n_extended = 0;
+        std::vector<Node> _nodes;
+        std::vector<Condition> _conditions;
+        std::vector<Range> _ranges;
+        std::shared_ptr<Scratch> _scratch;
+    };
+}
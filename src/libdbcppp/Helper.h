@@ -1,8 +1,14 @@
 
 #pragma once
 
+#include <mutex>
+#include <atomic>
 #include <string>
 #include <memory>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <exception>
 
 #include "Export.h"
 
@@ -61,4 +67,65 @@ namespace dbcppp
             value = bswap_64(value);
         }
     }
+    inline void big_to_native_inplace(uint64_t& value)
+    {
+        native_to_big_inplace(value);
+    }
+    inline void little_to_native_inplace(uint64_t& value)
+    {
+        native_to_little_inplace(value);
+    }
+    // Calls f(i) for every i in [0, n) on up to n_threads threads including the calling one, each thread takes the
+    // next index which isn't taken yet. If a thread can't be created the started ones do the remaining work, the
+    // threads are always joined before returning. The first exception thrown by f is rethrown after joining and
+    // the remaining indices are skipped then.
+    template <class F>
+    void ParallelFor(std::size_t n, std::size_t n_threads, F&& f)
+    {
+        std::atomic<std::size_t> next = 0;
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        auto work =
+            [&]
+            {
+                try
+                {
+                    for (std::size_t i = next++; i < n; i = next++)
+                    {
+                        f(i);
+                    }
+                }
+                catch (...)
+                {
+                    next = n;
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+            };
+        std::vector<std::thread> threads;
+        try
+        {
+            n_threads = std::min(n_threads, n);
+            threads.reserve(n_threads > 1 ? n_threads - 1 : 0);
+            for (std::size_t i = 1; i < n_threads; i++)
+            {
+                threads.emplace_back(work);
+            }
+        }
+        catch (...)
+        {
+        }
+        work();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
 }
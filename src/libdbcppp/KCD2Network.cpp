@@ -1,13 +1,20 @@
 #include <map>
 #include <memory>
+#include <thread>
 #include <vector>
-#include <optional>
-#include <sstream>
+#include <cstdlib>
 #include <cstring>
+#include <charconv>
+#include <optional>
+#include <exception>
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
 
-#include <libxmlmm.h>
+#include <libxml/xmlreader.h>
 
 #include "../../include/dbcppp/Network.h"
+#include "Helper.h"
 
 using namespace dbcppp;
 
@@ -22,6 +29,9 @@ public:
     {}
 };
 
+// Reads a KCD in a single pass with libxml2's pull parser instead of building a DOM. The elements are collected
+// into the plain structs below while they're read, the node IDs are resolved and the buses are converted into
+// networks in parallel once the document has been read, since nodes may be defined after the buses using them.
 class KCD
 {
 public:
@@ -35,380 +45,535 @@ public:
         double min{0.};
         double max{1.};
     };
+    struct Signal
+    {
+        std::string name;
+        uint64_t start_bit{0};
+        uint64_t bit_size{1};
+        ISignal::EByteOrder byte_order{ISignal::EByteOrder::LittleEndian};
+        std::optional<Value> value;
+        std::vector<std::pair<int64_t, std::string>> labels;
+        std::vector<uint64_t> consumers;
+        bool has_notes{false};
+        std::optional<std::string> comment;
+        uint64_t multiplexer_switch_value{0};
+    };
+    struct Message
+    {
+        uint64_t id{0};
+        std::string name;
+        std::optional<uint64_t> size;
+        std::optional<std::string> comment;
+        std::vector<uint64_t> producers;
+        std::optional<Signal> multiplexer;
+        std::vector<Signal> multiplexed_signals;
+        std::vector<Signal> signals;
+    };
+    struct Bus
+    {
+        std::string name;
+        uint64_t baudrate{500000};
+        std::vector<Message> messages;
+    };
 
     std::map<std::string, std::unique_ptr<INetwork>> _networks;
 
     KCD(std::istream& is)
     {
-        xml::Document doc;
-        doc.read_from_stream(is);
-        parseNetworkDefinition(doc.get_root_element());
-        auto nodes = parseNodes(doc.get_root_element());
-        _networks = std::move(parseNetworks(doc.get_root_element(), nodes));
-    }
-    void
-        parseNetworkDefinition(const xml::Element* net_def)
-    {
-        if (net_def->get_name() != "NetworkDefinition")
+        auto read =
+            [](void* context, char* buffer, int len) -> int
+            {
+                auto& is = *static_cast<std::istream*>(context);
+                is.read(buffer, len);
+                return is.bad() ? -1 : int(is.gcount());
+            };
+        _reader = xmlReaderForIO(read, nullptr, &is, nullptr, nullptr, 0);
+        if (!_reader)
         {
-            throw KCDParserError("could not find root node \"NetworkDefinition\"");
+            throw KCDParserError("could not create XML reader");
         }
+        std::unique_ptr<xmlTextReader, decltype(&xmlFreeTextReader)> reader(_reader, &xmlFreeTextReader);
+        parseDocument();
+        _networks = convertBuses();
     }
-    std::vector<std::unique_ptr<INode>>
-        parseNodes(const xml::Element* net_def)
+
+private:
+    enum class EElement
+    {
+        NetworkDefinition,
+        Bus,
+        Message,
+        Producer,
+        Multiplex,
+        MuxGroup,
+        Signal,
+        Consumer,
+        LabelSet,
+        Notes,
+        Other
+    };
+    struct OpenElement
+    {
+        EElement element;
+        // the signal the element belongs to, if any
+        Signal* signal;
+    };
+
+    void
+        parseDocument()
     {
-        std::vector<std::unique_ptr<INode>> result;
-        const auto nodes = net_def->find_elements("/*[local-name() = 'NetworkDefinition']/*[local-name() = 'Node']");
-        for (const auto* node : nodes)
+        int ret = xmlTextReaderRead(_reader);
+        while (ret == 1)
         {
-            auto n = parseNode(node);
-            result.push_back(std::move(n));
+            bool descend = true;
+            switch (xmlTextReaderNodeType(_reader))
+            {
+            case XML_READER_TYPE_ELEMENT:
+                descend = startElement();
+                break;
+            case XML_READER_TYPE_END_ELEMENT:
+                _open.pop_back();
+                break;
+            case XML_READER_TYPE_TEXT:
+            case XML_READER_TYPE_WHITESPACE:
+            case XML_READER_TYPE_SIGNIFICANT_WHITESPACE:
+                text();
+                break;
+            }
+            ret = descend ? xmlTextReaderRead(_reader) : xmlTextReaderNext(_reader);
         }
-        return std::move(result);
-    }
-    std::unique_ptr<INode>
-        parseNode(const xml::Element* node)
-    {
-        auto name = std::string();
-        if (node->has_attribute("name"))
+        if (ret < 0)
         {
-            name = node->get_attribute("name");
+            throw KCDParserError("could not parse KCD");
         }
-        if (!node->has_attribute("id"))
+        if (!_has_root)
         {
-            throw KCDParserError("");
+            throw KCDParserError("could not find root node \"NetworkDefinition\"");
         }
-        auto id = node->get_attribute<std::size_t>("id");
-        _node_id_to_node_name[id] = name;
-        return INode::Create(std::move(name), "", {});
     }
-    std::unique_ptr<IAttribute>
-        parseAttribute(const xml::Element* var, IAttributeDefinition::EObjectType object_type)
+    // returns false if the element and its children aren't needed
+    bool
+        startElement()
     {
-        std::string name = var->get_attribute("name");
-        IAttribute::value_t value = var->get_attribute("Value");
-        std::stringstream ss;
-        boost::apply_visitor([&](auto v) { ss << v; }, value);
+        std::string_view name = reinterpret_cast<const char*>(xmlTextReaderConstLocalName(_reader));
+        OpenElement open{EElement::Other, nullptr};
+        if (_open.empty())
+        {
+            if (_has_root || name != "NetworkDefinition")
+            {
+                throw KCDParserError("could not find root node \"NetworkDefinition\"");
+            }
+            _has_root = true;
+            open.element = EElement::NetworkDefinition;
+        }
+        else
         {
-            int64_t i64value;
-            ss >> i64value;
-            if (!ss.eof())
+            const auto& parent = _open.back();
+            switch (parent.element)
             {
-                double dvalue;
-                ss >> dvalue;
-                if (ss.eof())
+            case EElement::NetworkDefinition:
+                if (name == "Node")
                 {
-                    value = dvalue;
+                    parseNode();
                 }
-            }
-            else
+                else if (name == "Bus")
+                {
+                    auto& bus = _buses.emplace_back();
+                    bus.name = attribute("name").value_or("");
+                    bus.baudrate = numericAttribute<uint64_t>("baudrate").value_or(bus.baudrate);
+                    open.element = EElement::Bus;
+                }
+                break;
+            case EElement::Bus:
+                if (name == "Message")
+                {
+                    parseMessage(_buses.back().messages.emplace_back());
+                    open.element = EElement::Message;
+                }
+                break;
+            case EElement::Message:
             {
-                value = i64value;
+                auto& message = _buses.back().messages.back();
+                if (name == "Producer")
+                {
+                    open.element = EElement::Producer;
+                }
+                else if (name == "Signal")
+                {
+                    open = {EElement::Signal, &message.signals.emplace_back()};
+                    parseSignal(*open.signal);
+                }
+                // only the first multiplexer of a message is used
+                else if (name == "Multiplex" && !message.multiplexer)
+                {
+                    open = {EElement::Multiplex, &message.multiplexer.emplace()};
+                    parseSignal(*open.signal);
+                }
+                break;
+            }
+            case EElement::Producer:
+                if (name == "NodeRef")
+                {
+                    _buses.back().messages.back().producers.push_back(requiredAttribute<uint64_t>("id"));
+                }
+                break;
+            case EElement::MuxGroup:
+                if (name == "Signal")
+                {
+                    auto& signal = _buses.back().messages.back().multiplexed_signals.emplace_back();
+                    signal.multiplexer_switch_value = _multiplexer_switch_value;
+                    open = {EElement::Signal, &signal};
+                    parseSignal(signal);
+                }
+                break;
+            case EElement::Multiplex:
+                if (name == "MuxGroup")
+                {
+                    _multiplexer_switch_value = requiredAttribute<uint64_t>("count");
+                    open.element = EElement::MuxGroup;
+                    break;
+                }
+                [[fallthrough]];
+            case EElement::Signal:
+                open.signal = parent.signal;
+                if (name == "Consumer")
+                {
+                    open.element = EElement::Consumer;
+                }
+                else if (name == "Value" && !open.signal->value)
+                {
+                    parseValue(open.signal->value.emplace());
+                }
+                else if (name == "LabelSet")
+                {
+                    open.element = EElement::LabelSet;
+                }
+                // the DOM loader looked the notes up with an XPath query without namespace, which only matches
+                // notes without namespace, this is kept so the loaded networks don't change
+                else if (name == "Notes" && !xmlTextReaderConstNamespaceUri(_reader) && !open.signal->has_notes)
+                {
+                    open.signal->has_notes = true;
+                    open.element = EElement::Notes;
+                }
+                break;
+            case EElement::Consumer:
+                if (name == "NodeRef")
+                {
+                    parent.signal->consumers.push_back(requiredAttribute<uint64_t>("id"));
+                }
+                break;
+            case EElement::LabelSet:
+                // we are ignoring LabelGroup, it is not supported by the library
+                if (name == "Label")
+                {
+                    auto value = requiredAttribute<int64_t>("value");
+                    parent.signal->labels.emplace_back(value, attribute("name").value_or(""));
+                }
+                break;
+            default:
+                break;
             }
         }
-        return IAttribute::Create(std::move(name), object_type, value);
+        if (open.element == EElement::Other)
+        {
+            return false;
+        }
+        if (!xmlTextReaderIsEmptyElement(_reader))
+        {
+            _open.push_back(open);
+        }
+        return true;
     }
-    std::map<std::string, std::unique_ptr<INetwork>>
-        parseNetworks(const xml::Element* net_def, const std::vector<std::unique_ptr<INode>>& nodes)
+    // like the DOM loader the comment of a message or signal is the first text node of the element or its notes
+    void
+        text()
     {
-        std::map<std::string, std::unique_ptr<INetwork>> networks;
-        const auto buses = net_def->find_elements("/*[local-name() = 'NetworkDefinition']/*[local-name() = 'Bus']");
-        for (const auto* bus : buses)
+        if (_open.empty())
+        {
+            return;
+        }
+        std::optional<std::string>* comment = nullptr;
+        switch (_open.back().element)
+        {
+        case EElement::Message: comment = &_buses.back().messages.back().comment; break;
+        case EElement::Notes:   comment = &_open.back().signal->comment; break;
+        default: return;
+        }
+        if (!*comment)
         {
-            networks.insert(parseNetwork(bus, nodes));
+            *comment = reinterpret_cast<const char*>(xmlTextReaderConstValue(_reader));
         }
-        return std::move(networks);
     }
-    std::pair<std::string, std::unique_ptr<INetwork>>
-        parseNetwork(const xml::Element* bus, const std::vector<std::unique_ptr<INode>>& nodes)
+    void
+        parseNode()
     {
-        auto name = bus->get_attribute("name");
-        auto bit_timing = parseBitTiming(bus);
-        auto msgs = std::vector<std::unique_ptr<IMessage>>();
-        const auto messages = bus->find_elements("./*[local-name() = 'Message']");
-        for (const auto* message : messages)
+        auto id = numericAttribute<uint64_t>("id");
+        if (!id)
         {
-            auto msg = parseMessage(message);
-            msgs.push_back(std::move(msg));
+            throw KCDParserError("could not find attribute \"id\" of node");
         }
-        auto ns = std::vector<std::unique_ptr<INode>>();
-        for (const auto& node : nodes)
+        auto name = attribute("name").value_or("");
+        _node_id_to_node_name[*id] = name;
+        _node_names.push_back(std::move(name));
+    }
+    void
+        parseMessage(Message& message)
+    {
+        auto str_id = attribute("id").value_or("");
+        bool hex = str_id.size() > 1 && (str_id[1] == 'x' || str_id[1] == 'X');
+        message.id = std::strtoull(str_id.c_str(), nullptr, hex ? 16 : 10);
+        message.name = attribute("name").value_or("");
+        auto length = attribute("length");
+        if (length && *length != "auto")
         {
-            ns.push_back(node->Clone());
+            message.size = toNumber<uint64_t>("length", *length);
         }
-        return std::make_pair(
-              name
-            , INetwork::Create(
-                  ""
-                , {}
-                , std::move(bit_timing)
-                , std::move(ns)
-                , {}
-                , std::move(msgs)
-                , {}, {}, {}, {}, ""));
     }
-    std::unique_ptr<IBitTiming>
-        parseBitTiming(const xml::Element* bus)
+    void
+        parseSignal(Signal& signal)
     {
-        uint64_t baudrate = 500000;
-        if (bus->has_attribute("baudrate"))
+        signal.name = attribute("name").value_or("");
+        signal.start_bit = requiredAttribute<uint64_t>("offset");
+        signal.bit_size = numericAttribute<uint64_t>("length").value_or(1);
+        if (attribute("endianess") == "big")
         {
-            baudrate = bus->get_attribute<uint64_t>("baudrate");
+            signal.byte_order = ISignal::EByteOrder::BigEndian;
         }
-        return IBitTiming::Create(baudrate, 0, 0);
     }
-    uint64_t
-        getMessageSize(const xml::Element* message)
+    void
+        parseValue(Value& value)
     {
-        uint64_t max = 0;
-        const auto signals = message->find_elements("./*[local-name() = 'Signal']");
-        for (const auto* signal : signals)
+        if (auto vt = attribute("type"))
         {
-            uint64_t offset = signal->get_attribute<uint64_t>("offset");
-            uint64_t length = 1;
-            if (signal->has_attribute("length"))
+            if (*vt == "signed")
+            {
+                value.value_type = ISignal::EValueType::Signed;
+            }
+            else if (*vt == "single")
             {
-                length = signal->get_attribute<uint64_t>("length");
+                value.extended_value_type = ISignal::EExtendedValueType::Float;
             }
-            if (max < offset + length)
+            else if (*vt == "double")
             {
-                max = offset + length;
+                value.extended_value_type = ISignal::EExtendedValueType::Double;
             }
         }
-        return (max + 7) / 8;
+        value.factor = numericAttribute<double>("slope").value_or(value.factor);
+        value.offset = numericAttribute<double>("intercept").value_or(value.offset);
+        value.unit = attribute("unit").value_or(value.unit);
+        value.min = numericAttribute<double>("min").value_or(value.min);
+        // the DOM loader stored the maximum as minimum, this is kept so the loaded networks don't change
+        value.min = numericAttribute<double>("max").value_or(value.min);
     }
-    std::unique_ptr<IMessage>
-        parseMessage(const xml::Element* message)
+
+    std::optional<std::string>
+        attribute(const char* name)
     {
-        auto str_id = message->get_attribute("id");
-        auto id = uint64_t();
-        if (str_id[1] == 'x' || str_id[1] == 'X')
+        xmlChar* value = xmlTextReaderGetAttribute(_reader, reinterpret_cast<const xmlChar*>(name));
+        if (!value)
         {
-            std::stringstream ss;
-            ss << std::hex << str_id;
-            ss >> id;
+            return std::nullopt;
         }
-        else
+        std::string result = reinterpret_cast<const char*>(value);
+        xmlFree(value);
+        return result;
+    }
+    template <class T>
+    static T
+        toNumber(const char* name, std::string_view str)
+    {
+        const char* begin = str.data();
+        const char* end = str.data() + str.size();
+        if (begin != end && *begin == '+')
         {
-            std::stringstream ss;
-            ss << str_id;
-            ss >> id;
+            begin++;
         }
-        auto name = message->get_attribute("name");
-        auto comment = parseComment(message);
-        const auto* node_ref = message->find_element("./*[local-name() = 'Producer']/*[local-name() = 'NodeRef']");
-        auto producer = _node_id_to_node_name.find(node_ref->get_attribute<uint64_t>("id"))->second;
-        auto message_size = uint64_t(0);
-        if (!message->has_attribute("length") ||
-            message->get_attribute("length") == "auto")
+        T result{};
+        auto [ptr, ec] = std::from_chars(begin, end, result);
+        if (ec != std::errc() || ptr != end)
         {
-            message_size = getMessageSize(message);
+            throw KCDParserError("invalid value \"" + std::string(str) + "\" of attribute \"" + name + "\"");
         }
-        else
+        return result;
+    }
+    template <class T>
+    std::optional<T>
+        numericAttribute(const char* name)
+    {
+        if (auto str = attribute(name))
         {
-            message_size = message->get_attribute<uint64_t>("length");
+            return toNumber<T>(name, *str);
         }
-        const auto* note = message->find_element("./*[local-name() = 'Notes']");
-        auto nt = parseComment(note);
-        auto transmitter = parseTransmitter(message);
-        auto signals = parseSignals(message, message_size);
-        return IMessage::Create(
-              id
-            , std::move(name)
-            , message_size
-            , std::move(producer)
-            , std::move(transmitter)
-            , std::move(signals)
-            , {}
-            , std::move(comment)
-            , {});
+        return std::nullopt;
     }
-    std::string
-        parseComment(const xml::Element* note)
+    template <class T>
+    T
+        requiredAttribute(const char* name)
     {
-        std::string result;
-        if (note != nullptr)
+        if (auto value = numericAttribute<T>(name))
         {
-            result = note->get_text();
+            return *value;
         }
-        return result;
+        throw KCDParserError(std::string("could not find attribute \"") + name + "\"");
     }
-    std::vector<std::string>
-        parseTransmitter(const xml::Element* message)
+
+    const std::string&
+        nodeName(uint64_t id) const
     {
-        std::vector<std::string> result;
-        const auto node_refs = message->find_elements("./*[local-name() = 'Producer']/*[local-name() = 'NodeRef']");
-        for (const auto* node_ref : node_refs)
+        const auto node_name = _node_id_to_node_name.find(id);
+        if (node_name == _node_id_to_node_name.end())
         {
-            auto id = node_ref->get_attribute<std::size_t>("id");
-            const auto node_name = _node_id_to_node_name.find(id);
-            if (node_name == _node_id_to_node_name.end())
-            {
-                throw KCDParserError("could not find node with ID \"" + std::to_string(id) + "\"");
-            }
-            result.push_back(node_name->second);
+            throw KCDParserError("could not find node with ID \"" + std::to_string(id) + "\"");
         }
-        return result;
+        return node_name->second;
     }
-    std::vector<std::unique_ptr<ISignal>>
-        parseSignals(const xml::Element* message, uint64_t message_size)
+    std::map<std::string, std::unique_ptr<INetwork>>
+        convertBuses()
     {
-        std::vector<std::unique_ptr<ISignal>> sigs;
-        const auto* multiplex = message->find_element("./*[local-name() = 'Multiplex']");
-        if (multiplex != nullptr)
-        {
-            auto mux_signal = parseSignal(multiplex, message_size, ISignal::EMultiplexer::MuxSwitch, 0);
-            sigs.push_back(std::move(mux_signal));
-            const auto mux_groups = multiplex->find_elements("./*[local-name() = 'MuxGroup']");
-            for (const auto* mux_group : mux_groups)
+        std::vector<std::unique_ptr<INetwork>> networks(_buses.size());
+        std::vector<std::exception_ptr> errors(_buses.size());
+        // the errors are rethrown in the order of the buses, so the reported error doesn't depend on the threads
+        ParallelFor(_buses.size(), std::max(std::thread::hardware_concurrency(), 1u),
+            [&](std::size_t i)
             {
-                uint64_t multiplex_indicator = mux_group->get_attribute<uint64_t>("count");
-                const auto signals = mux_group->find_elements("./*[local-name() = 'Signal']");
-                for (const auto* signal : signals)
+                try
                 {
-                    auto sig = parseSignal(signal, message_size, ISignal::EMultiplexer::MuxValue, multiplex_indicator);
-                    sigs.push_back(std::move(sig));
+                    networks[i] = convertBus(_buses[i]);
                 }
-            }
-        }
-        const auto signals = message->find_elements("./*[local-name() = 'Signal']");
-        for (const auto* signal : signals)
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            });
+        std::map<std::string, std::unique_ptr<INetwork>> result;
+        for (std::size_t i = 0; i < _buses.size(); i++)
         {
-            auto sig = parseSignal(signal, message_size, ISignal::EMultiplexer::NoMux, 0);
-            sigs.push_back(std::move(sig));
+            if (errors[i])
+            {
+                std::rethrow_exception(errors[i]);
+            }
+            result.insert(std::make_pair(std::move(_buses[i].name), std::move(networks[i])));
         }
-        return std::move(sigs);
+        return result;
     }
-    std::unique_ptr<ISignal>
-        parseSignal(const xml::Element* signal, uint64_t message_size, ISignal::EMultiplexer mux, uint64_t multiplex_indicator)
+    std::unique_ptr<INetwork>
+        convertBus(Bus& bus) const
     {
-        auto comment = parseComment(signal->find_element("Notes"));
-        auto receivers = parseReceivers(signal);
-        auto name = signal->get_attribute("name");
-        auto start_bit = signal->get_attribute<uint64_t>("offset");
-        auto bit_size = uint64_t(1);
-        if (signal->has_attribute("length"))
-        {
-            bit_size = signal->get_attribute<uint64_t>("length");
-        }
-        auto byte_order = ISignal::EByteOrder::LittleEndian;
-        auto value_type = ISignal::EValueType::Unsigned;
-        auto extended_value_type = ISignal::EExtendedValueType::Integer;
-        auto factor = 1.;
-        auto offset = 0.;
-        auto unit = std::string("");
-        auto min = 0.;
-        auto max = 1.;
-        auto value_encoding_descriptions = std::vector<std::unique_ptr<IValueEncodingDescription>>();
-        if (signal->has_attribute("endianess") &&
-            signal->get_attribute("endianess") == "big")
-        {
-            byte_order = ISignal::EByteOrder::BigEndian;
-        }
-        const auto* value = signal->find_element("./*[local-name() = 'Value']");
-        if (value != nullptr)
+        auto msgs = std::vector<std::unique_ptr<IMessage>>();
+        msgs.reserve(bus.messages.size());
+        for (auto& message : bus.messages)
         {
-            auto v = parseValue(value);
-            value_type = v.value_type;
-            extended_value_type = v.extended_value_type;
-            factor = v.factor;
-            offset = v.offset;
-            unit = v.unit;
-            min = v.min;
-            max = v.max;
+            msgs.push_back(convertMessage(message));
         }
-        // we are ignoring LabelGroup, it is not supported by the library
-        const auto label_set = signal->find_elements("./*[local-name() = 'LabelSet']/*[local-name() = 'Label']");
-        for (const auto* label : label_set)
+        auto ns = std::vector<std::unique_ptr<INode>>();
+        ns.reserve(_node_names.size());
+        for (const auto& name : _node_names)
         {
-            auto value = label->get_attribute<int64_t>("value");
-            auto name = label->get_attribute("name");
-            auto ved = IValueEncodingDescription::Create(value, std::move(name));
-            value_encoding_descriptions.push_back(std::move(ved));
+            ns.push_back(INode::Create(std::string(name), "", {}));
         }
-        return ISignal::Create(
-              message_size
-            , std::move(name)
-            , mux
-            , multiplex_indicator
-            , start_bit
-            , bit_size
-            , byte_order
-            , value_type
-            , factor
-            , offset
-            , min
-            , max
-            , std::move(unit)
-            , std::move(receivers)
+        return INetwork::Create(
+              ""
             , {}
-            , std::move(value_encoding_descriptions)
-            , std::move(comment)
-            , extended_value_type
-            , {});
+            , IBitTiming::Create(bus.baudrate, 0, 0)
+            , std::move(ns)
+            , {}
+            , std::move(msgs)
+            , {}, {}, {}, {}, "");
     }
-    std::vector<std::string>
-        parseReceivers(const xml::Element* signal)
+    std::unique_ptr<IMessage>
+        convertMessage(Message& message) const
     {
-        std::vector<std::string> result;
-        const auto node_refs = signal->find_elements("./*[local-name() = 'Consumer']/*[local-name() = 'NodeRef']");
-        for (const auto* node_ref : node_refs)
+        auto message_size = uint64_t(0);
+        if (message.size)
         {
-            auto id = node_ref->get_attribute<std::size_t>("id");
-            const auto node_name = _node_id_to_node_name.find(id);
-            result.push_back(node_name->second);
+            message_size = *message.size;
         }
-        return result;
-    }
-    Value
-        parseValue(const xml::Element* value)
-    {
-        Value result;
-        if (value->has_attribute("type"))
+        else
         {
-            auto vt = value->get_attribute("type");
-            if (vt == "signed")
-            {
-                result.value_type = ISignal::EValueType::Signed;
-            }
-            else if (vt == "single")
-            {
-                result.extended_value_type = ISignal::EExtendedValueType::Float;
-            }
-            else if (vt == "double")
+            uint64_t max = 0;
+            for (const auto& signal : message.signals)
             {
-                result.extended_value_type = ISignal::EExtendedValueType::Double;
+                max = std::max(max, signal.start_bit + signal.bit_size);
             }
+            message_size = (max + 7) / 8;
         }
-        if (value->has_attribute("slope"))
+        auto transmitter = std::vector<std::string>();
+        for (auto id : message.producers)
         {
-            result.factor = value->get_attribute<double>("slope");
+            transmitter.push_back(nodeName(id));
         }
-        if (value->has_attribute("intercept"))
+        auto producer = transmitter.empty() ? std::string() : transmitter.front();
+        auto signals = std::vector<std::unique_ptr<ISignal>>();
+        if (message.multiplexer)
         {
-            result.offset = value->get_attribute<double>("intercept");
+            signals.push_back(convertSignal(*message.multiplexer, message_size, ISignal::EMultiplexer::MuxSwitch));
+            for (auto& signal : message.multiplexed_signals)
+            {
+                signals.push_back(convertSignal(signal, message_size, ISignal::EMultiplexer::MuxValue));
+            }
         }
-        if (value->has_attribute("unit"))
+        for (auto& signal : message.signals)
         {
-            result.unit = value->get_attribute("unit");
+            signals.push_back(convertSignal(signal, message_size, ISignal::EMultiplexer::NoMux));
         }
-        if (value->has_attribute("min"))
+        return IMessage::Create(
+              message.id
+            , std::move(message.name)
+            , message_size
+            , std::move(producer)
+            , std::move(transmitter)
+            , std::move(signals)
+            , {}
+            , std::move(message.comment).value_or("")
+            , {});
+    }
+    std::unique_ptr<ISignal>
+        convertSignal(Signal& signal, uint64_t message_size, ISignal::EMultiplexer mux) const
+    {
+        auto receivers = std::vector<std::string>();
+        for (auto id : signal.consumers)
         {
-            result.min = value->get_attribute<double>("min");
+            receivers.push_back(nodeName(id));
         }
-        if (value->has_attribute("max"))
+        auto value_encoding_descriptions = std::vector<std::unique_ptr<IValueEncodingDescription>>();
+        for (auto& [value, name] : signal.labels)
         {
-            result.min = value->get_attribute<double>("max");
+            value_encoding_descriptions.push_back(IValueEncodingDescription::Create(value, std::move(name)));
         }
-        return result;
+        auto v = std::move(signal.value).value_or(Value());
+        return ISignal::Create(
+              message_size
+            , std::move(signal.name)
+            , mux
+            , mux == ISignal::EMultiplexer::MuxValue ? signal.multiplexer_switch_value : 0
+            , signal.start_bit
+            , signal.bit_size
+            , signal.byte_order
+            , v.value_type
+            , v.factor
+            , v.offset
+            , v.min
+            , v.max
+            , std::move(v.unit)
+            , std::move(receivers)
+            , {}
+            , std::move(value_encoding_descriptions)
+            , std::move(signal.comment).value_or("")
+            , v.extended_value_type
+            , {});
     }
 
-private:
-    std::map<std::size_t, std::string> _node_id_to_node_name;
+    xmlTextReaderPtr _reader{nullptr};
+    bool _has_root{false};
+    std::vector<OpenElement> _open;
+    uint64_t _multiplexer_switch_value{0};
+    std::vector<Bus> _buses;
+    std::vector<std::string> _node_names;
+    std::unordered_map<uint64_t, std::string> _node_id_to_node_name;
 };
 
 std::map<std::string, std::unique_ptr<INetwork>> INetwork::LoadKCDFromIs(std::istream& is)
 {
     KCD kcd(is);
     return std::move(kcd._networks);
-}
\ No newline at end of file
+}
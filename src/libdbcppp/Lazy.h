@@ -0,0 +1,53 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+
+namespace dbcppp
+{
+    // Value which is built thread safe on the first access, copies and moves start with an unbuilt value
+    template <class T>
+    class Lazy
+    {
+    public:
+        Lazy() = default;
+        Lazy(const Lazy&) {}
+        Lazy(Lazy&&) noexcept {}
+        Lazy& operator=(const Lazy&)
+        {
+            Reset();
+            return *this;
+        }
+        Lazy& operator=(Lazy&&) noexcept
+        {
+            Reset();
+            return *this;
+        }
+
+        // has to be called after the data the value is built from has been modified, not thread safe
+        void Reset()
+        {
+            _built.store(false, std::memory_order_relaxed);
+        }
+        // build(T&) is called once to build the value
+        template <class Build>
+        const T& Get(Build&& build) const
+        {
+            if (!_built.load(std::memory_order_acquire))
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_built.load(std::memory_order_relaxed))
+                {
+                    build(_value);
+                    _built.store(true, std::memory_order_release);
+                }
+            }
+            return _value;
+        }
+
+    private:
+        mutable std::mutex _mutex;
+        mutable std::atomic<bool> _built{false};
+        mutable T _value;
+    };
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <string_view>
+
+namespace dbcppp
+{
+    class NetworkImpl;
+
+    // Comments, attribute values, environment variables and their value descriptions of a DBC which are kept as
+    // unparsed statements and are only parsed and moved into the network on the first access of one of them.
+    class LazyMetadata
+    {
+    public:
+        // the statements are viewed in content which is kept alive by owner
+        LazyMetadata(NetworkImpl& network, std::shared_ptr<const void> owner, std::vector<std::string_view>&& statements);
+
+        // thread safe, only the first call parses the statements
+        void Load() const;
+
+    private:
+        NetworkImpl& _network;
+        // released once loaded
+        mutable std::shared_ptr<const void> _owner;
+        mutable std::vector<std::string_view> _statements;
+        mutable std::once_flag _loaded;
+    };
+    // Refers to the lazy metadata of the network an object belongs to. Copies load the metadata of the source and
+    // don't refer to it anymore, so it has to be the first member of the object. Moves take the reference over
+    // without loading, so the metadata of a network has to be loaded before its objects are moved into another
+    // network (see NetworkImpl::Append).
+    class LazyMetadataRef
+    {
+    public:
+        LazyMetadataRef() = default;
+        LazyMetadataRef(const LazyMetadataRef& other)
+        {
+            other.Load();
+        }
+        LazyMetadataRef(LazyMetadataRef&& other) noexcept
+            : _lazy(other._lazy)
+        {
+            other._lazy = nullptr;
+        }
+        LazyMetadataRef& operator=(const LazyMetadataRef& other)
+        {
+            other.Load();
+            _lazy = nullptr;
+            return *this;
+        }
+        LazyMetadataRef& operator=(LazyMetadataRef&& other) noexcept
+        {
+            _lazy = other._lazy;
+            other._lazy = nullptr;
+            return *this;
+        }
+
+        void Set(const LazyMetadata* lazy)
+        {
+            _lazy = lazy;
+        }
+        void Load() const
+        {
+            if (_lazy)
+            {
+                _lazy->Load();
+            }
+        }
+
+    private:
+        const LazyMetadata* _lazy = nullptr;
+    };
+}
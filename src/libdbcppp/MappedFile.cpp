@@ -0,0 +1,109 @@
+#include <new>
+#include <fstream>
+#include "MappedFile.h"
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#endif
+
+using namespace dbcppp;
+
+namespace
+{
+    constexpr std::align_val_t buffer_alignment{64};
+
+    // fallback for files which can't be mapped
+    bool read_file(const std::filesystem::path& filename, const char*& data, std::size_t& size)
+    {
+        std::ifstream is(filename, std::ios::binary | std::ios::ate);
+        if (!is.is_open())
+        {
+            return false;
+        }
+        size = std::size_t(is.tellg());
+        char* buffer = static_cast<char*>(::operator new(size + 1, buffer_alignment));
+        is.seekg(0);
+        if (!is.read(buffer, size))
+        {
+            ::operator delete(buffer, buffer_alignment);
+            return false;
+        }
+        buffer[size] = '\0';
+        data = buffer;
+        return true;
+    }
+}
+
+std::shared_ptr<const MappedFile> MappedFile::Open(const std::filesystem::path& filename)
+{
+    std::shared_ptr<MappedFile> result{new MappedFile()};
+#ifdef _WIN32
+    HANDLE file = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(file, &size) && size.QuadPart != 0)
+        {
+            HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping)
+            {
+                if (void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0))
+                {
+                    result->_data = static_cast<const char*>(view);
+                    result->_size = std::size_t(size.QuadPart);
+                    result->_mapped = true;
+                    result->_file = file;
+                    result->_mapping = mapping;
+                    return result;
+                }
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+    }
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd != -1)
+    {
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size != 0)
+        {
+            void* view = ::mmap(nullptr, std::size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            if (view != MAP_FAILED)
+            {
+                ::close(fd);
+                result->_data = static_cast<const char*>(view);
+                result->_size = std::size_t(st.st_size);
+                result->_mapped = true;
+                return result;
+            }
+        }
+        ::close(fd);
+    }
+#endif
+    if (!read_file(filename, result->_data, result->_size))
+    {
+        return nullptr;
+    }
+    return result;
+}
+MappedFile::~MappedFile()
+{
+    if (!_mapped)
+    {
+        ::operator delete(const_cast<char*>(_data), buffer_alignment);
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(_data);
+    CloseHandle(_mapping);
+    CloseHandle(_file);
+#else
+    ::munmap(const_cast<char*>(_data), _size);
+#endif
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <cstddef>
+#include <filesystem>
+
+namespace dbcppp
+{
+    // Read-only view of a whole file. The file is memory mapped where the platform supports it, so
+    // processes mapping the same file share its pages, otherwise it's read into a 64 byte aligned buffer.
+    class MappedFile
+    {
+    public:
+        // returns nullptr if the file can't be opened
+        static std::shared_ptr<const MappedFile> Open(const std::filesystem::path& filename);
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        const char* data() const noexcept
+        {
+            return _data;
+        }
+        std::size_t size() const noexcept
+        {
+            return _size;
+        }
+
+    private:
+        MappedFile() = default;
+
+        const char* _data = nullptr;
+        std::size_t _size = 0;
+        bool _mapped = false;
+#ifdef _WIN32
+        void* _file = nullptr;
+        void* _mapping = nullptr;
+#endif
+    };
+}
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <unordered_set>
+#include "MessageIdIndex.h"
+
+using namespace dbcppp;
+
+MessageIdIndex::MessageIdIndex()
+    : _standard_bitmap{}
+    , _salt(0)
+{}
+void MessageIdIndex::Build(const std::vector<uint64_t>& ids)
+{
+    _standard_bitmap.fill(0);
+    _standard_table.clear();
+    _seeds.clear();
+    _keys.clear();
+    _values.clear();
+
+    std::vector<uint64_t> keys;
+    std::vector<uint32_t> values;
+    std::unordered_set<uint64_t> extended;
+    for (std::size_t i = 0; i < ids.size(); i++)
+    {
+        uint64_t id = ids[i];
+        if (id < max_standard_id)
+        {
+            if (_standard_table.empty())
+            {
+                _standard_table.resize(max_standard_id, npos);
+            }
+            if (!((_standard_bitmap[id / 64] >> (id % 64)) & 1))
+            {
+                _standard_bitmap[id / 64] |= 1ull << (id % 64);
+                _standard_table[id] = uint32_t(i);
+            }
+        }
+        else if (extended.insert(id).second)
+        {
+            keys.push_back(id);
+            values.push_back(uint32_t(i));
+        }
+    }
+    if (keys.empty())
+    {
+        return;
+    }
+    for (uint64_t salt = 0; !BuildPerfectHash(keys, values, salt); salt++);
+}
+bool MessageIdIndex::BuildPerfectHash(const std::vector<uint64_t>& keys, const std::vector<uint32_t>& values, uint64_t salt)
+{
+    constexpr uint64_t max_tries = 1 << 20;
+    const std::size_t n = keys.size();
+    const std::size_t n_buckets = n / 2 + 1;
+    std::vector<std::vector<std::size_t>> buckets(n_buckets);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        buckets[Hash(keys[i], salt) % n_buckets].push_back(i);
+    }
+    // place the big buckets first while there are still many free slots
+    std::vector<std::size_t> order(n_buckets);
+    for (std::size_t i = 0; i < n_buckets; i++)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+        [&](std::size_t lhs, std::size_t rhs) { return buckets[lhs].size() > buckets[rhs].size(); });
+
+    std::vector<uint64_t> seeds(n_buckets, 0);
+    std::vector<bool> taken(n, false);
+    std::vector<uint64_t> slots;
+    for (std::size_t b : order)
+    {
+        const auto& bucket = buckets[b];
+        if (bucket.empty())
+        {
+            break;
+        }
+        uint64_t seed = 1;
+        for (; seed < max_tries; seed++)
+        {
+            slots.clear();
+            for (std::size_t k : bucket)
+            {
+                uint64_t slot = Hash(keys[k], seed) % n;
+                if (taken[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end())
+                {
+                    break;
+                }
+                slots.push_back(slot);
+            }
+            if (slots.size() == bucket.size())
+            {
+                break;
+            }
+        }
+        if (seed == max_tries)
+        {
+            return false;
+        }
+        seeds[b] = seed;
+        for (uint64_t slot : slots)
+        {
+            taken[slot] = true;
+        }
+    }
+    _salt = salt;
+    _seeds = std::move(seeds);
+    _keys.assign(n, 0);
+    _values.assign(n, npos);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        uint64_t bucket = Hash(keys[i], _salt) % _seeds.size();
+        uint64_t slot = Hash(keys[i], _seeds[bucket]) % n;
+        _keys[slot] = keys[i];
+        _values[slot] = values[i];
+    }
+    return true;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+namespace dbcppp
+{
+    // Maps message ids to the position of the message in the network.
+    // Standard ids (< 2048) are looked up in a dense table guarded by a bitmap,
+    // all other ids through a minimal perfect hash (hash and displace).
+    class MessageIdIndex
+    {
+    public:
+        static constexpr uint32_t npos = uint32_t(-1);
+
+        MessageIdIndex();
+
+        // ids[i] is the id of the i-th message, for duplicated ids the first one wins
+        void Build(const std::vector<uint64_t>& ids);
+        inline uint32_t Find(uint64_t id) const noexcept
+        {
+            if (id < max_standard_id)
+            {
+                if (!((_standard_bitmap[id / 64] >> (id % 64)) & 1))
+                {
+                    return npos;
+                }
+                return _standard_table[id];
+            }
+            if (_keys.empty())
+            {
+                return npos;
+            }
+            uint64_t bucket = Hash(id, _salt) % _seeds.size();
+            uint64_t slot = Hash(id, _seeds[bucket]) % _keys.size();
+            return _keys[slot] == id ? _values[slot] : npos;
+        }
+
+    private:
+        static constexpr uint64_t max_standard_id = 2048;
+
+        static inline uint64_t Hash(uint64_t key, uint64_t seed) noexcept
+        {
+            // splitmix64 finalizer
+            key ^= seed * 0x9E3779B97F4A7C15ull;
+            key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull;
+            key = (key ^ (key >> 27)) * 0x94D049BB133111EBull;
+            return key ^ (key >> 31);
+        }
+        bool BuildPerfectHash(const std::vector<uint64_t>& keys, const std::vector<uint32_t>& values, uint64_t salt);
+
+        std::array<uint64_t, max_standard_id / 64> _standard_bitmap;
+        std::vector<uint32_t> _standard_table;
+
+        uint64_t _salt;
+        std::vector<uint64_t> _seeds;
+        std::vector<uint64_t> _keys;
+        std::vector<uint32_t> _values;
+    };
+}
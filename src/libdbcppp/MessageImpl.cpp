@@ -1,7 +1,36 @@
+#include <array>
+#include <limits>
+#include <cstring>
+#include <algorithm>
+#include "Helper.h"
 #include "MessageImpl.h"
 
 using namespace dbcppp;
 
+namespace
+{
+    // signals with extended multiplexing are not dispatched by the switch value
+    bool is_simple_mux_value(const ISignal& sig)
+    {
+        return sig.MultiplexerIndicator() == ISignal::EMultiplexer::MuxValue
+            && sig.SignalMultiplexerValues_Size() == 0;
+    }
+    std::vector<uint32_t> make_offsets(const std::vector<uint32_t>& slots, std::size_t n_slots)
+    {
+        std::vector<uint32_t> offsets(n_slots + 1, 0);
+        for (auto slot : slots)
+        {
+            offsets[slot]++;
+        }
+        uint32_t sum = 0;
+        for (auto& offset : offsets)
+        {
+            sum += offset;
+            offset = sum;
+        }
+        return offsets;
+    }
+}
 
 std::unique_ptr<IMessage> IMessage::Create(
       uint64_t id
@@ -83,8 +112,13 @@ MessageImpl::MessageImpl(
     {
         _error = EErrorCode::MuxValeWithoutMuxSignal;
     }
+    _extended_mux_graph.Build(_signals, _mux_signal);
+    BuildMuxTable();
+    BuildDecodeProgram();
+    BuildEncodeProgram();
 }
 MessageImpl::MessageImpl(const MessageImpl& other)
+    : _lazy_metadata(other._lazy_metadata)
 {
     _id = other._id;
     _name = other._name;
@@ -104,10 +138,20 @@ MessageImpl::MessageImpl(const MessageImpl& other)
             break;
         }
     }
+    _mux_switch_values = other._mux_switch_values;
+    _mux_dense_slots = other._mux_dense_slots;
+    _mux_value_indices = other._mux_value_indices;
+    _decode_program = other._decode_program;
+    _decode_offsets = other._decode_offsets;
+    _encode_program = other._encode_program;
+    _encode_offsets = other._encode_offsets;
+    _extended_mux_graph = other._extended_mux_graph;
+    _default_frame = other._default_frame;
     _error = other._error;
 }
 MessageImpl& MessageImpl::operator=(const MessageImpl& other)
 {
+    _lazy_metadata = other._lazy_metadata;
     _id = other._id;
     _name = other._name;
     _message_size = other._message_size;
@@ -126,6 +170,16 @@ MessageImpl& MessageImpl::operator=(const MessageImpl& other)
             break;
         }
     }
+    _mux_switch_values = other._mux_switch_values;
+    _mux_dense_slots = other._mux_dense_slots;
+    _mux_value_indices = other._mux_value_indices;
+    _decode_program = other._decode_program;
+    _decode_offsets = other._decode_offsets;
+    _encode_program = other._encode_program;
+    _encode_offsets = other._encode_offsets;
+    _extended_mux_graph = other._extended_mux_graph;
+    _default_frame = other._default_frame;
+    _signal_name_index.Reset();
     _error = other._error;
     return *this;
 }
@@ -167,14 +221,17 @@ uint64_t MessageImpl::Signals_Size() const
 }
 const IAttribute& MessageImpl::AttributeValues_Get(std::size_t i) const
 {
+    _lazy_metadata.Load();
     return _attribute_values[i];
 }
 uint64_t MessageImpl::AttributeValues_Size() const
 {
+    _lazy_metadata.Load();
     return _attribute_values.size();
 }
 const std::string& MessageImpl::Comment() const
 {
+    _lazy_metadata.Load();
     return _comment;
 }
 const ISignalGroup& MessageImpl::SignalGroups_Get(std::size_t i) const
@@ -189,6 +246,468 @@ const ISignal* MessageImpl::MuxSignal() const
 {
     return _mux_signal;
 }
+const ISignal* MessageImpl::SignalByName(std::string_view name) const
+{
+    uint32_t i = _signal_name_index.Find(_signals.size(), name,
+        [this](std::size_t i) -> std::string_view { return _signals[i].Name(); });
+    return i != NameIndex::npos ? &_signals[i] : nullptr;
+}
+void MessageImpl::BuildMuxTable()
+{
+    _mux_switch_values.clear();
+    _mux_dense_slots.clear();
+    _mux_value_indices.clear();
+    for (std::size_t i = 0; i < _signals.size(); i++)
+    {
+        if (is_simple_mux_value(_signals[i]))
+        {
+            _mux_switch_values.push_back(_signals[i].MultiplexerSwitchValue());
+            _mux_value_indices.push_back(uint32_t(i));
+        }
+    }
+    std::sort(_mux_switch_values.begin(), _mux_switch_values.end());
+    _mux_switch_values.erase(std::unique(_mux_switch_values.begin(), _mux_switch_values.end()), _mux_switch_values.end());
+    // small switch values are looked up directly, all others by binary search
+    constexpr uint64_t max_dense_switch_value = 4096;
+    if (!_mux_switch_values.empty() && _mux_switch_values.back() < max_dense_switch_value)
+    {
+        _mux_dense_slots.assign(_mux_switch_values.back() + 1, npos);
+        for (std::size_t slot = 0; slot < _mux_switch_values.size(); slot++)
+        {
+            _mux_dense_slots[_mux_switch_values[slot]] = uint32_t(slot);
+        }
+    }
+}
+uint32_t MessageImpl::MuxSlot(uint64_t switch_value) const noexcept
+{
+    if (!_mux_dense_slots.empty())
+    {
+        return switch_value < _mux_dense_slots.size() ? _mux_dense_slots[switch_value] : npos;
+    }
+    auto iter = std::lower_bound(_mux_switch_values.begin(), _mux_switch_values.end(), switch_value);
+    if (iter == _mux_switch_values.end() || *iter != switch_value)
+    {
+        return npos;
+    }
+    return uint32_t(iter - _mux_switch_values.begin());
+}
+uint32_t MessageImpl::ProgramSlot(const SignalImpl& sig) const noexcept
+{
+    // slot 0 holds the always active signals, slot n + 1 the signals of the n-th switch value
+    // and the last slot the signals with extended multiplexing
+    if (sig.SignalMultiplexerValues_Size() != 0)
+    {
+        return uint32_t(_mux_switch_values.size() + 1);
+    }
+    if (is_simple_mux_value(sig))
+    {
+        return MuxSlot(sig.MultiplexerSwitchValue()) + 1;
+    }
+    return 0;
+}
+void MessageImpl::BuildDecodeProgram()
+{
+    std::vector<std::pair<uint32_t, DecodeOp>> ops;
+    ops.reserve(_signals.size());
+    for (std::size_t i = 0; i < _signals.size(); i++)
+    {
+        const auto& sig = _signals[i];
+        DecodeOp op;
+        op.index = uint32_t(i);
+        op.mux_switch = &sig == _mux_signal;
+        op.factor = sig.Factor();
+        op.offset = sig.Offset();
+        bool identity = sig.Factor() == 1. && sig.Offset() == 0.;
+        if (sig.ExtendedValueType() != ISignal::EExtendedValueType::Integer)
+        {
+            op.conversion = EConversion::Extended;
+        }
+        else if (sig.ValueType() == ISignal::EValueType::Signed)
+        {
+            op.conversion = identity ? EConversion::SignedIdentity : EConversion::Signed;
+        }
+        else
+        {
+            op.conversion = identity ? EConversion::UnsignedIdentity : EConversion::Unsigned;
+        }
+        ops.emplace_back(ProgramSlot(sig), op);
+    }
+    // the mux switch has to be decoded before any mux value, the rest is ordered by
+    // the position in the frame to keep the memory accesses linear, except for the
+    // signals with extended multiplexing which are looked up by their ordinal
+    const uint32_t extended_slot = uint32_t(_mux_switch_values.size() + 1);
+    std::stable_sort(ops.begin(), ops.end(),
+        [&](const auto& lhs, const auto& rhs)
+        {
+            if (lhs.first != rhs.first)
+            {
+                return lhs.first < rhs.first;
+            }
+            if (lhs.first == extended_slot)
+            {
+                return false;
+            }
+            if (lhs.second.mux_switch != rhs.second.mux_switch)
+            {
+                return lhs.second.mux_switch;
+            }
+            return _signals[lhs.second.index].BytePos() < _signals[rhs.second.index].BytePos();
+        });
+    std::vector<uint32_t> slots;
+    _decode_program.clear();
+    _decode_program.reserve(ops.size());
+    for (const auto& [slot, op] : ops)
+    {
+        slots.push_back(slot);
+        _decode_program.push_back(op);
+    }
+    _decode_offsets = make_offsets(slots, _mux_switch_values.size() + 1);
+}
+void MessageImpl::BuildEncodeProgram()
+{
+    // The frame is viewed as a sequence of 64 bit words. Little endian signals occupy a continuous range of
+    // bits when the words are read as little endian integers, big endian signals when they are read as
+    // big endian integers. So every signal can be placed with one or two shifts of the masked raw value.
+    uint64_t frame_bits = std::max<uint64_t>(_message_size, 8) * 8;
+    std::vector<std::pair<uint32_t, EncodeOp>> ops;
+    ops.reserve(_signals.size());
+    for (std::size_t i = 0; i < _signals.size(); i++)
+    {
+        const auto& sig = _signals[i];
+        EncodeOp op;
+        op.index = uint32_t(i);
+        op.big_endian = sig.ByteOrder() == ISignal::EByteOrder::BigEndian;
+        op.factor = sig.Factor();
+        op.offset = sig.Offset();
+        bool identity = sig.Factor() == 1. && sig.Offset() == 0.;
+        if (sig.ExtendedValueType() != ISignal::EExtendedValueType::Integer)
+        {
+            op.conversion = EConversion::Extended;
+        }
+        else if (sig.ValueType() == ISignal::EValueType::Signed)
+        {
+            op.conversion = identity ? EConversion::SignedIdentity : EConversion::Signed;
+        }
+        else
+        {
+            op.conversion = identity ? EConversion::UnsignedIdentity : EConversion::Unsigned;
+        }
+        // invalid signals keep their op without parts, so that the ops of a slot map one to one to the signals
+        if (sig.BitSize() == 0 || sig.BitSize() > 64)
+        {
+            op.n_parts = 0;
+            op.mask = 0;
+            ops.emplace_back(ProgramSlot(sig), op);
+            continue;
+        }
+        op.mask = (1ull << (sig.BitSize() - 1ull) << 1ull) - 1;
+        uint64_t first;
+        uint64_t last;
+        // the word and shifts of the parts, their clear masks are filled in below
+        if (op.big_endian)
+        {
+            // bit positions counted from the most significant bit of the first byte
+            first = (sig.StartBit() / 8) * 8 + (7 - sig.StartBit() % 8);
+            last = first + sig.BitSize() - 1;
+            if (first / 64 == last / 64)
+            {
+                op.n_parts = 1;
+                op.parts[0] = {uint32_t(first / 64), uint8_t(63 - last % 64), 0, 0, 0, 0};
+            }
+            else
+            {
+                op.n_parts = 2;
+                op.parts[0] = {uint32_t(first / 64), 0, uint8_t(last % 64 + 1), 0, 0, 0};
+                op.parts[1] = {uint32_t(last / 64), uint8_t(63 - last % 64), 0, 0, 0, 0};
+            }
+        }
+        else
+        {
+            first = sig.StartBit();
+            last = first + sig.BitSize() - 1;
+            op.n_parts = 1;
+            op.parts[0] = {uint32_t(first / 64), uint8_t(first % 64), 0, 0, 0, 0};
+            if (first / 64 != last / 64)
+            {
+                op.n_parts = 2;
+                op.parts[1] = {uint32_t(last / 64), 0, uint8_t(64 - first % 64), 0, 0, 0};
+            }
+        }
+        frame_bits = std::max(frame_bits, last + 1);
+        for (std::size_t j = 0; j < op.n_parts; j++)
+        {
+            auto& part = op.parts[j];
+            part.clear = (op.mask << part.left_shift) >> part.right_shift;
+            if (op.big_endian)
+            {
+                big_to_native_inplace(part.clear);
+            }
+            else
+            {
+                little_to_native_inplace(part.clear);
+            }
+            part.le_clear = part.clear;
+            part.be_clear = part.clear;
+            native_to_little_inplace(part.le_clear);
+            native_to_big_inplace(part.be_clear);
+        }
+        ops.emplace_back(ProgramSlot(sig), op);
+    }
+    // within a slot the ops stay in the order of the signals
+    std::stable_sort(ops.begin(), ops.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    std::vector<uint32_t> slots;
+    _encode_program.clear();
+    _encode_program.reserve(ops.size());
+    for (const auto& [slot, op] : ops)
+    {
+        slots.push_back(slot);
+        _encode_program.push_back(op);
+    }
+    _encode_offsets = make_offsets(slots, _mux_switch_values.size() + 1);
+
+    // build the default frame, multiplexed signals are left out since their start values would overlap
+    std::vector<uint8_t> image((frame_bits + 63) / 64 * 8 + 8, 0);
+    for (const auto& sig : _signals)
+    {
+        if (sig.MultiplexerIndicator() == ISignal::EMultiplexer::MuxValue)
+        {
+            continue;
+        }
+        auto iter = std::find_if(sig.AttributeValues().begin(), sig.AttributeValues().end(),
+            [](const IAttribute& attr) { return attr.Name() == "GenSigStartValue"; });
+        if (iter == sig.AttributeValues().end())
+        {
+            continue;
+        }
+        ISignal::raw_t raw = 0;
+        if (auto v = boost::get<int64_t>(&iter->Value()))
+        {
+            raw = ISignal::raw_t(*v);
+        }
+        else if (auto v = boost::get<double>(&iter->Value()))
+        {
+            raw = ISignal::raw_t(int64_t(*v));
+        }
+        sig.Encode(raw, &image[0]);
+    }
+    _default_frame.resize((frame_bits + 63) / 64);
+    std::memcpy(&_default_frame[0], &image[0], _default_frame.size() * 8);
+}
+template <class F>
+void MessageImpl::ForEachActiveEncodeOp(uint64_t switch_value, const uint8_t* extended_active, F&& f) const
+{
+    // merge the always active ops, the ops of the active slot and the active ops with extended
+    // multiplexing, all three ranges are ordered by signal index
+    const EncodeOp* program = _encode_program.data();
+    const EncodeOp* op = program;
+    const EncodeOp* op_end = program + _encode_offsets[0];
+    const EncodeOp* mux_op = op_end;
+    const EncodeOp* mux_op_end = op_end;
+    uint32_t slot = MuxSlot(switch_value);
+    if (slot != npos)
+    {
+        mux_op = program + _encode_offsets[slot];
+        mux_op_end = program + _encode_offsets[slot + 1];
+    }
+    const std::size_t extended_slot = _mux_switch_values.size();
+    const EncodeOp* ext_begin = program + _encode_offsets[extended_slot];
+    const EncodeOp* ext_op = ext_begin;
+    const EncodeOp* ext_op_end = program + _encode_offsets[extended_slot + 1];
+    auto skip_inactive =
+        [&]()
+        {
+            while (ext_op != ext_op_end && !extended_active[ext_op - ext_begin])
+            {
+                ++ext_op;
+            }
+        };
+    skip_inactive();
+    constexpr uint32_t end = uint32_t(-1);
+    while (true)
+    {
+        uint32_t i0 = op != op_end ? op->index : end;
+        uint32_t i1 = mux_op != mux_op_end ? mux_op->index : end;
+        uint32_t i2 = ext_op != ext_op_end ? ext_op->index : end;
+        if (i0 < i1 && i0 < i2)
+        {
+            f(*op++);
+        }
+        else if (i1 < i2)
+        {
+            f(*mux_op++);
+        }
+        else if (i2 != end)
+        {
+            f(*ext_op++);
+            skip_inactive();
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+void MessageImpl::EncodeAll(std::span<const double> phys, void* frame) const
+{
+    constexpr std::size_t max_words = 9;
+    std::array<uint64_t, max_words> small_words[3];
+    std::vector<uint64_t> big_words;
+    uint64_t* le_words = small_words[0].data();
+    uint64_t* be_words = small_words[1].data();
+    uint64_t* clear_words = small_words[2].data();
+    const std::size_t n_words = _default_frame.size();
+    if (n_words > max_words)
+    {
+        big_words.resize(n_words * 3);
+        le_words = &big_words[0];
+        be_words = &big_words[n_words];
+        clear_words = &big_words[2 * n_words];
+    }
+    std::fill_n(le_words, n_words, 0);
+    std::fill_n(be_words, n_words, 0);
+    std::fill_n(clear_words, n_words, 0);
+
+    uint64_t switch_value = 0;
+    if (_mux_signal)
+    {
+        switch_value = _mux_signal->PhysToRaw(phys[static_cast<const SignalImpl*>(_mux_signal) - _signals.data()]);
+    }
+    auto encode = [&](const EncodeOp& op)
+    {
+        double p = phys[op.index];
+        ISignal::raw_t raw;
+        switch (op.conversion)
+        {
+        case EConversion::Unsigned:         raw = ISignal::raw_t(uint64_t((p - op.offset) / op.factor)); break;
+        case EConversion::Signed:           raw = ISignal::raw_t(int64_t((p - op.offset) / op.factor)); break;
+        case EConversion::UnsignedIdentity: raw = ISignal::raw_t(uint64_t(p)); break;
+        case EConversion::SignedIdentity:   raw = ISignal::raw_t(int64_t(p)); break;
+        default:                            raw = _signals[op.index].PhysToRaw(p); break;
+        }
+        raw &= op.mask;
+        uint64_t* words = op.big_endian ? be_words : le_words;
+        for (std::size_t j = 0; j < op.n_parts; j++)
+        {
+            // clear the bits in both images so that overlapping signals behave like consecutive Encode calls
+            const auto& part = op.parts[j];
+            le_words[part.word] &= ~part.le_clear;
+            be_words[part.word] &= ~part.be_clear;
+            words[part.word] |= (raw << part.left_shift) >> part.right_shift;
+            clear_words[part.word] |= part.clear;
+        }
+    };
+    _extended_mux_graph.Evaluate(
+        [&](uint32_t i) { return _signals[i].PhysToRaw(phys[i]); },
+        [&](const uint8_t* extended_active) { ForEachActiveEncodeOp(switch_value, extended_active, encode); });
+    for (std::size_t i = 0; i < n_words; i++)
+    {
+        uint64_t le = le_words[i];
+        uint64_t be = be_words[i];
+        little_to_native_inplace(le);
+        big_to_native_inplace(be);
+        le_words[i] = (_default_frame[i] & ~clear_words[i]) | le | be;
+    }
+    std::memcpy(frame, le_words, _message_size);
+}
+void MessageImpl::DecodeAll(const void* bytes, std::span<ISignal::raw_t> raw, std::span<double> phys) const noexcept
+{
+    const bool convert = !phys.empty();
+    uint64_t switch_value = 0;
+    auto decode = [&](const DecodeOp& op)
+    {
+        const SignalImpl& sig = _signals[op.index];
+        ISignal::raw_t r = sig.Decode(bytes);
+        raw[op.index] = r;
+        if (op.mux_switch)
+        {
+            switch_value = r;
+        }
+        if (!convert)
+        {
+            return;
+        }
+        switch (op.conversion)
+        {
+        case EConversion::Unsigned:         phys[op.index] = double(r) * op.factor + op.offset; break;
+        case EConversion::Signed:           phys[op.index] = double(int64_t(r)) * op.factor + op.offset; break;
+        case EConversion::UnsignedIdentity: phys[op.index] = double(r); break;
+        case EConversion::SignedIdentity:   phys[op.index] = double(int64_t(r)); break;
+        case EConversion::Extended:         phys[op.index] = sig.RawToPhys(r); break;
+        }
+    };
+    const DecodeOp* op = _decode_program.data();
+    const DecodeOp* op_end = op + _decode_offsets[0];
+    for (; op != op_end; ++op)
+    {
+        decode(*op);
+    }
+    if (!_mux_value_indices.empty())
+    {
+        // touches the multiplexed signals of all switch values, see the note on the cost at IMessage::DecodeAll
+        if (convert)
+        {
+            for (auto i : _mux_value_indices)
+            {
+                phys[i] = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+        uint32_t slot = MuxSlot(switch_value);
+        if (slot != npos)
+        {
+            op = _decode_program.data() + _decode_offsets[slot];
+            op_end = _decode_program.data() + _decode_offsets[slot + 1];
+            for (; op != op_end; ++op)
+            {
+                decode(*op);
+            }
+        }
+    }
+    if (_extended_mux_graph.Size() != 0)
+    {
+        _extended_mux_graph.Evaluate(
+            [&](uint32_t i) { return _signals[i].Decode(bytes); },
+            [&](const uint8_t* extended_active)
+            {
+                const DecodeOp* ext_begin = _decode_program.data() + _decode_offsets[_mux_switch_values.size()];
+                const DecodeOp* ext_end = _decode_program.data() + _decode_offsets[_mux_switch_values.size() + 1];
+                for (const DecodeOp* ext = ext_begin; ext != ext_end; ++ext)
+                {
+                    if (extended_active[ext - ext_begin])
+                    {
+                        decode(*ext);
+                    }
+                    else if (convert)
+                    {
+                        phys[ext->index] = std::numeric_limits<double>::quiet_NaN();
+                    }
+                }
+            });
+    }
+}
+std::size_t MessageImpl::ActiveSignals(const void* bytes, std::span<std::size_t> active) const noexcept
+{
+    uint64_t switch_value = _mux_signal ? _mux_signal->Decode(bytes) : 0;
+    std::size_t n = 0;
+    _extended_mux_graph.Evaluate(
+        [&](uint32_t i) { return _signals[i].Decode(bytes); },
+        [&](const uint8_t* extended_active)
+        {
+            ForEachActiveEncodeOp(switch_value, extended_active,
+                [&](const EncodeOp& op)
+                {
+                    active[n++] = op.index;
+                });
+        });
+    return n;
+}
+void MessageImpl::DecodeColumns(const uint8_t* frames, std::size_t stride, std::size_t n, ISignal::raw_t* columns) const noexcept
+{
+    for (const auto& op : _decode_program)
+    {
+        _signals[op.index].DecodeColumn(frames, stride, n, columns + op.index * n);
+    }
+}
 MessageImpl::EErrorCode MessageImpl::Error() const
 {
     return _error;
@@ -198,8 +717,13 @@ const std::vector<SignalImpl>& MessageImpl::signals() const
 {
     return _signals;
 }
+const ExtendedMuxGraph& MessageImpl::extended_mux_graph() const
+{
+    return _extended_mux_graph;
+}
 bool MessageImpl::operator==(const IMessage& rhs) const
 {
+    _lazy_metadata.Load();
     bool equal = true;
     equal &= _id == rhs.Id();
     equal &= _name == rhs.Name();
@@ -234,4 +758,24 @@ bool MessageImpl::operator==(const IMessage& rhs) const
 bool MessageImpl::operator!=(const IMessage& rhs) const
 {
     return !(*this == rhs);
-}
\ No newline at end of file
+}
+std::string& MessageImpl::comment()
+{
+    return _comment;
+}
+std::vector<AttributeImpl>& MessageImpl::attributeValues()
+{
+    return _attribute_values;
+}
+std::vector<SignalImpl>& MessageImpl::signals()
+{
+    return _signals;
+}
+void MessageImpl::SetLazyMetadata(const LazyMetadata* lazy)
+{
+    _lazy_metadata.Set(lazy);
+    for (auto& sig : _signals)
+    {
+        sig.SetLazyMetadata(lazy);
+    }
+}
@@ -4,7 +4,10 @@
 #include "SignalImpl.h"
 #include "NodeImpl.h"
 #include "AttributeImpl.h"
+#include "LazyMetadata.h"
 #include "SignalGroupImpl.h"
+#include "ExtendedMuxGraph.h"
+#include "NameIndex.h"
 
 namespace dbcppp
 {
@@ -43,15 +46,80 @@ namespace dbcppp
         virtual const ISignalGroup& SignalGroups_Get(std::size_t i) const override;
         virtual uint64_t SignalGroups_Size() const override;
         virtual const ISignal* MuxSignal() const override;
+        virtual const ISignal* SignalByName(std::string_view name) const override;
+
+        virtual void DecodeAll(const void* bytes, std::span<ISignal::raw_t> raw, std::span<double> phys) const noexcept override;
+        virtual void DecodeColumns(const uint8_t* frames, std::size_t stride, std::size_t n, ISignal::raw_t* columns) const noexcept override;
+        virtual void EncodeAll(std::span<const double> phys, void* frame) const override;
+        virtual std::size_t ActiveSignals(const void* bytes, std::span<std::size_t> active) const noexcept override;
         
         virtual EErrorCode Error() const override;
         
         const std::vector<SignalImpl>& signals() const;
+        const ExtendedMuxGraph& extended_mux_graph() const;
         
         virtual bool operator==(const IMessage& rhs) const override;
         virtual bool operator!=(const IMessage& rhs) const override;
+
+        // don't load the lazy metadata, used to move it in
+        std::string& comment();
+        std::vector<AttributeImpl>& attributeValues();
+        std::vector<SignalImpl>& signals();
+        // of the message and its signals
+        void SetLazyMetadata(const LazyMetadata* lazy);
         
     private:
+        enum class EConversion
+            : uint8_t
+        {
+            Unsigned,
+            Signed,
+            UnsignedIdentity,
+            SignedIdentity,
+            Extended
+        };
+        // one instruction of the decode program
+        struct DecodeOp
+        {
+            uint32_t index;
+            EConversion conversion;
+            bool mux_switch;
+            double factor;
+            double offset;
+        };
+        // one instruction of the encode program, a signal is placed into at most two 64 bit words
+        struct EncodeOp
+        {
+            struct Part
+            {
+                uint32_t word;
+                uint8_t left_shift;
+                uint8_t right_shift;
+                // the bits of the part when the word is read as little endian, big endian and native integer
+                uint64_t le_clear;
+                uint64_t be_clear;
+                uint64_t clear;
+            };
+            uint32_t index;
+            EConversion conversion;
+            bool big_endian;
+            uint8_t n_parts;
+            Part parts[2];
+            uint64_t mask;
+            double factor;
+            double offset;
+        };
+        static constexpr uint32_t npos = uint32_t(-1);
+
+        void BuildMuxTable();
+        void BuildDecodeProgram();
+        void BuildEncodeProgram();
+        uint32_t MuxSlot(uint64_t switch_value) const noexcept;
+        uint32_t ProgramSlot(const SignalImpl& sig) const noexcept;
+        template <class F>
+        void ForEachActiveEncodeOp(uint64_t switch_value, const uint8_t* extended_active, F&& f) const;
+
+        LazyMetadataRef _lazy_metadata;
         uint64_t _id;
         std::string _name;
         uint64_t _message_size;
@@ -63,6 +131,20 @@ namespace dbcppp
         std::vector<SignalGroupImpl> _signal_groups;
 
         const ISignal* _mux_signal;
+        // dispatch table of the simple multiplexing: every distinct switch value gets a slot, the programs
+        // start with the ops of the always active signals followed by the ops of every slot and the
+        // ops of the signals with extended multiplexing
+        std::vector<uint64_t> _mux_switch_values;
+        std::vector<uint32_t> _mux_dense_slots;
+        std::vector<uint32_t> _mux_value_indices;
+        std::vector<DecodeOp> _decode_program;
+        std::vector<uint32_t> _decode_offsets;
+        std::vector<EncodeOp> _encode_program;
+        std::vector<uint32_t> _encode_offsets;
+        ExtendedMuxGraph _extended_mux_graph;
+        LazyNameIndex _signal_name_index;
+        // default frame image built from the GenSigStartValue attributes
+        std::vector<uint64_t> _default_frame;
 
         EErrorCode _error;
     };
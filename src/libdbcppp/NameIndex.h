@@ -0,0 +1,111 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <functional>
+
+#include "Lazy.h"
+
+namespace dbcppp
+{
+    // Maps names to the position of the named object in a container. The names themselves aren't stored,
+    // they are compared through get_name(position), so the index is valid as long as the container isn't
+    // modified. Flat open addressing table with linear probing and precomputed hashes.
+    class NameIndex
+    {
+    public:
+        static constexpr uint32_t npos = uint32_t(-1);
+
+        // for duplicated names the first one wins
+        template <class GetName>
+        void Build(std::size_t n, GetName&& get_name)
+        {
+            if (n == 0)
+            {
+                _slots.clear();
+                return;
+            }
+            std::size_t capacity = 8;
+            while (capacity < n * 2)
+            {
+                capacity *= 2;
+            }
+            _slots.assign(capacity, Slot{0, npos});
+            const std::size_t mask = capacity - 1;
+            for (std::size_t i = 0; i < n; i++)
+            {
+                std::string_view name = get_name(i);
+                uint64_t hash = Hash(name);
+                for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask)
+                {
+                    if (_slots[slot].value == npos)
+                    {
+                        _slots[slot] = Slot{hash, uint32_t(i)};
+                        break;
+                    }
+                    if (_slots[slot].hash == hash && get_name(_slots[slot].value) == name)
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+        template <class GetName>
+        uint32_t Find(std::string_view name, GetName&& get_name) const
+        {
+            if (_slots.empty())
+            {
+                return npos;
+            }
+            const std::size_t mask = _slots.size() - 1;
+            uint64_t hash = Hash(name);
+            for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask)
+            {
+                const Slot& s = _slots[slot];
+                if (s.value == npos)
+                {
+                    return npos;
+                }
+                if (s.hash == hash && get_name(s.value) == name)
+                {
+                    return s.value;
+                }
+            }
+        }
+
+    private:
+        struct Slot
+        {
+            uint64_t hash;
+            uint32_t value;
+        };
+
+        static inline uint64_t Hash(std::string_view name) noexcept
+        {
+            return std::hash<std::string_view>{}(name);
+        }
+
+        std::vector<Slot> _slots;
+    };
+
+    // NameIndex which is built thread safe on the first lookup, copies and moves start with an empty index
+    class LazyNameIndex
+    {
+    public:
+        // has to be called after the container has been modified, not thread safe
+        void Reset()
+        {
+            _index.Reset();
+        }
+        template <class GetName>
+        uint32_t Find(std::size_t n, std::string_view name, GetName&& get_name) const
+        {
+            const NameIndex& index = _index.Get([&](NameIndex& index) { index.Build(n, get_name); });
+            return index.Find(name, get_name);
+        }
+
+    private:
+        Lazy<NameIndex> _index;
+    };
+}
@@ -1,568 +1,803 @@
+#include <thread>
+#include <sstream>
+#include <charconv>
+#include <optional>
+#include <concepts>
+#include <algorithm>
+#include <exception>
+#include <functional>
 #include "../../include/dbcppp/Network2Functions.h"
+#include "Helper.h"
 #include "NetworkImpl.h"
 
 using namespace dbcppp;
 using namespace dbcppp::Network2DBC;
 
-DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const na_t& na)
+namespace
 {
-    const auto& net = std::get<0>(na);
-    const auto& iattr = std::get<1>(na);
-    struct Visitor
-    {
-        Visitor(std::ostream& os)
+    // Formats like the std::ostream it's created for into a buffer. Numbers are formatted with std::to_chars if
+    // the stream uses the default formatting, which produces the same output as the stream in that case.
+    class DBCWriter
+    {
+    public:
+        // the buffer is written to sink whenever it gets bigger than flush_size if there is a sink, otherwise it
+        // holds everything written, os has to outlive the writer
+        DBCWriter(const std::ostream& os, std::ostream* sink)
             : _os(os)
-        {}
-        void operator()(int64_t i) const
+            , _sink(sink)
+            , _precision(int(os.precision()))
         {
-            _os << " " << i;
+            constexpr auto non_default = std::ios::floatfield | std::ios::showpos | std::ios::showpoint | std::ios::uppercase;
+            const auto base = os.flags() & std::ios::basefield;
+            _default_format =
+                !(os.flags() & non_default) && (base == std::ios::dec || !base) &&
+                _precision >= 0 && os.getloc() == std::locale::classic();
         }
-        void operator()(double d) const
+
+        DBCWriter& operator<<(std::string_view str)
         {
-            _os << " " << d;
+            _buffer.append(str);
+            if (_sink && _buffer.size() > flush_size)
+            {
+                Flush();
+            }
+            return *this;
         }
-        void operator()(const std::string& s) const
+        DBCWriter& operator<<(const char* str)
         {
-            _os << " \"" << s << "\"";
+            return *this << std::string_view(str);
         }
-
-        std::ostream& _os;
-    };
-    std::string cmd = "BA_";
-    {
-        auto beg = net.AttributeDefaults().begin();
-        auto end = net.AttributeDefaults().end();
-        if (std::find_if(beg, end, [&](const IAttribute& attr) { return &attr == &iattr; }) != end)
+        DBCWriter& operator<<(const std::string& str)
         {
-            cmd = "BA_DEF_DEF_";
+            return *this << std::string_view(str);
         }
-    }
-    os << cmd << " \"" << iattr.Name() << "\"";
-    switch (iattr.ObjectType())
-    {
-    case IAttributeDefinition::EObjectType::Network:
-    {
-        boost::apply_visitor(Visitor(os), iattr.Value());
-        break;
-    }
-    case IAttributeDefinition::EObjectType::Node:
-    {
-        auto find_node_name =
-            [&]()
+        DBCWriter& operator<<(char c)
+        {
+            return *this << std::string_view(&c, 1);
+        }
+        template <std::integral T>
+        DBCWriter& operator<<(T value)
+        {
+            if (!_default_format)
             {
-                auto beg_node = net.Nodes().begin();
-                auto end_node = net.Nodes().end();
-                auto iter = std::find_if(beg_node, end_node,
-                    [&](const INode& n)
-                    {
-                        auto beg_attr = n.AttributeValues().begin();
-                        auto end_attr = n.AttributeValues().end();
-                        auto iter = std::find_if(beg_attr, end_attr, [&](const IAttribute& other) { return &other == &iattr; });
-                        return iter != end_attr;
-                    });
-                return iter != end_node ? iter->Name() : "";
-            };
-        os << " BU_ " << find_node_name();
-        boost::apply_visitor(Visitor(os), iattr.Value());
-        break;
-    }
-    case IAttributeDefinition::EObjectType::Message:
-    {
-        auto find_message_id =
-            [&]()
+                return formatted(value);
+            }
+            char buffer[24];
+            auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            return *this << std::string_view(buffer, end - buffer);
+        }
+        DBCWriter& operator<<(double value)
+        {
+            if (_default_format)
             {
-                auto beg_msg = net.Messages().begin();
-                auto end_msg = net.Messages().end();
-                auto iter = std::find_if(beg_msg, end_msg,
-                    [&](const IMessage& msg)
-                    {
-                        auto beg_attr = msg.AttributeValues().begin();
-                        auto end_attr = msg.AttributeValues().end();
-                        auto iter = std::find_if(beg_attr, end_attr, [&](const IAttribute& other) { return &other == &iattr; });
-                        return iter != end_attr;
-                    });
-                return iter != end_msg ? iter->Id() : uint64_t(-1);
-            };
-        os << " BO_ " << find_message_id();
-        boost::apply_visitor(Visitor(os), iattr.Value());
-        break;
-    }
-    case IAttributeDefinition::EObjectType::Signal:
-    {
-        auto find_signal =
-            [&]() -> const ISignal*
-            {
-                const ISignal* osig = nullptr;
-                auto beg_msg = net.Messages().begin();
-                auto end_msg = net.Messages().end();
-                auto iter = std::find_if(beg_msg, end_msg,
-                    [&](const IMessage& msg)
-                    {
-                        auto beg_sig = msg.Signals().begin();
-                        auto end_sig = msg.Signals().end();
-                        auto iter = std::find_if(beg_sig, end_sig,
-                            [&](const ISignal& sig)
-                            {
-                                auto beg_attr = sig.AttributeValues().begin();
-                                auto end_attr = sig.AttributeValues().end();
-                                auto iter = std::find_if(beg_attr, end_attr, [&](const IAttribute& other) { return &other == &iattr; });
-                                if (iter != end_attr)
-                                {
-                                    osig = &sig;
-                                }
-                                return iter != end_attr;
-                            });
-                        return iter != end_sig;
-                    });
-                return osig;
-            };
-        const ISignal* sig = find_signal();
-        os << " SG_ " << net.ParentMessage(sig)->Id();
-        os << " " << sig->Name();
-        boost::apply_visitor(Visitor(os), iattr.Value());
-        break;
-    }
-    case IAttributeDefinition::EObjectType::EnvironmentVariable:
-    {
-        auto find_environment_variable_name =
-            [&]()
+                // the same as the printf("%.*g") a stream with the default formatting uses
+                char buffer[128];
+                auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::general, _precision);
+                if (ec == std::errc())
+                {
+                    return *this << std::string_view(buffer, end - buffer);
+                }
+            }
+            return formatted(value);
+        }
+
+        void Flush()
+        {
+            if (_sink)
             {
-                auto beg_env_var = net.EnvironmentVariables().begin();
-                auto end_env_var = net.EnvironmentVariables().end();
-                auto iter = std::find_if(beg_env_var, end_env_var,
-                    [&](const IEnvironmentVariable& ev)
-                    {
-                        auto beg_attr = ev.AttributeValues().begin();
-                        auto end_attr = ev.AttributeValues().end();
-                        auto iter = std::find_if(beg_attr, end_attr, [&](const IAttribute& other) { return &other == &iattr; });
-                        return iter != end_attr;
-                    });
-                return iter != end_env_var ? iter->Name() : "";
+                _sink->write(_buffer.data(), _buffer.size());
+                _buffer.clear();
+            }
+        }
+        const std::string& Buffer() const
+        {
+            return _buffer;
+        }
 
-            };
-        os << " EV_ " << find_environment_variable_name();
-        boost::apply_visitor(Visitor(os), iattr.Value());
-        break;
-    }
-    }
-    os << ";\n";
-    return os;
-}
-DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const IAttributeDefinition& ad)
-{
-    struct VisitorValueType
-    {
-        VisitorValueType(std::ostream& os)
-            : _os(os)
-        {}
-        void operator()(const IAttributeDefinition::ValueTypeInt& vt) const
+    private:
+        static constexpr std::size_t flush_size = 1 << 20;
+
+        template <class T>
+        DBCWriter& formatted(T value)
         {
-            _os << " INT" << " " << vt.minimum << " " << vt.maximum;
+            // the stream is only created for the values std::to_chars can't format
+            if (!_format)
+            {
+                _format.emplace();
+                _format->copyfmt(_os);
+                _format->exceptions(std::ios::goodbit);
+                _format->width(0);
+            }
+            _format->str({});
+            *_format << value;
+            return *this << _format->view();
         }
-        void operator()(const IAttributeDefinition::ValueTypeHex& vt) const
+
+        const std::ostream& _os;
+        std::ostream* _sink;
+        std::string _buffer;
+        int _precision;
+        bool _default_format;
+        std::optional<std::ostringstream> _format;
+    };
+
+    // scans the network for the owner of the attribute, for implementations of INetwork other than NetworkImpl
+    std::optional<NetworkRelations::AttributeOwner> scanAttributeOwner(const INetwork& net, const IAttribute& iattr)
+    {
+        using AttributeOwner = NetworkRelations::AttributeOwner;
+        using EOwner = AttributeOwner::EOwner;
+        constexpr uint32_t npos = NetworkRelations::npos;
+        auto contains =
+            [&](const auto& attributes)
+            {
+                for (const IAttribute& attr : attributes)
+                {
+                    if (&attr == &iattr)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            };
+        if (contains(net.AttributeValues()))
         {
-            _os << " HEX" << " " << vt.minimum << " " << vt.maximum;
+            return AttributeOwner{EOwner::Network, npos, npos};
         }
-        void operator()(const IAttributeDefinition::ValueTypeFloat& vt) const
+        if (contains(net.AttributeDefaults()))
         {
-            _os << " FLOAT" << " " << vt.minimum << " " << vt.maximum;
+            return AttributeOwner{EOwner::Default, npos, npos};
         }
-        void operator()(const IAttributeDefinition::ValueTypeString& vt) const
+        for (std::size_t i = 0; i < net.Nodes_Size(); i++)
         {
-            _os << " STRING";
+            if (contains(net.Nodes_Get(i).AttributeValues()))
+            {
+                return AttributeOwner{EOwner::Node, uint32_t(i), npos};
+            }
         }
-        void operator()(const IAttributeDefinition::ValueTypeEnum& vt) const
+        for (std::size_t i = 0; i < net.Messages_Size(); i++)
         {
-            _os << " ENUM";
-            const auto& values = vt.values;
-            if (values.size())
+            const IMessage& msg = net.Messages_Get(i);
+            if (contains(msg.AttributeValues()))
+            {
+                return AttributeOwner{EOwner::Message, uint32_t(i), npos};
+            }
+            for (std::size_t j = 0; j < msg.Signals_Size(); j++)
             {
-                auto iter = values.begin();
-                _os << " \"" << *iter << "\"";
-                for (iter++; iter != values.end(); iter++)
+                if (contains(msg.Signals_Get(j).AttributeValues()))
                 {
-                    _os << ", \"" << *iter << "\"";
+                    return AttributeOwner{EOwner::Signal, uint32_t(i), uint32_t(j)};
                 }
             }
         }
-
-    private:
-        std::ostream& _os;
-    };
-
-    std::string object_type = "";
-    switch (ad.ObjectType())
-    {
-    case IAttributeDefinition::EObjectType::Network: break;
-    case IAttributeDefinition::EObjectType::Node: object_type = "BU_"; break;
-    case IAttributeDefinition::EObjectType::Message: object_type = "BO_"; break;
-    case IAttributeDefinition::EObjectType::Signal: object_type = "SG_"; break;
-    case IAttributeDefinition::EObjectType::EnvironmentVariable: object_type = "EV_"; break;
-    }
-    os << "BA_DEF_ ";
-    if (object_type != "")
-    {
-        os << object_type << " ";
-    }
-    os << "\"" << ad.Name() << "\"";
-    std::visit(VisitorValueType(os), ad.ValueType());
-    os << ";\n";
-    return os;
-}
-DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const IBitTiming& bt)
-{
-    os << "BS_:";
-    if (bt.Baudrate() != 0 && bt.BTR1() != 0 && bt.BTR2() != 0)
-    {
-        os << " " << bt.Baudrate() << " : " << bt.BTR1() << ", " << bt.BTR2();
-    }
-    os << "\n";
-    return os;
-}
-DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const IEnvironmentVariable& ev)
-{
-    os << "EV_ " << ev.Name() << ": ";
-    switch (ev.VarType())
-    {
-    case IEnvironmentVariable::EVarType::Integer: os << "0"; break;
-    case IEnvironmentVariable::EVarType::Float: os << "1"; break;
-    case IEnvironmentVariable::EVarType::String: os << "2"; break;
-    case IEnvironmentVariable::EVarType::Data: os << "0"; break;
-    }
-    os << " [" << ev.Minimum() << "|" << ev.Maximum() << "]" << " \"" << ev.Unit() << "\" "
-        << ev.InitialValue() << " " << ev.EvId() << " ";
-    switch (ev.AccessType())
-    {
-    case IEnvironmentVariable::EAccessType::Unrestricted: os << "DUMMY_NODE_VECTOR0"; break;
-    case IEnvironmentVariable::EAccessType::Read: os << "DUMMY_NODE_VECTOR1"; break;
-    case IEnvironmentVariable::EAccessType::Write: os << "DUMMY_NODE_VECTOR2"; break;
-    case IEnvironmentVariable::EAccessType::ReadWrite: os << "DUMMY_NODE_VECTOR3"; break;
-    case IEnvironmentVariable::EAccessType::Unrestricted_: os << "DUMMY_NODE_VECTOR8000"; break;
-    case IEnvironmentVariable::EAccessType::Read_: os << "DUMMY_NODE_VECTOR8001"; break;
-    case IEnvironmentVariable::EAccessType::Write_: os << "DUMMY_NODE_VECTOR8002"; break;
-    case IEnvironmentVariable::EAccessType::ReadWrite_: os << "DUMMY_NODE_VECTOR8003"; break;
+        for (std::size_t i = 0; i < net.EnvironmentVariables_Size(); i++)
+        {
+            if (contains(net.EnvironmentVariables_Get(i).AttributeValues()))
+            {
+                return AttributeOwner{EOwner::EnvironmentVariable, uint32_t(i), npos};
+            }
+        }
+        return std::nullopt;
     }
-    bool first = true;
-    for (const std::string& n : ev.AccessNodes())
+    void writeAttribute(DBCWriter& os, const INetwork& net, const IAttribute& iattr)
     {
-        if (first)
+        struct Visitor
         {
-            os << " " << n;
-            first = false;
+            Visitor(DBCWriter& os)
+                : _os(os)
+            {}
+            void operator()(int64_t i) const
+            {
+                _os << " " << i;
+            }
+            void operator()(double d) const
+            {
+                _os << " " << d;
+            }
+            void operator()(const std::string& s) const
+            {
+                _os << " \"" << s << "\"";
+            }
+
+            DBCWriter& _os;
+        };
+        using EOwner = NetworkRelations::AttributeOwner::EOwner;
+        std::optional<NetworkRelations::AttributeOwner> scanned;
+        const NetworkRelations::AttributeOwner* owner;
+        if (const auto* neti = dynamic_cast<const NetworkImpl*>(&net))
+        {
+            owner = neti->Relations().FindAttributeOwner(&iattr);
         }
         else
         {
-            os << ", " << n;
+            scanned = scanAttributeOwner(net, iattr);
+            owner = scanned ? &*scanned : nullptr;
         }
-    }
-    os << ";\n";
-    return os;
-}
-DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const IMessage& m)
-{
-    os << "BO_ " << m.Id() << " " << m.Name() << ": " << m.MessageSize() << " " << m.Transmitter() << "\n";
-    for (const ISignal& s : m.Signals())
-    {
-        os << s;
-    };
-    return os;
-}
-DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const INetwork& net)
-{
-    os << "VERSION \"";
-    if (net.Version() != "")
-    {
-        os << net.Version();
-    }
-    os << "\"\n";
-    os << "NS_:\n";
-    for (const std::string& ns : net.NewSymbols())
-    {
-        os << "\t" << ns << "\n";
-    };
-    os << net.BitTiming();
-    os << "BU_:";
-    for (const INode& n : net.Nodes())
-    {
-            os << " " << n.Name(); 
-    }
-    os << "\n";
-    for (const IValueTable& vt : net.ValueTables())
-    {
-            os << vt;
-    }
-    for (const IMessage& m : net.Messages())
-    {
-        os << m;
-    }
-    for (const IMessage& m : net.Messages())
-    {
-        if (m.MessageTransmitters_Size())
-        {
-            const std::string& n = m.MessageTransmitters_Get(0);
-            os << "BO_TX_BU_ " << m.Id() << " :";
-            os << " " << n;
-            for (std::size_t i = 1; i < m.MessageTransmitters_Size(); i++)
+        auto owned_by =
+            [&](EOwner type)
             {
-                const std::string& n = m.MessageTransmitters_Get(i);
-                os << ", " << n;
-            }
-            os << ";\n";
+                return owner && owner->owner == type;
+            };
+        os << (owned_by(EOwner::Default) ? "BA_DEF_DEF_" : "BA_") << " \"" << iattr.Name() << "\"";
+        switch (iattr.ObjectType())
+        {
+        case IAttributeDefinition::EObjectType::Network:
+        {
+            boost::apply_visitor(Visitor(os), iattr.Value());
+            break;
         }
-    }
-    for (const IEnvironmentVariable& ev : net.EnvironmentVariables())
-    {
-        os << ev;
-    }
-    for (const IEnvironmentVariable& ev : net.EnvironmentVariables())
-    {
-        if (ev.VarType() == IEnvironmentVariable::EVarType::Data)
+        case IAttributeDefinition::EObjectType::Node:
         {
-            os << "ENVVAR_DATA_ " << ev.Name() << " : " << ev.DataSize() << ";\n";
+            os << " BU_ " << (owned_by(EOwner::Node) ? net.Nodes_Get(owner->index).Name() : "");
+            boost::apply_visitor(Visitor(os), iattr.Value());
+            break;
         }
-    }
-    for (const IValueTable& vt : net.ValueTables())
-    {
-        if (vt.SignalType())
+        case IAttributeDefinition::EObjectType::Message:
         {
-            os << vt;
+            os << " BO_ " << (owned_by(EOwner::Message) ? net.Messages_Get(owner->index).Id() : uint64_t(-1));
+            boost::apply_visitor(Visitor(os), iattr.Value());
+            break;
         }
-    }
-    if (net.Comment() != "")
-    {
-        os << "CM_ \"" << net.Comment() << "\";\n";
-    }
-    for (const INode& n : net.Nodes())
-    {
-        if (n.Comment() != "")
+        case IAttributeDefinition::EObjectType::Signal:
         {
-            os << "CM_ BU_ " << n.Name() << " \"" << n.Comment() << "\"" << ";\n";
+            if (owned_by(EOwner::Signal))
+            {
+                const IMessage& msg = net.Messages_Get(owner->index);
+                os << " SG_ " << msg.Id();
+                os << " " << msg.Signals_Get(owner->sub_index).Name();
+            }
+            boost::apply_visitor(Visitor(os), iattr.Value());
+            break;
         }
-    }
-    for (const IMessage& m : net.Messages())
-    {
-        if (m.Comment() != "")
+        case IAttributeDefinition::EObjectType::EnvironmentVariable:
         {
-            os << "CM_ BO_ " << m.Id() << " \"" << m.Comment() << "\"" << ";\n";
+            os << " EV_ " << (owned_by(EOwner::EnvironmentVariable) ? net.EnvironmentVariables_Get(owner->index).Name() : "");
+            boost::apply_visitor(Visitor(os), iattr.Value());
+            break;
+        }
         }
+        os << ";\n";
     }
-    for (const IMessage& m : net.Messages())
+    void writeAttributeDefinition(DBCWriter& os, const IAttributeDefinition& ad)
     {
-        for (const ISignal& s : m.Signals())
+        struct VisitorValueType
         {
-            if (s.Comment() != "")
+            VisitorValueType(DBCWriter& os)
+                : _os(os)
+            {}
+            void operator()(const IAttributeDefinition::ValueTypeInt& vt) const
+            {
+                _os << " INT" << " " << vt.minimum << " " << vt.maximum;
+            }
+            void operator()(const IAttributeDefinition::ValueTypeHex& vt) const
+            {
+                _os << " HEX" << " " << vt.minimum << " " << vt.maximum;
+            }
+            void operator()(const IAttributeDefinition::ValueTypeFloat& vt) const
             {
-                os << "CM_ SG_ " << m.Id() << " " << s.Name() << " \"" << s.Comment() << "\"" << ";\n";
+                _os << " FLOAT" << " " << vt.minimum << " " << vt.maximum;
             }
+            void operator()(const IAttributeDefinition::ValueTypeString& vt) const
+            {
+                _os << " STRING";
+            }
+            void operator()(const IAttributeDefinition::ValueTypeEnum& vt) const
+            {
+                _os << " ENUM";
+                const auto& values = vt.values;
+                if (values.size())
+                {
+                    auto iter = values.begin();
+                    _os << " \"" << *iter << "\"";
+                    for (iter++; iter != values.end(); iter++)
+                    {
+                        _os << ", \"" << *iter << "\"";
+                    }
+                }
+            }
+
+        private:
+            DBCWriter& _os;
+        };
+
+        const char* object_type = "";
+        switch (ad.ObjectType())
+        {
+        case IAttributeDefinition::EObjectType::Network: break;
+        case IAttributeDefinition::EObjectType::Node: object_type = "BU_ "; break;
+        case IAttributeDefinition::EObjectType::Message: object_type = "BO_ "; break;
+        case IAttributeDefinition::EObjectType::Signal: object_type = "SG_ "; break;
+        case IAttributeDefinition::EObjectType::EnvironmentVariable: object_type = "EV_ "; break;
         }
+        os << "BA_DEF_ " << object_type;
+        os << "\"" << ad.Name() << "\"";
+        std::visit(VisitorValueType(os), ad.ValueType());
+        os << ";\n";
     }
-    for (const IEnvironmentVariable& ev : net.EnvironmentVariables())
+    void writeBitTiming(DBCWriter& os, const IBitTiming& bt)
     {
-        if (ev.Comment() != "")
+        os << "BS_:";
+        if (bt.Baudrate() != 0 && bt.BTR1() != 0 && bt.BTR2() != 0)
         {
-            os << "CM_ EV_ " << ev.Name() << " \"" << ev.Comment() << "\"" << ";\n";
+            os << " " << bt.Baudrate() << " : " << bt.BTR1() << ", " << bt.BTR2();
         }
-    }
-    for (const IAttributeDefinition& ad : net.AttributeDefinitions())
-    {
-        os << "\n";
-        os << ad;
-    }
-    for (const IAttribute& ad : net.AttributeDefaults())
-    {
-        os << "\n";
-        os << na_t{net, ad};
-    }
-    for (const IAttribute& av : net.AttributeValues())
-    {
         os << "\n";
-        os << na_t{net, av};
     }
-    for (const INode& n : net.Nodes())
+    void writeEnvironmentVariable(DBCWriter& os, const IEnvironmentVariable& ev)
     {
-        for (const IAttribute& av : n.AttributeValues())
+        os << "EV_ " << ev.Name() << ": ";
+        switch (ev.VarType())
         {
-            os << "\n";
-            os << na_t{net, av};
+        case IEnvironmentVariable::EVarType::Integer: os << "0"; break;
+        case IEnvironmentVariable::EVarType::Float: os << "1"; break;
+        case IEnvironmentVariable::EVarType::String: os << "2"; break;
+        case IEnvironmentVariable::EVarType::Data: os << "0"; break;
         }
-    }
-    for (const IMessage& m : net.Messages())
-    {
-        for (const IAttribute& av : m.AttributeValues())
+        os << " [" << ev.Minimum() << "|" << ev.Maximum() << "]" << " \"" << ev.Unit() << "\" "
+            << ev.InitialValue() << " " << ev.EvId() << " ";
+        switch (ev.AccessType())
         {
-            os << "\n";
-            os << na_t{net, av};
+        case IEnvironmentVariable::EAccessType::Unrestricted: os << "DUMMY_NODE_VECTOR0"; break;
+        case IEnvironmentVariable::EAccessType::Read: os << "DUMMY_NODE_VECTOR1"; break;
+        case IEnvironmentVariable::EAccessType::Write: os << "DUMMY_NODE_VECTOR2"; break;
+        case IEnvironmentVariable::EAccessType::ReadWrite: os << "DUMMY_NODE_VECTOR3"; break;
+        case IEnvironmentVariable::EAccessType::Unrestricted_: os << "DUMMY_NODE_VECTOR8000"; break;
+        case IEnvironmentVariable::EAccessType::Read_: os << "DUMMY_NODE_VECTOR8001"; break;
+        case IEnvironmentVariable::EAccessType::Write_: os << "DUMMY_NODE_VECTOR8002"; break;
+        case IEnvironmentVariable::EAccessType::ReadWrite_: os << "DUMMY_NODE_VECTOR8003"; break;
         }
-    }
-    for (const IMessage& m : net.Messages())
-    {
-        for (const ISignal& s : m.Signals())
+        bool first = true;
+        for (const std::string& n : ev.AccessNodes())
         {
-            for (const IAttribute& av : s.AttributeValues())
+            if (first)
             {
-                os << "\n";
-                os << na_t{net, av};
+                os << " " << n;
+                first = false;
+            }
+            else
+            {
+                os << ", " << n;
             }
         }
+        os << ";\n";
     }
-    for (const IEnvironmentVariable& ev : net.EnvironmentVariables())
+    void writeSignal(DBCWriter& os, const ISignal& s)
     {
-        for (const IAttribute& av : ev.AttributeValues())
+        os << "\tSG_ " << s.Name() << " ";
+        switch (s.MultiplexerIndicator())
         {
-            os << "\n";
-            os << na_t{net, av};
+        case ISignal::EMultiplexer::MuxSwitch: os << "M "; break;
+        case ISignal::EMultiplexer::MuxValue: os << "m" << s.MultiplexerSwitchValue() << " "; break;
         }
+        os << ": " << s.StartBit() << "|" << s.BitSize() << "@";
+        switch (s.ByteOrder())
+        {
+        case ISignal::EByteOrder::BigEndian: os << "0"; break;
+        case ISignal::EByteOrder::LittleEndian: os << "1"; break;
+        }
+        switch (s.ValueType())
+        {
+        case ISignal::EValueType::Unsigned: os << "+ "; break;
+        case ISignal::EValueType::Signed: os << "- "; break;
+        }
+        os << "(" << s.Factor() << "," << s.Offset() << ") ";
+        os << "[" << s.Minimum() << "|" << s.Maximum() << "] ";
+        os << "\"" << s.Unit() << "\"";
+        bool first = true;
+        for (const std::string& n : s.Receivers())
+        {
+            os << (first ? " " : ", ") << n;
+            first = false;
+        }
+        os << "\n";
     }
-    for (const IMessage& m : net.Messages())
+    void writeMessage(DBCWriter& os, const IMessage& m)
     {
+        os << "BO_ " << m.Id() << " " << m.Name() << ": " << m.MessageSize() << " " << m.Transmitter() << "\n";
         for (const ISignal& s : m.Signals())
         {
-            if (s.ValueEncodingDescriptions_Size())
-            {
-                os << "VAL_ " << m.Id() << " " << s.Name();
-                for (const IValueEncodingDescription& ved : s.ValueEncodingDescriptions())
-                {
-                    os << " " << ved.Value() << " \"" << ved.Description() << "\"";
-                }
-                os << ";\n";
-            }
+            writeSignal(os, s);
         }
     }
-    for (const IEnvironmentVariable& ev : net.EnvironmentVariables())
+    void writeSignalType(DBCWriter& os, const ISignalType& st)
     {
-        if (ev.ValueEncodingDescriptions_Size())
+        os << "SGTYPE_ " << st.Name() << " : " << st.SignalSize() << "@";
+        switch (st.ByteOrder())
         {
-            os << "VAL_ " << ev.Name();
-            for (const IValueEncodingDescription& ved : ev.ValueEncodingDescriptions())
-            {
-                os << " " << ved.Value() << " \"" << ved.Description() << "\"";
-            }
-            os << ";\n";
+        case ISignal::EByteOrder::BigEndian: os << "0"; break;
+        case ISignal::EByteOrder::LittleEndian: os << "1"; break;
         }
+        switch (st.ValueType())
+        {
+        case ISignal::EValueType::Unsigned: os << "+ "; break;
+        case ISignal::EValueType::Signed: os << "- "; break;
+        }
+        os << "(" << st.Factor() << "," << st.Offset() << ") ";
+        os << "[" << st.Minimum() << "|" << st.Maximum() << "] ";
+        os << "\"" << st.Unit() << "\" " << st.DefaultValue();
+        os << ", " << st.ValueTable();
+        os << ";";
     }
-    for (const IMessage& m : net.Messages())
+    void writeValueTable(DBCWriter& os, const IValueTable& vt)
     {
-        for (const ISignalGroup& sg : m.SignalGroups())
+        if (vt.ValueEncodingDescriptions_Size())
         {
-            os << "SIG_GROUP_ " << sg.MessageId() << " " << sg.Name() << " " << sg.Repetitions() << " :";
-            for (const std::string& name : sg.SignalNames())
+            os << "VAL_TABLE_ " << vt.Name();
+            for (const IValueEncodingDescription& ved : vt.ValueEncodingDescriptions())
             {
-                os << " " << name;
+                os << " " << ved.Value() << " \"" << ved.Description() << "\"";
             }
             os << ";\n";
         }
     }
-    for (const IMessage& m : net.Messages())
+
+    using Part = std::function<void(DBCWriter&)>;
+
+    // Splits the DBC of the network into parts which are written in this order. The statements of the messages
+    // and their signals are split into n_chunks parts each.
+    std::vector<Part> networkParts(const INetwork& net, std::size_t n_chunks)
     {
-        for (const ISignal& s : m.Signals())
-        {
-            if (s.ExtendedValueType() != ISignal::EExtendedValueType::Integer)
+        std::vector<Part> parts;
+        auto per_message =
+            [&](std::function<void(DBCWriter&, const IMessage&)> write)
             {
-                uint64_t type = 0;
-                switch (s.ExtendedValueType())
+                const std::size_t n_messages = net.Messages_Size();
+                for (std::size_t i = 0; i < n_chunks; i++)
                 {
-                case ISignal::EExtendedValueType::Float: type = 1; break;
-                case ISignal::EExtendedValueType::Double: type = 2; break;
+                    std::size_t begin = n_messages * i / n_chunks;
+                    std::size_t end = n_messages * (i + 1) / n_chunks;
+                    parts.push_back(
+                        [&net, write, begin, end](DBCWriter& os)
+                        {
+                            for (std::size_t j = begin; j < end; j++)
+                            {
+                                write(os, net.Messages_Get(j));
+                            }
+                        });
                 }
-                os << "SIG_VALTYPE_ " << m.Id() << " " << s.Name() << " : " << type << ";\n";
-            }
-        }
-    }
-    for (const IMessage& m : net.Messages())
-    {
-        for (const ISignal& s : m.Signals())
-        {
-            for (const ISignalMultiplexerValue& smv : s.SignalMultiplexerValues())
+            };
+        parts.push_back(
+            [&net](DBCWriter& os)
             {
-                os << "SG_MUL_VAL_ " << m.Id() << " " << s.Name() << " " << smv.SwitchName();
-                std::string ssr;
-                for (const ISignalMultiplexerValue::Range& range : smv.ValueRanges())
+                os << "VERSION \"" << net.Version() << "\"\n";
+                os << "NS_:\n";
+                for (const std::string& ns : net.NewSymbols())
                 {
-                    ssr += " " + std::to_string(range.from) + "-" + std::to_string(range.to) + ",";
+                    os << "\t" << ns << "\n";
                 }
-                if (!ssr.empty())
+                writeBitTiming(os, net.BitTiming());
+                os << "BU_:";
+                for (const INode& n : net.Nodes())
                 {
-                    ssr.erase(ssr.end() - 1);
-                    os << ssr;
+                    os << " " << n.Name();
                 }
-                os <<  ";\n";
-            }
-        }
+                os << "\n";
+                for (const IValueTable& vt : net.ValueTables())
+                {
+                    writeValueTable(os, vt);
+                }
+            });
+        per_message(writeMessage);
+        per_message(
+            [](DBCWriter& os, const IMessage& m)
+            {
+                if (m.MessageTransmitters_Size())
+                {
+                    os << "BO_TX_BU_ " << m.Id() << " : " << m.MessageTransmitters_Get(0);
+                    for (std::size_t i = 1; i < m.MessageTransmitters_Size(); i++)
+                    {
+                        os << ", " << m.MessageTransmitters_Get(i);
+                    }
+                    os << ";\n";
+                }
+            });
+        parts.push_back(
+            [&net](DBCWriter& os)
+            {
+                for (const IEnvironmentVariable& ev : net.EnvironmentVariables())
+                {
+                    writeEnvironmentVariable(os, ev);
+                }
+                for (const IEnvironmentVariable& ev : net.EnvironmentVariables())
+                {
+                    if (ev.VarType() == IEnvironmentVariable::EVarType::Data)
+                    {
+                        os << "ENVVAR_DATA_ " << ev.Name() << " : " << ev.DataSize() << ";\n";
+                    }
+                }
+                for (const IValueTable& vt : net.ValueTables())
+                {
+                    if (vt.SignalType())
+                    {
+                        writeValueTable(os, vt);
+                    }
+                }
+                if (net.Comment() != "")
+                {
+                    os << "CM_ \"" << net.Comment() << "\";\n";
+                }
+                for (const INode& n : net.Nodes())
+                {
+                    if (n.Comment() != "")
+                    {
+                        os << "CM_ BU_ " << n.Name() << " \"" << n.Comment() << "\"" << ";\n";
+                    }
+                }
+            });
+        per_message(
+            [](DBCWriter& os, const IMessage& m)
+            {
+                if (m.Comment() != "")
+                {
+                    os << "CM_ BO_ " << m.Id() << " \"" << m.Comment() << "\"" << ";\n";
+                }
+            });
+        per_message(
+            [](DBCWriter& os, const IMessage& m)
+            {
+                for (const ISignal& s : m.Signals())
+                {
+                    if (s.Comment() != "")
+                    {
+                        os << "CM_ SG_ " << m.Id() << " " << s.Name() << " \"" << s.Comment() << "\"" << ";\n";
+                    }
+                }
+            });
+        parts.push_back(
+            [&net](DBCWriter& os)
+            {
+                for (const IEnvironmentVariable& ev : net.EnvironmentVariables())
+                {
+                    if (ev.Comment() != "")
+                    {
+                        os << "CM_ EV_ " << ev.Name() << " \"" << ev.Comment() << "\"" << ";\n";
+                    }
+                }
+                for (const IAttributeDefinition& ad : net.AttributeDefinitions())
+                {
+                    os << "\n";
+                    writeAttributeDefinition(os, ad);
+                }
+                for (const IAttribute& ad : net.AttributeDefaults())
+                {
+                    os << "\n";
+                    writeAttribute(os, net, ad);
+                }
+                for (const IAttribute& av : net.AttributeValues())
+                {
+                    os << "\n";
+                    writeAttribute(os, net, av);
+                }
+                for (const INode& n : net.Nodes())
+                {
+                    for (const IAttribute& av : n.AttributeValues())
+                    {
+                        os << "\n";
+                        writeAttribute(os, net, av);
+                    }
+                }
+            });
+        per_message(
+            [&net](DBCWriter& os, const IMessage& m)
+            {
+                for (const IAttribute& av : m.AttributeValues())
+                {
+                    os << "\n";
+                    writeAttribute(os, net, av);
+                }
+            });
+        per_message(
+            [&net](DBCWriter& os, const IMessage& m)
+            {
+                for (const ISignal& s : m.Signals())
+                {
+                    for (const IAttribute& av : s.AttributeValues())
+                    {
+                        os << "\n";
+                        writeAttribute(os, net, av);
+                    }
+                }
+            });
+        parts.push_back(
+            [&net](DBCWriter& os)
+            {
+                for (const IEnvironmentVariable& ev : net.EnvironmentVariables())
+                {
+                    for (const IAttribute& av : ev.AttributeValues())
+                    {
+                        os << "\n";
+                        writeAttribute(os, net, av);
+                    }
+                }
+            });
+        per_message(
+            [](DBCWriter& os, const IMessage& m)
+            {
+                for (const ISignal& s : m.Signals())
+                {
+                    if (s.ValueEncodingDescriptions_Size())
+                    {
+                        os << "VAL_ " << m.Id() << " " << s.Name();
+                        for (const IValueEncodingDescription& ved : s.ValueEncodingDescriptions())
+                        {
+                            os << " " << ved.Value() << " \"" << ved.Description() << "\"";
+                        }
+                        os << ";\n";
+                    }
+                }
+            });
+        parts.push_back(
+            [&net](DBCWriter& os)
+            {
+                for (const IEnvironmentVariable& ev : net.EnvironmentVariables())
+                {
+                    if (ev.ValueEncodingDescriptions_Size())
+                    {
+                        os << "VAL_ " << ev.Name();
+                        for (const IValueEncodingDescription& ved : ev.ValueEncodingDescriptions())
+                        {
+                            os << " " << ved.Value() << " \"" << ved.Description() << "\"";
+                        }
+                        os << ";\n";
+                    }
+                }
+            });
+        per_message(
+            [](DBCWriter& os, const IMessage& m)
+            {
+                for (const ISignalGroup& sg : m.SignalGroups())
+                {
+                    os << "SIG_GROUP_ " << sg.MessageId() << " " << sg.Name() << " " << sg.Repetitions() << " :";
+                    for (const std::string& name : sg.SignalNames())
+                    {
+                        os << " " << name;
+                    }
+                    os << ";\n";
+                }
+            });
+        per_message(
+            [](DBCWriter& os, const IMessage& m)
+            {
+                for (const ISignal& s : m.Signals())
+                {
+                    if (s.ExtendedValueType() != ISignal::EExtendedValueType::Integer)
+                    {
+                        uint64_t type = 0;
+                        switch (s.ExtendedValueType())
+                        {
+                        case ISignal::EExtendedValueType::Float: type = 1; break;
+                        case ISignal::EExtendedValueType::Double: type = 2; break;
+                        }
+                        os << "SIG_VALTYPE_ " << m.Id() << " " << s.Name() << " : " << type << ";\n";
+                    }
+                }
+            });
+        per_message(
+            [](DBCWriter& os, const IMessage& m)
+            {
+                for (const ISignal& s : m.Signals())
+                {
+                    for (const ISignalMultiplexerValue& smv : s.SignalMultiplexerValues())
+                    {
+                        os << "SG_MUL_VAL_ " << m.Id() << " " << s.Name() << " " << smv.SwitchName();
+                        bool first = true;
+                        for (const ISignalMultiplexerValue::Range& range : smv.ValueRanges())
+                        {
+                            os << (first ? " " : ", ") << std::to_string(range.from) << "-" << std::to_string(range.to);
+                            first = false;
+                        }
+                        os << ";\n";
+                    }
+                }
+            });
+        return parts;
     }
+
+    // networks with fewer messages are written on the calling thread
+    constexpr std::size_t parallel_min_messages = 1024;
+}
+
+DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const na_t& na)
+{
+    DBCWriter writer(os, &os);
+    writeAttribute(writer, std::get<0>(na), std::get<1>(na));
+    writer.Flush();
     return os;
 }
-DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const INode& n)
+DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const IAttributeDefinition& ad)
 {
-    os << n.Name();
+    DBCWriter writer(os, &os);
+    writeAttributeDefinition(writer, ad);
+    writer.Flush();
     return os;
 }
-DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const ISignal& s)
+DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const IBitTiming& bt)
 {
-    os << "\tSG_ " << s.Name() << " ";
-    switch (s.MultiplexerIndicator())
-    {
-    case ISignal::EMultiplexer::MuxSwitch: os << "M "; break;
-    case ISignal::EMultiplexer::MuxValue: os << "m" << s.MultiplexerSwitchValue() << " "; break;
-    }
-    os << ": " << s.StartBit() << "|" << s.BitSize() << "@";
-    switch (s.ByteOrder())
-    {
-    case ISignal::EByteOrder::BigEndian: os << "0"; break;
-    case ISignal::EByteOrder::LittleEndian: os << "1"; break;
-    }
-    switch (s.ValueType())
+    DBCWriter writer(os, &os);
+    writeBitTiming(writer, bt);
+    writer.Flush();
+    return os;
+}
+DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const IEnvironmentVariable& ev)
+{
+    DBCWriter writer(os, &os);
+    writeEnvironmentVariable(writer, ev);
+    writer.Flush();
+    return os;
+}
+DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const IMessage& m)
+{
+    DBCWriter writer(os, &os);
+    writeMessage(writer, m);
+    writer.Flush();
+    return os;
+}
+DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const INetwork& net)
+{
+    std::size_t n_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    if (n_threads == 1 || net.Messages_Size() < parallel_min_messages)
     {
-    case ISignal::EValueType::Unsigned: os << "+ "; break;
-    case ISignal::EValueType::Signed: os << "- "; break;
+        DBCWriter writer(os, &os);
+        for (const auto& part : networkParts(net, 1))
+        {
+            part(writer);
+        }
+        writer.Flush();
+        return os;
     }
-    os << "(" << s.Factor() << "," << s.Offset() << ") ";
-    os << "[" << s.Minimum() << "|" << s.Maximum() << "] ";
-    os << "\"" << s.Unit() << "\"";
-    std::string receivers;
-    for (const std::string& n : s.Receivers())
+    // the parts are written into their own buffers in parallel and the buffers are written to the stream in order
+    auto parts = networkParts(net, n_threads);
+    std::vector<DBCWriter> writers;
+    writers.reserve(parts.size());
+    for (std::size_t i = 0; i < parts.size(); i++)
     {
-        receivers += n + ", ";
+        writers.emplace_back(os, nullptr);
     }
-    if (receivers.size())
+    std::vector<std::exception_ptr> errors(parts.size());
+    ParallelFor(parts.size(), n_threads,
+        [&](std::size_t i)
+        {
+            try
+            {
+                parts[i](writers[i]);
+            }
+            catch (...)
+            {
+                errors[i] = std::current_exception();
+            }
+        });
+    for (std::size_t i = 0; i < parts.size(); i++)
     {
-        receivers.erase(receivers.end() - 1);
-        receivers.erase(receivers.end() - 1);
-        os << " ";
+        if (errors[i])
+        {
+            std::rethrow_exception(errors[i]);
+        }
+        os.write(writers[i].Buffer().data(), writers[i].Buffer().size());
     }
-    os << receivers;
-    os << "\n";
+    return os;
+}
+DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const INode& n)
+{
+    os << n.Name();
+    return os;
+}
+DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const ISignal& s)
+{
+    DBCWriter writer(os, &os);
+    writeSignal(writer, s);
+    writer.Flush();
     return os;
 }
 DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const ISignalType& st)
 {
-    os << "SGTYPE_ " << st.Name() << " : " << st.SignalSize() << "@";
-    switch (st.ByteOrder())
-    {
-    case ISignal::EByteOrder::BigEndian: os << "0"; break;
-    case ISignal::EByteOrder::LittleEndian: os << "1"; break;
-    }
-    switch (st.ValueType())
-    {
-    case ISignal::EValueType::Unsigned: os << "+ "; break;
-    case ISignal::EValueType::Signed: os << "- "; break;
-    }
-    os << "(" << st.Factor() << "," << st.Offset() << ") ";
-    os << "[" << st.Minimum() << "|" << st.Maximum() << "] ";
-    os << "\"" << st.Unit() << "\" " << st.DefaultValue();
-    os << ", " << st.ValueTable();
-    os << ";";
+    DBCWriter writer(os, &os);
+    writeSignalType(writer, st);
+    writer.Flush();
     return os;
 }
 DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const IValueTable& vt)
 {
-    if (vt.ValueEncodingDescriptions_Size())
-    {
-        os << "VAL_TABLE_ " << vt.Name();
-        for (const IValueEncodingDescription& ved : vt.ValueEncodingDescriptions())
-        {
-            os << " " << ved.Value() << " \"" << ved.Description() << "\"";
-        }
-        os << ";\n";
-    }
+    DBCWriter writer(os, &os);
+    writeValueTable(writer, vt);
+    writer.Flush();
     return os;
-}
\ No newline at end of file
+}
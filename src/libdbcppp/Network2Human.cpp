@@ -1,50 +1,10 @@
 
 #include <boost/format.hpp>
 #include "../../include/dbcppp/Network2Functions.h"
+#include "BitLayout.h"
 
 using namespace dbcppp;
 
-bool bit_is_inbetween(const ISignal& sig, std::size_t i_bit, uint64_t switch_value = -1)
-{
-    if (switch_value != -1 &&
-        sig.MultiplexerIndicator() == ISignal::EMultiplexer::MuxValue &&
-        sig.MultiplexerSwitchValue() != switch_value)
-    {
-        return false;
-    }
-    switch (sig.ByteOrder())
-    {
-    case ISignal::EByteOrder::LittleEndian:
-    {
-        std::size_t start = sig.StartBit();
-        std::size_t end = sig.StartBit() + sig.BitSize();
-        return start <= i_bit && end > i_bit;
-    }
-    case ISignal::EByteOrder::BigEndian:
-    {
-        std::size_t start = sig.StartBit();
-        std::size_t n = sig.BitSize();
-        while (n)
-        {
-            if (start == i_bit)
-            {
-                return true;
-            }
-            if (start % 8 == 0)
-            {
-                start += 15;
-            }
-            else
-            {
-                start--;
-            }
-            n--;
-        }
-        return true;
-    }
-    }
-    return false;
-}
 bool is_start_bit(const ISignal& sig, std::size_t i_bit)
 {
     switch (sig.ByteOrder())
@@ -78,19 +38,6 @@ const ISignal* get_mux_signal(const IMessage& msg)
         });
     return iter != end ? &*iter : nullptr;
 }
-std::set<uint64_t> get_mux_values(const IMessage& msg)
-{
-    std::set<uint64_t> mux_values;
-    for (const ISignal& sig : msg.Signals())
-    {
-        if (sig.MultiplexerIndicator() == ISignal::EMultiplexer::MuxValue)
-        {
-            mux_values.insert(sig.MultiplexerSwitchValue());
-        }
-    }
-    return mux_values;
-}
-
 DBCPPP_API std::ostream& dbcppp::Network2Human::operator<<(std::ostream& os, const IMessage& msg)
 {
     os << boost::format("  %-12s%s\n") % "Name:" % msg.Name();
@@ -100,7 +47,9 @@ DBCPPP_API std::ostream& dbcppp::Network2Human::operator<<(std::ostream& os, con
     os << boost::format("  %-12s%s\n") % "Comment:" % msg.Comment();
     os << boost::format("  Layout:\n");
     
-    auto mux_values = get_mux_values(msg);
+    // the signal of each bit is looked up in the layout instead of searching all signals for every bit
+    const BitLayout layout(msg);
+    const auto& mux_values = layout.SwitchValues();
     const ISignal* mux_sig = get_mux_signal(msg);
     
     std::vector<const ISignal*> sigs;
@@ -133,7 +82,7 @@ DBCPPP_API std::ostream& dbcppp::Network2Human::operator<<(std::ostream& os, con
         };
     bool print_last_line = false;
     auto print_signal =
-        [&](uint64_t mux_value = -1)
+        [&](std::optional<uint64_t> mux_value = std::nullopt)
         {
             print_bar();
             print_ident();
@@ -141,10 +90,7 @@ DBCPPP_API std::ostream& dbcppp::Network2Human::operator<<(std::ostream& os, con
             auto find_cur_sig =
                 [&]()
                 {
-                    auto beg = msg.Signals().begin();
-                    auto end = msg.Signals().end();
-                    auto iter = std::find_if(beg, end, [&](const ISignal& sig) { return bit_is_inbetween(sig, i_bit, mux_value); });
-                    return iter != end ? &*iter : nullptr;
+                    return layout.Owner(i_bit, mux_value);
                 };
             int64_t depth = 0;
             for (std::size_t i = 0; i < 8; i++)
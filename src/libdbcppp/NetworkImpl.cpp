@@ -1,6 +1,9 @@
+#include <thread>
 #include <fstream>
 #include <iomanip>
+#include <algorithm>
 #include "../../include/dbcppp/Network.h"
+#include "Helper.h"
 #include "NetworkImpl.h"
 
 using namespace dbcppp;
@@ -100,10 +103,15 @@ NetworkImpl::NetworkImpl(
     , _attribute_defaults(std::move(attribute_defaults))
     , _attribute_values(std::move(attribute_values))
     , _comment(std::move(comment))
-{}
+{
+    RebuildIndices();
+}
 std::unique_ptr<INetwork> NetworkImpl::Clone() const
 {
-    return std::make_unique<NetworkImpl>(*this);
+    LoadMetadata();
+    auto clone = std::make_unique<NetworkImpl>(*this);
+    clone->_lazy_metadata.reset();
+    return clone;
 }
 const std::string& NetworkImpl::Version() const
 {
@@ -147,10 +155,12 @@ uint64_t NetworkImpl::Messages_Size() const
 }
 const IEnvironmentVariable& NetworkImpl::EnvironmentVariables_Get(std::size_t i) const
 {
+    LoadMetadata();
     return _environment_variables[i];
 }
 uint64_t NetworkImpl::EnvironmentVariables_Size() const
 {
+    LoadMetadata();
     return _environment_variables.size();
 }
 const IAttributeDefinition& NetworkImpl::AttributeDefinitions_Get(std::size_t i) const
@@ -171,30 +181,98 @@ uint64_t NetworkImpl::AttributeDefaults_Size() const
 }
 const IAttribute& NetworkImpl::AttributeValues_Get(std::size_t i) const
 {
+    LoadMetadata();
     return _attribute_values[i];
 }
 uint64_t NetworkImpl::AttributeValues_Size() const
 {
+    LoadMetadata();
     return _attribute_values.size();
 }
 const std::string& NetworkImpl::Comment() const
 {
+    LoadMetadata();
     return _comment;
 }
 const IMessage* NetworkImpl::ParentMessage(const ISignal* sig) const
 {
-    const IMessage* parent = nullptr;
-    for (const auto& msg : _messages)
+    uint32_t i = Relations().ParentMessage(sig);
+    return i != NetworkRelations::npos ? &_messages[i] : nullptr;
+}
+std::span<const IMessage* const> NetworkImpl::TransmittedMessages(const INode& node) const
+{
+    auto n = static_cast<const NodeImpl*>(&node);
+    if (_nodes.empty() || n < _nodes.data() || n >= _nodes.data() + _nodes.size())
+    {
+        return {};
+    }
+    return Relations().TransmittedMessages(n - _nodes.data());
+}
+std::span<const ISignal* const> NetworkImpl::ReceivedSignals(const INode& node) const
+{
+    auto n = static_cast<const NodeImpl*>(&node);
+    if (_nodes.empty() || n < _nodes.data() || n >= _nodes.data() + _nodes.size())
     {
-        auto iter = std::find_if(msg.signals().begin(), msg.signals().end(),
-            [&](const SignalImpl& other) { return &other == sig; });
-        if (iter != msg.signals().end())
+        return {};
+    }
+    return Relations().ReceivedSignals(n - _nodes.data());
+}
+const NetworkRelations& NetworkImpl::Relations() const
+{
+    return _relations.Get(
+        [this](NetworkRelations& relations)
         {
-            parent = &msg;
-            break;
-        }
+            LoadMetadata();
+            relations.Build(_nodes, _messages, _environment_variables, _attribute_defaults, _attribute_values);
+        });
+}
+const IMessage* NetworkImpl::MessageById(uint64_t id) const
+{
+    uint32_t i = _message_id_index.Find(id);
+    return i != MessageIdIndex::npos ? &_messages[i] : nullptr;
+}
+const IMessage* NetworkImpl::MessageByName(std::string_view name) const
+{
+    uint32_t i = _message_name_index.Find(_messages.size(), name,
+        [this](std::size_t i) -> std::string_view { return _messages[i].Name(); });
+    return i != NameIndex::npos ? &_messages[i] : nullptr;
+}
+const ISignal* NetworkImpl::FindSignal(std::string_view qualified_name) const
+{
+    auto dot = qualified_name.find('.');
+    if (dot == std::string_view::npos)
+    {
+        return nullptr;
+    }
+    const IMessage* msg = MessageByName(qualified_name.substr(0, dot));
+    return msg ? msg->SignalByName(qualified_name.substr(dot + 1)) : nullptr;
+}
+const INode* NetworkImpl::NodeByName(std::string_view name) const
+{
+    uint32_t i = _node_name_index.Find(_nodes.size(), name,
+        [this](std::size_t i) -> std::string_view { return _nodes[i].Name(); });
+    return i != NameIndex::npos ? &_nodes[i] : nullptr;
+}
+const IValueTable* NetworkImpl::ValueTableByName(std::string_view name) const
+{
+    uint32_t i = _value_table_name_index.Find(_value_tables.size(), name,
+        [this](std::size_t i) -> std::string_view { return _value_tables[i].Name(); });
+    return i != NameIndex::npos ? &_value_tables[i] : nullptr;
+}
+void NetworkImpl::RebuildIndices()
+{
+    std::vector<uint64_t> ids;
+    ids.reserve(_messages.size());
+    for (const auto& msg : _messages)
+    {
+        ids.push_back(msg.Id());
     }
-    return parent;
+    _message_id_index.Build(ids);
+    // the name indices and relations are built on their first use
+    _message_name_index.Reset();
+    _node_name_index.Reset();
+    _value_table_name_index.Reset();
+    _relations.Reset();
 }
 std::string& NetworkImpl::version()
 {
@@ -240,46 +318,57 @@ std::string& NetworkImpl::comment()
 {
     return _comment;
 }
-void INetwork::Merge(std::unique_ptr<INetwork>&& other)
+void NetworkImpl::SetLazyMetadata(std::shared_ptr<const LazyMetadata> lazy)
 {
-    auto& self = static_cast<NetworkImpl&>(*this);
-    auto& o = static_cast<NetworkImpl&>(*other);
-    for (auto& ns : o.newSymbols())
+    _lazy_metadata = std::move(lazy);
+    for (auto& node : _nodes)
     {
-        self.newSymbols().push_back(std::move(ns));
+        node.SetLazyMetadata(_lazy_metadata.get());
     }
-    for (auto& n : o.nodes())
+    for (auto& msg : _messages)
     {
-        self.nodes().push_back(std::move(n));
+        msg.SetLazyMetadata(_lazy_metadata.get());
     }
-    for (auto& vt : o.valueTables())
-    {
-        self.valueTables().push_back(std::move(vt));
-    }
-    for (auto& m : o.messages())
-    {
-        self.messages().push_back(std::move(m));
-    }
-    for (auto& ev : o.environmentVariables())
-    {
-        self.environmentVariables().push_back(std::move(ev));
-    }
-    for (auto& ad : o.attributeDefinitions())
-    {
-        self.attributeDefinitions().push_back(std::move(ad));
-    }
-    for (auto& ad : o.attributeDefaults())
-    {
-        self.attributeDefaults().push_back(std::move(ad));
-    }
-    for (auto& av : o.attributeValues())
+}
+void NetworkImpl::LoadMetadata() const
+{
+    if (_lazy_metadata)
     {
-        self.attributeValues().push_back(std::move(av));
+        _lazy_metadata->Load();
     }
+}
+void INetwork::Merge(std::unique_ptr<INetwork>&& other)
+{
+    auto& self = static_cast<NetworkImpl&>(*this);
+    self.Append(std::move(static_cast<NetworkImpl&>(*other)));
+    self.RebuildIndices();
     other.reset(nullptr);
 }
+void NetworkImpl::Append(NetworkImpl&& other)
+{
+    LoadMetadata();
+    other.LoadMetadata();
+    auto append =
+        [](auto& elements, auto& others)
+        {
+            elements.reserve(elements.size() + others.size());
+            for (auto& e : others)
+            {
+                elements.push_back(std::move(e));
+            }
+        };
+    append(_new_symbols, other._new_symbols);
+    append(_nodes, other._nodes);
+    append(_value_tables, other._value_tables);
+    append(_messages, other._messages);
+    append(_environment_variables, other._environment_variables);
+    append(_attribute_definitions, other._attribute_definitions);
+    append(_attribute_defaults, other._attribute_defaults);
+    append(_attribute_values, other._attribute_values);
+}
 bool NetworkImpl::operator==(const INetwork& rhs) const
 {
+    LoadMetadata();
     bool equal = true;
     equal &= _version == rhs.Version();
     for (const auto& new_symbol : _new_symbols)
@@ -323,7 +412,7 @@ bool NetworkImpl::operator!=(const INetwork& rhs) const
     return !(*this == rhs);
 }
 
-std::map<std::string, std::unique_ptr<INetwork>> INetwork::LoadNetworkFromFile(const std::filesystem::path& filename)
+std::map<std::string, std::unique_ptr<INetwork>> INetwork::LoadNetworkFromFile(const std::filesystem::path& filename, const DBCLoadOptions& options)
 {
     auto result = std::map<std::string, std::unique_ptr<INetwork>>();
     auto is = std::ifstream(filename);
@@ -333,7 +422,7 @@ std::map<std::string, std::unique_ptr<INetwork>> INetwork::LoadNetworkFromFile(c
     }
     else if (filename.extension() == ".dbc")
     {
-        auto net = LoadDBCFromIs(is);
+        auto net = LoadDBCFromFile(filename, options);
         if (net)
         {
             result.insert(std::make_pair("", std::move(net)));
@@ -346,4 +435,58 @@ std::map<std::string, std::unique_ptr<INetwork>> INetwork::LoadNetworkFromFile(c
     }
 #endif
     return std::move(result);
+}
+std::vector<std::map<std::string, std::unique_ptr<INetwork>>> INetwork::LoadNetworkMapsFromFiles(
+    std::span<const std::filesystem::path> filenames, std::size_t n_threads, const DBCLoadOptions& options)
+{
+    auto result = std::vector<std::map<std::string, std::unique_ptr<INetwork>>>(filenames.size());
+    if (n_threads == 0)
+    {
+        n_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    // each thread takes the next file which isn't loaded yet, so a few big files don't keep the others waiting
+    ParallelFor(filenames.size(), n_threads,
+        [&](std::size_t i)
+        {
+            try
+            {
+                result[i] = LoadNetworkFromFile(filenames[i], options);
+            }
+            catch (...)
+            {
+                result[i].clear();
+            }
+        });
+    return result;
+}
+std::unique_ptr<INetwork> INetwork::LoadNetworksFromFiles(
+    std::span<const std::filesystem::path> filenames, std::size_t n_threads, const DBCLoadOptions& options)
+{
+    auto nets = LoadNetworkMapsFromFiles(filenames, n_threads, options);
+    std::unique_ptr<INetwork> result;
+    for (auto& file_nets : nets)
+    {
+        if (file_nets.empty())
+        {
+            return nullptr;
+        }
+        for (auto& [name, net] : file_nets)
+        {
+            if (!result)
+            {
+                result = std::move(net);
+            }
+            else
+            {
+                // the indices are only rebuilt once after all networks have been merged
+                static_cast<NetworkImpl&>(*result).Append(std::move(static_cast<NetworkImpl&>(*net)));
+            }
+        }
+    }
+    if (!result)
+    {
+        return Create({}, {}, IBitTiming::Create(0, 0, 0), {}, {}, {}, {}, {}, {}, {}, {});
+    }
+    static_cast<NetworkImpl&>(*result).RebuildIndices();
+    return result;
 }
\ No newline at end of file
@@ -8,6 +8,10 @@
 #include "SignalTypeImpl.h"
 #include "AttributeDefinitionImpl.h"
 #include "AttributeImpl.h"
+#include "MessageIdIndex.h"
+#include "NameIndex.h"
+#include "NetworkRelations.h"
+#include "LazyMetadata.h"
 
 namespace dbcppp
 {
@@ -51,6 +55,13 @@ namespace dbcppp
         virtual const std::string& Comment() const override;
         
         virtual const IMessage* ParentMessage(const ISignal* sig) const override;
+        virtual std::span<const IMessage* const> TransmittedMessages(const INode& node) const override;
+        virtual std::span<const ISignal* const> ReceivedSignals(const INode& node) const override;
+        virtual const IMessage* MessageById(uint64_t id) const override;
+        virtual const IMessage* MessageByName(std::string_view name) const override;
+        virtual const ISignal* FindSignal(std::string_view qualified_name) const override;
+        virtual const INode* NodeByName(std::string_view name) const override;
+        virtual const IValueTable* ValueTableByName(std::string_view name) const override;
         
         virtual bool operator==(const INetwork& rhs) const override;
         virtual bool operator!=(const INetwork& rhs) const override;
@@ -67,6 +78,16 @@ namespace dbcppp
         std::vector<AttributeImpl>& attributeValues();
         std::string& comment();
 
+        // has to be called after the messages, nodes or value tables have been modified
+        void RebuildIndices();
+        // moves the elements of other behind the own ones like INetwork::Merge, but doesn't rebuild the indices
+        void Append(NetworkImpl&& other);
+        const NetworkRelations& Relations() const;
+        // the comments, attribute values and environment variables are moved in by the lazy metadata on the
+        // first access, the mutable accessors don't load them
+        void SetLazyMetadata(std::shared_ptr<const LazyMetadata> lazy);
+        void LoadMetadata() const;
+
     private:
         std::string _version;
         std::vector<std::string> _new_symbols;
@@ -79,5 +100,12 @@ namespace dbcppp
         std::vector<AttributeImpl> _attribute_defaults;
         std::vector<AttributeImpl> _attribute_values;
         std::string _comment;
+
+        MessageIdIndex _message_id_index;
+        LazyNameIndex _message_name_index;
+        LazyNameIndex _node_name_index;
+        LazyNameIndex _value_table_name_index;
+        Lazy<NetworkRelations> _relations;
+        std::shared_ptr<const LazyMetadata> _lazy_metadata;
     };
 }
\ No newline at end of file
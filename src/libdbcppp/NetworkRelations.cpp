@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <string_view>
+#include "NetworkRelations.h"
+
+using namespace dbcppp;
+
+void NetworkRelations::Build(
+      const std::vector<NodeImpl>& nodes
+    , const std::vector<MessageImpl>& messages
+    , const std::vector<EnvironmentVariableImpl>& environment_variables
+    , const std::vector<AttributeImpl>& attribute_defaults
+    , const std::vector<AttributeImpl>& attribute_values)
+{
+    using EOwner = AttributeOwner::EOwner;
+    _signal_messages.clear();
+    _attribute_owners.clear();
+    auto add_attributes =
+        [&](const auto& obj, EOwner owner, std::size_t index, std::size_t sub_index)
+        {
+            for (std::size_t i = 0; i < obj.AttributeValues_Size(); i++)
+            {
+                _attribute_owners.emplace(&obj.AttributeValues_Get(i), AttributeOwner{owner, uint32_t(index), uint32_t(sub_index)});
+            }
+        };
+    for (const auto& attr : attribute_defaults)
+    {
+        _attribute_owners.emplace(&attr, AttributeOwner{EOwner::Default, npos, npos});
+    }
+    for (const auto& attr : attribute_values)
+    {
+        _attribute_owners.emplace(&attr, AttributeOwner{EOwner::Network, npos, npos});
+    }
+    for (std::size_t i = 0; i < nodes.size(); i++)
+    {
+        add_attributes(nodes[i], EOwner::Node, i, npos);
+    }
+    for (std::size_t i = 0; i < environment_variables.size(); i++)
+    {
+        add_attributes(environment_variables[i], EOwner::EnvironmentVariable, i, npos);
+    }
+
+    std::unordered_map<std::string_view, uint32_t> node_by_name;
+    for (std::size_t i = 0; i < nodes.size(); i++)
+    {
+        node_by_name.emplace(nodes[i].Name(), uint32_t(i));
+    }
+    auto find_node =
+        [&](const std::string& name)
+        {
+            auto iter = node_by_name.find(name);
+            return iter != node_by_name.end() ? iter->second : npos;
+        };
+    // (node, entry) pairs which are sorted into the adjacency lists afterwards
+    std::vector<std::pair<uint32_t, const IMessage*>> transmitted;
+    std::vector<std::pair<uint32_t, const ISignal*>> received;
+    for (std::size_t i = 0; i < messages.size(); i++)
+    {
+        const MessageImpl& msg = messages[i];
+        add_attributes(msg, EOwner::Message, i, npos);
+        std::vector<uint32_t> transmitters;
+        transmitters.push_back(find_node(msg.Transmitter()));
+        for (std::size_t j = 0; j < msg.MessageTransmitters_Size(); j++)
+        {
+            transmitters.push_back(find_node(msg.MessageTransmitters_Get(j)));
+        }
+        std::sort(transmitters.begin(), transmitters.end());
+        transmitters.erase(std::unique(transmitters.begin(), transmitters.end()), transmitters.end());
+        for (auto node : transmitters)
+        {
+            if (node != npos)
+            {
+                transmitted.emplace_back(node, &msg);
+            }
+        }
+        const auto& signals = msg.signals();
+        for (std::size_t j = 0; j < signals.size(); j++)
+        {
+            const SignalImpl& sig = signals[j];
+            _signal_messages.emplace(&sig, uint32_t(i));
+            add_attributes(sig, EOwner::Signal, i, j);
+            std::vector<uint32_t> receivers;
+            for (std::size_t k = 0; k < sig.Receivers_Size(); k++)
+            {
+                receivers.push_back(find_node(sig.Receivers_Get(k)));
+            }
+            std::sort(receivers.begin(), receivers.end());
+            receivers.erase(std::unique(receivers.begin(), receivers.end()), receivers.end());
+            for (auto node : receivers)
+            {
+                if (node != npos)
+                {
+                    received.emplace_back(node, &sig);
+                }
+            }
+        }
+    }
+    auto build_adjacency =
+        [&](auto& pairs, auto& offsets, auto& entries)
+        {
+            std::stable_sort(pairs.begin(), pairs.end(),
+                [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+            offsets.assign(nodes.size() + 1, 0);
+            entries.clear();
+            entries.reserve(pairs.size());
+            for (const auto& [node, entry] : pairs)
+            {
+                offsets[node + 1]++;
+                entries.push_back(entry);
+            }
+            for (std::size_t i = 0; i < nodes.size(); i++)
+            {
+                offsets[i + 1] += offsets[i];
+            }
+        };
+    build_adjacency(transmitted, _transmitted_offsets, _transmitted_messages);
+    build_adjacency(received, _received_offsets, _received_signals);
+}
+uint32_t NetworkRelations::ParentMessage(const ISignal* sig) const
+{
+    auto iter = _signal_messages.find(sig);
+    return iter != _signal_messages.end() ? iter->second : npos;
+}
+const NetworkRelations::AttributeOwner* NetworkRelations::FindAttributeOwner(const IAttribute* attr) const
+{
+    auto iter = _attribute_owners.find(attr);
+    return iter != _attribute_owners.end() ? &iter->second : nullptr;
+}
+std::span<const IMessage* const> NetworkRelations::TransmittedMessages(std::size_t node) const
+{
+    if (node + 1 >= _transmitted_offsets.size())
+    {
+        return {};
+    }
+    return {_transmitted_messages.data() + _transmitted_offsets[node], _transmitted_messages.data() + _transmitted_offsets[node + 1]};
+}
+std::span<const ISignal* const> NetworkRelations::ReceivedSignals(std::size_t node) const
+{
+    if (node + 1 >= _received_offsets.size())
+    {
+        return {};
+    }
+    return {_received_signals.data() + _received_offsets[node], _received_signals.data() + _received_offsets[node + 1]};
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "NodeImpl.h"
+#include "MessageImpl.h"
+#include "EnvironmentVariableImpl.h"
+#include "AttributeImpl.h"
+
+namespace dbcppp
+{
+    // Back references of the objects of a network: signal to message, attribute to owner,
+    // node to transmitted messages and node to received signals.
+    // The references are positions and pointers into the containers of the network, so they
+    // have to be rebuilt after the containers have been modified.
+    class NetworkRelations
+    {
+    public:
+        static constexpr uint32_t npos = uint32_t(-1);
+
+        struct AttributeOwner
+        {
+            enum class EOwner
+                : uint8_t
+            {
+                Network,
+                Default,
+                Node,
+                Message,
+                Signal,
+                EnvironmentVariable
+            };
+            EOwner owner;
+            // position of the node, message or environment variable
+            uint32_t index;
+            // position of the signal in the message
+            uint32_t sub_index;
+        };
+
+        void Build(
+              const std::vector<NodeImpl>& nodes
+            , const std::vector<MessageImpl>& messages
+            , const std::vector<EnvironmentVariableImpl>& environment_variables
+            , const std::vector<AttributeImpl>& attribute_defaults
+            , const std::vector<AttributeImpl>& attribute_values);
+
+        // returns the position of the message or npos
+        uint32_t ParentMessage(const ISignal* sig) const;
+        // returns nullptr if the attribute doesn't belong to the network
+        const AttributeOwner* FindAttributeOwner(const IAttribute* attr) const;
+        std::span<const IMessage* const> TransmittedMessages(std::size_t node) const;
+        std::span<const ISignal* const> ReceivedSignals(std::size_t node) const;
+
+    private:
+        std::unordered_map<const ISignal*, uint32_t> _signal_messages;
+        std::unordered_map<const IAttribute*, AttributeOwner> _attribute_owners;
+        // adjacency lists of the nodes, the entries of the i-th node are in [offsets[i], offsets[i + 1])
+        std::vector<uint32_t> _transmitted_offsets;
+        std::vector<const IMessage*> _transmitted_messages;
+        std::vector<uint32_t> _received_offsets;
+        std::vector<const ISignal*> _received_signals;
+    };
+}
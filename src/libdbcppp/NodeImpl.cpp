@@ -30,18 +30,22 @@ const std::string& NodeImpl::Name() const
 }
 const std::string& NodeImpl::Comment() const
 {
+    _lazy_metadata.Load();
     return _comment;
 }
 const IAttribute& NodeImpl::AttributeValues_Get(std::size_t i) const
 {
+    _lazy_metadata.Load();
     return _attribute_values[i];
 }
 uint64_t NodeImpl::AttributeValues_Size() const
 {
+    _lazy_metadata.Load();
     return _attribute_values.size();
 }
 bool NodeImpl::operator==(const INode& rhs) const
 {
+    _lazy_metadata.Load();
     bool equal = true;
     equal &= _name == rhs.Name();
     equal &= _comment == rhs.Comment();
@@ -56,4 +60,16 @@ bool NodeImpl::operator==(const INode& rhs) const
 bool NodeImpl::operator!=(const INode& rhs) const
 {
     return !(*this == rhs);
-}
\ No newline at end of file
+}
+std::string& NodeImpl::comment()
+{
+    return _comment;
+}
+std::vector<AttributeImpl>& NodeImpl::attributeValues()
+{
+    return _attribute_values;
+}
+void NodeImpl::SetLazyMetadata(const LazyMetadata* lazy)
+{
+    _lazy_metadata.Set(lazy);
+}
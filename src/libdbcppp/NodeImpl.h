@@ -5,6 +5,7 @@
 
 #include "../../include/dbcppp/Node.h"
 #include "AttributeImpl.h"
+#include "LazyMetadata.h"
 
 namespace dbcppp
 {
@@ -27,7 +28,13 @@ namespace dbcppp
         virtual bool operator==(const INode& rhs) const override;
         virtual bool operator!=(const INode& rhs) const override;
 
+        // don't load the lazy metadata, used to move it in
+        std::string& comment();
+        std::vector<AttributeImpl>& attributeValues();
+        void SetLazyMetadata(const LazyMetadata* lazy);
+
     private:
+        LazyMetadataRef _lazy_metadata;
         std::string _name;
         std::string _comment;
         std::vector<AttributeImpl> _attribute_values;
@@ -1,4 +1,20 @@
+#include <atomic>
 #include <limits>
+#include <cstring>
+#if defined(__x86_64__) || defined(_M_X64)
+// BMI2 and AVX2 kernels are compiled regardless of the target flags and only selected if the CPU supports them
+#   define DBCPPP_BMI2_KERNELS
+#   define DBCPPP_AVX2_KERNELS
+#   include <immintrin.h>
+#   if defined(_MSC_VER) && !defined(__clang__)
+#       include <intrin.h>
+#       define DBCPPP_TARGET_BMI2
+#       define DBCPPP_TARGET_AVX2
+#   else
+#       define DBCPPP_TARGET_BMI2 __attribute__((target("bmi2")))
+#       define DBCPPP_TARGET_AVX2 __attribute__((target("avx2")))
+#   endif
+#endif
 #include "Helper.h"
 #include "SignalImpl.h"
 
@@ -95,6 +111,100 @@ ISignal::raw_t template_decode(const ISignal* sig, const void* nbytes) noexcept
     return data;
 }
 
+#if defined(DBCPPP_AVX2_KERNELS)
+// decodes four frames at once, the steps are the same as in template_decode
+template <Alignment aAlignment, ISignal::EByteOrder aByteOrder, ISignal::EValueType aValueType, ISignal::EExtendedValueType aExtendedValueType>
+DBCPPP_TARGET_AVX2 inline __m256i avx2_decode(const SignalImpl* sigi, const uint8_t* base, __m256i vidx) noexcept
+{
+    const __m256i vbswap = _mm256_set_epi8(
+        8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7,
+        8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i vmask = _mm256_set1_epi64x(sigi->_mask);
+    const __m256i vmask_signed = _mm256_set1_epi64x(sigi->_mask_signed);
+    const __m128i vfsb0 = _mm_cvtsi64_si128(sigi->_fixed_start_bit_0);
+    __m256i data = _mm256_i64gather_epi64(reinterpret_cast<const long long*>(base), vidx, 1);
+    if constexpr (aAlignment == Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit)
+    {
+        const __m128i vfsb1 = _mm_cvtsi64_si128(sigi->_fixed_start_bit_1);
+        // the 9th byte is the most significant byte of the word starting one byte later
+        __m256i data1 = _mm256_i64gather_epi64(reinterpret_cast<const long long*>(base + 1), vidx, 1);
+        data1 = _mm256_srli_epi64(data1, 56);
+        if constexpr (aByteOrder == ISignal::EByteOrder::BigEndian)
+        {
+            data = _mm256_shuffle_epi8(data, vbswap);
+            data = _mm256_and_si256(data, vmask);
+            data = _mm256_sll_epi64(data, vfsb0);
+            data1 = _mm256_srl_epi64(data1, vfsb1);
+        }
+        else
+        {
+            data = _mm256_srl_epi64(data, vfsb0);
+            data1 = _mm256_and_si256(data1, vmask);
+            data1 = _mm256_sll_epi64(data1, vfsb1);
+        }
+        data = _mm256_or_si256(data, data1);
+        if constexpr (aExtendedValueType != ISignal::EExtendedValueType::Integer)
+        {
+            return data;
+        }
+    }
+    else
+    {
+        if constexpr (aByteOrder == ISignal::EByteOrder::BigEndian)
+        {
+            data = _mm256_shuffle_epi8(data, vbswap);
+        }
+        if constexpr (aExtendedValueType == ISignal::EExtendedValueType::Double)
+        {
+            return data;
+        }
+        data = _mm256_srl_epi64(data, vfsb0);
+        data = _mm256_and_si256(data, vmask);
+        if constexpr (aExtendedValueType == ISignal::EExtendedValueType::Float)
+        {
+            return data;
+        }
+    }
+    if constexpr (aValueType == ISignal::EValueType::Signed)
+    {
+        __m256i positive = _mm256_cmpeq_epi64(_mm256_and_si256(data, vmask_signed), _mm256_setzero_si256());
+        data = _mm256_or_si256(data, _mm256_andnot_si256(positive, vmask_signed));
+    }
+    return data;
+}
+// x86_64 is little endian, so the gathered words are in the byte order of the frames like in template_decode
+template <Alignment aAlignment, ISignal::EByteOrder aByteOrder, ISignal::EValueType aValueType, ISignal::EExtendedValueType aExtendedValueType>
+DBCPPP_TARGET_AVX2 void avx2_decode_column(const ISignal* sig, const uint8_t* frames, std::size_t stride, std::size_t n, ISignal::raw_t* out) noexcept
+{
+    const SignalImpl* sigi = static_cast<const SignalImpl*>(sig);
+    const uint8_t* base = frames + sigi->BytePos();
+    std::size_t i = 0;
+    const int64_t s = int64_t(stride);
+    const __m256i vstep = _mm256_set1_epi64x(4 * s);
+    __m256i vidx = _mm256_set_epi64x(3 * s, 2 * s, s, 0);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256i data = avx2_decode<aAlignment, aByteOrder, aValueType, aExtendedValueType>(sigi, base, vidx);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), data);
+        vidx = _mm256_add_epi64(vidx, vstep);
+    }
+    for (; i < n; i++)
+    {
+        out[i] = template_decode<aAlignment, aByteOrder, aValueType, aExtendedValueType>(sig, base + i * stride);
+    }
+}
+#endif
+template <Alignment aAlignment, ISignal::EByteOrder aByteOrder, ISignal::EValueType aValueType, ISignal::EExtendedValueType aExtendedValueType>
+void template_decode_column(const ISignal* sig, const uint8_t* frames, std::size_t stride, std::size_t n, ISignal::raw_t* out) noexcept
+{
+    const SignalImpl* sigi = static_cast<const SignalImpl*>(sig);
+    const uint8_t* base = frames + sigi->BytePos();
+    for (std::size_t i = 0; i < n; i++)
+    {
+        out[i] = template_decode<aAlignment, aByteOrder, aValueType, aExtendedValueType>(sig, base + i * stride);
+    }
+}
+
 constexpr uint64_t enum_mask(Alignment a, ISignal::EByteOrder bo, ISignal::EValueType vt, ISignal::EExtendedValueType evt)
 {
     uint64_t result = 0;
@@ -176,6 +286,144 @@ decode_func_t make_decode(Alignment a, ISignal::EByteOrder bo, ISignal::EValueTy
     }
     return nullptr;
 }
+using decode_column_func_t = void (*)(const ISignal*, const uint8_t*, std::size_t, std::size_t, ISignal::raw_t*) noexcept;
+decode_column_func_t make_decode_column(Alignment a, ISignal::EByteOrder bo, ISignal::EValueType vt, ISignal::EExtendedValueType evt)
+{
+    constexpr auto si64b            = Alignment::size_inbetween_first_64_bit;
+    constexpr auto se64bsbsfi64b    = Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit;
+    constexpr auto se64bsasdnfi64b  = Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit;
+    constexpr auto le               = ISignal::EByteOrder::LittleEndian;
+    constexpr auto be               = ISignal::EByteOrder::BigEndian;
+    constexpr auto sig              = ISignal::EValueType::Signed;
+    constexpr auto usig             = ISignal::EValueType::Unsigned;
+    constexpr auto i                = ISignal::EExtendedValueType::Integer;
+    constexpr auto f                = ISignal::EExtendedValueType::Float;
+    constexpr auto d                = ISignal::EExtendedValueType::Double;
+    switch (enum_mask(a, bo, vt, evt))
+    {
+    case enum_mask(si64b, le, sig, i):            return template_decode_column<si64b, le, sig, i>;
+    case enum_mask(si64b, le, sig, f):            return template_decode_column<si64b, le, sig, f>;
+    case enum_mask(si64b, le, sig, d):            return template_decode_column<si64b, le, sig, d>;
+    case enum_mask(si64b, le, usig, i):           return template_decode_column<si64b, le, usig, i>;
+    case enum_mask(si64b, le, usig, f):           return template_decode_column<si64b, le, usig, f>;
+    case enum_mask(si64b, le, usig, d):           return template_decode_column<si64b, le, usig, d>;
+    case enum_mask(si64b, be, sig, i):            return template_decode_column<si64b, be, sig, i>;
+    case enum_mask(si64b, be, sig, f):            return template_decode_column<si64b, be, sig, f>;
+    case enum_mask(si64b, be, sig, d):            return template_decode_column<si64b, be, sig, d>;
+    case enum_mask(si64b, be, usig, i):           return template_decode_column<si64b, be, usig, i>;
+    case enum_mask(si64b, be, usig, f):           return template_decode_column<si64b, be, usig, f>;
+    case enum_mask(si64b, be, usig, d):           return template_decode_column<si64b, be, usig, d>;
+    case enum_mask(se64bsbsfi64b, le, sig, i):    return template_decode_column<se64bsbsfi64b, le, sig, i>;
+    case enum_mask(se64bsbsfi64b, le, sig, f):    return template_decode_column<se64bsbsfi64b, le, sig, f>;
+    case enum_mask(se64bsbsfi64b, le, sig, d):    return template_decode_column<se64bsbsfi64b, le, sig, d>;
+    case enum_mask(se64bsbsfi64b, le, usig, i):   return template_decode_column<se64bsbsfi64b, le, usig, i>;
+    case enum_mask(se64bsbsfi64b, le, usig, f):   return template_decode_column<se64bsbsfi64b, le, usig, f>;
+    case enum_mask(se64bsbsfi64b, le, usig, d):   return template_decode_column<se64bsbsfi64b, le, usig, d>;
+    case enum_mask(se64bsbsfi64b, be, sig, i):    return template_decode_column<se64bsbsfi64b, be, sig, i>;
+    case enum_mask(se64bsbsfi64b, be, sig, f):    return template_decode_column<se64bsbsfi64b, be, sig, f>;
+    case enum_mask(se64bsbsfi64b, be, sig, d):    return template_decode_column<se64bsbsfi64b, be, sig, d>;
+    case enum_mask(se64bsbsfi64b, be, usig, i):   return template_decode_column<se64bsbsfi64b, be, usig, i>;
+    case enum_mask(se64bsbsfi64b, be, usig, f):   return template_decode_column<se64bsbsfi64b, be, usig, f>;
+    case enum_mask(se64bsbsfi64b, be, usig, d):   return template_decode_column<se64bsbsfi64b, be, usig, d>;
+    case enum_mask(se64bsasdnfi64b, le, sig, i):  return template_decode_column<se64bsasdnfi64b, le, sig, i>;
+    case enum_mask(se64bsasdnfi64b, le, sig, f):  return template_decode_column<se64bsasdnfi64b, le, sig, f>;
+    case enum_mask(se64bsasdnfi64b, le, sig, d):  return template_decode_column<se64bsasdnfi64b, le, sig, d>;
+    case enum_mask(se64bsasdnfi64b, le, usig, i): return template_decode_column<se64bsasdnfi64b, le, usig, i>;
+    case enum_mask(se64bsasdnfi64b, le, usig, f): return template_decode_column<se64bsasdnfi64b, le, usig, f>;
+    case enum_mask(se64bsasdnfi64b, le, usig, d): return template_decode_column<se64bsasdnfi64b, le, usig, d>;
+    case enum_mask(se64bsasdnfi64b, be, sig, i):  return template_decode_column<se64bsasdnfi64b, be, sig, i>;
+    case enum_mask(se64bsasdnfi64b, be, sig, f):  return template_decode_column<se64bsasdnfi64b, be, sig, f>;
+    case enum_mask(se64bsasdnfi64b, be, sig, d):  return template_decode_column<se64bsasdnfi64b, be, sig, d>;
+    case enum_mask(se64bsasdnfi64b, be, usig, i): return template_decode_column<se64bsasdnfi64b, be, usig, i>;
+    case enum_mask(se64bsasdnfi64b, be, usig, f): return template_decode_column<se64bsasdnfi64b, be, usig, f>;
+    case enum_mask(se64bsasdnfi64b, be, usig, d): return template_decode_column<se64bsasdnfi64b, be, usig, d>;
+    }
+    return nullptr;
+}
+#if defined(DBCPPP_AVX2_KERNELS)
+decode_column_func_t make_avx2_decode_column(Alignment a, ISignal::EByteOrder bo, ISignal::EValueType vt, ISignal::EExtendedValueType evt)
+{
+    constexpr auto si64b            = Alignment::size_inbetween_first_64_bit;
+    constexpr auto se64bsbsfi64b    = Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit;
+    constexpr auto se64bsasdnfi64b  = Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit;
+    constexpr auto le               = ISignal::EByteOrder::LittleEndian;
+    constexpr auto be               = ISignal::EByteOrder::BigEndian;
+    constexpr auto sig              = ISignal::EValueType::Signed;
+    constexpr auto usig             = ISignal::EValueType::Unsigned;
+    constexpr auto i                = ISignal::EExtendedValueType::Integer;
+    constexpr auto f                = ISignal::EExtendedValueType::Float;
+    constexpr auto d                = ISignal::EExtendedValueType::Double;
+    switch (enum_mask(a, bo, vt, evt))
+    {
+    case enum_mask(si64b, le, sig, i):            return avx2_decode_column<si64b, le, sig, i>;
+    case enum_mask(si64b, le, sig, f):            return avx2_decode_column<si64b, le, sig, f>;
+    case enum_mask(si64b, le, sig, d):            return avx2_decode_column<si64b, le, sig, d>;
+    case enum_mask(si64b, le, usig, i):           return avx2_decode_column<si64b, le, usig, i>;
+    case enum_mask(si64b, le, usig, f):           return avx2_decode_column<si64b, le, usig, f>;
+    case enum_mask(si64b, le, usig, d):           return avx2_decode_column<si64b, le, usig, d>;
+    case enum_mask(si64b, be, sig, i):            return avx2_decode_column<si64b, be, sig, i>;
+    case enum_mask(si64b, be, sig, f):            return avx2_decode_column<si64b, be, sig, f>;
+    case enum_mask(si64b, be, sig, d):            return avx2_decode_column<si64b, be, sig, d>;
+    case enum_mask(si64b, be, usig, i):           return avx2_decode_column<si64b, be, usig, i>;
+    case enum_mask(si64b, be, usig, f):           return avx2_decode_column<si64b, be, usig, f>;
+    case enum_mask(si64b, be, usig, d):           return avx2_decode_column<si64b, be, usig, d>;
+    case enum_mask(se64bsbsfi64b, le, sig, i):    return avx2_decode_column<se64bsbsfi64b, le, sig, i>;
+    case enum_mask(se64bsbsfi64b, le, sig, f):    return avx2_decode_column<se64bsbsfi64b, le, sig, f>;
+    case enum_mask(se64bsbsfi64b, le, sig, d):    return avx2_decode_column<se64bsbsfi64b, le, sig, d>;
+    case enum_mask(se64bsbsfi64b, le, usig, i):   return avx2_decode_column<se64bsbsfi64b, le, usig, i>;
+    case enum_mask(se64bsbsfi64b, le, usig, f):   return avx2_decode_column<se64bsbsfi64b, le, usig, f>;
+    case enum_mask(se64bsbsfi64b, le, usig, d):   return avx2_decode_column<se64bsbsfi64b, le, usig, d>;
+    case enum_mask(se64bsbsfi64b, be, sig, i):    return avx2_decode_column<se64bsbsfi64b, be, sig, i>;
+    case enum_mask(se64bsbsfi64b, be, sig, f):    return avx2_decode_column<se64bsbsfi64b, be, sig, f>;
+    case enum_mask(se64bsbsfi64b, be, sig, d):    return avx2_decode_column<se64bsbsfi64b, be, sig, d>;
+    case enum_mask(se64bsbsfi64b, be, usig, i):   return avx2_decode_column<se64bsbsfi64b, be, usig, i>;
+    case enum_mask(se64bsbsfi64b, be, usig, f):   return avx2_decode_column<se64bsbsfi64b, be, usig, f>;
+    case enum_mask(se64bsbsfi64b, be, usig, d):   return avx2_decode_column<se64bsbsfi64b, be, usig, d>;
+    case enum_mask(se64bsasdnfi64b, le, sig, i):  return avx2_decode_column<se64bsasdnfi64b, le, sig, i>;
+    case enum_mask(se64bsasdnfi64b, le, sig, f):  return avx2_decode_column<se64bsasdnfi64b, le, sig, f>;
+    case enum_mask(se64bsasdnfi64b, le, sig, d):  return avx2_decode_column<se64bsasdnfi64b, le, sig, d>;
+    case enum_mask(se64bsasdnfi64b, le, usig, i): return avx2_decode_column<se64bsasdnfi64b, le, usig, i>;
+    case enum_mask(se64bsasdnfi64b, le, usig, f): return avx2_decode_column<se64bsasdnfi64b, le, usig, f>;
+    case enum_mask(se64bsasdnfi64b, le, usig, d): return avx2_decode_column<se64bsasdnfi64b, le, usig, d>;
+    case enum_mask(se64bsasdnfi64b, be, sig, i):  return avx2_decode_column<se64bsasdnfi64b, be, sig, i>;
+    case enum_mask(se64bsasdnfi64b, be, sig, f):  return avx2_decode_column<se64bsasdnfi64b, be, sig, f>;
+    case enum_mask(se64bsasdnfi64b, be, sig, d):  return avx2_decode_column<se64bsasdnfi64b, be, sig, d>;
+    case enum_mask(se64bsasdnfi64b, be, usig, i): return avx2_decode_column<se64bsasdnfi64b, be, usig, i>;
+    case enum_mask(se64bsasdnfi64b, be, usig, f): return avx2_decode_column<se64bsasdnfi64b, be, usig, f>;
+    case enum_mask(se64bsasdnfi64b, be, usig, d): return avx2_decode_column<se64bsasdnfi64b, be, usig, d>;
+    }
+    return nullptr;
+}
+// whether the CPU and the OS support AVX2
+bool cpu_has_avx2() noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7)
+    {
+        return false;
+    }
+    __cpuid(regs, 1);
+    const bool osxsave_avx = (regs[2] & (1 << 27)) && (regs[2] & (1 << 28));
+    if (!osxsave_avx || (_xgetbv(0) & 0x6) != 0x6)
+    {
+        return false;
+    }
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+bool has_avx2() noexcept
+{
+    static const bool result = cpu_has_avx2();
+    return result;
+}
+std::atomic<bool> avx2_enabled{true};
+#endif
 decode_func_t make_decodeMuxSignal(Alignment a, ISignal::EByteOrder bo, ISignal::EValueType vt, ISignal::EExtendedValueType evt)
 {
     constexpr auto si64b            = Alignment::size_inbetween_first_64_bit;
@@ -207,54 +455,237 @@ decode_func_t make_decodeMuxSignal(Alignment a, ISignal::EByteOrder bo, ISignal:
     }
     return nullptr;
 }
-void encode(const ISignal* sig, ISignal::raw_t raw, void* buffer) noexcept
+// reads the word at the byte position for encoding, only the bytes the signal spans are read, the others are zero
+inline uint64_t load_span(const SignalImpl* sigi, const uint8_t* nbytes) noexcept
+{
+    uint64_t data = 0;
+    if (sigi->_span_size == 8)
+    {
+        std::memcpy(&data, nbytes, 8);
+    }
+    else
+    {
+        std::memcpy(reinterpret_cast<uint8_t*>(&data) + sigi->_span_offset, nbytes + sigi->_span_offset, sigi->_span_size);
+    }
+    return data;
+}
+// writes back only the bytes of the word which the signal spans, so the buffer only has to reach to its last byte
+inline void store_span(const SignalImpl* sigi, uint8_t* nbytes, uint64_t data) noexcept
+{
+    if (sigi->_span_size == 8)
+    {
+        std::memcpy(nbytes, &data, 8);
+    }
+    else
+    {
+        std::memcpy(nbytes + sigi->_span_offset, reinterpret_cast<const uint8_t*>(&data) + sigi->_span_offset, sigi->_span_size);
+    }
+}
+template <Alignment aAlignment, ISignal::EByteOrder aByteOrder>
+void template_encode(const ISignal* sig, ISignal::raw_t raw, void* buffer) noexcept
 {
     const SignalImpl* sigi = static_cast<const SignalImpl*>(sig);
-    char* b = reinterpret_cast<char*>(buffer);
-    if (sigi->ByteOrder() == ISignal::EByteOrder::BigEndian)
+    uint8_t* nbytes = reinterpret_cast<uint8_t*>(buffer) + sigi->BytePos();
+    uint64_t data;
+    if constexpr (aAlignment == Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit)
+    {
+        // the signal spans all nine bytes
+        std::memcpy(&data, nbytes, 8);
+    }
+    else
     {
-        uint64_t src = sigi->StartBit();
-        uint64_t dst = sigi->BitSize() - 1;
-        for (uint64_t i = 0; i < sigi->BitSize(); i++)
+        data = load_span(sigi, nbytes);
+    }
+    if constexpr (aByteOrder == ISignal::EByteOrder::BigEndian)
+    {
+        native_to_big_inplace(data);
+    }
+    else
+    {
+        native_to_little_inplace(data);
+    }
+    if constexpr (aAlignment == Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit)
+    {
+        // the inverse of the composition in template_decode
+        uint8_t data1 = nbytes[8];
+        uint8_t mask1;
+        if constexpr (aByteOrder == ISignal::EByteOrder::BigEndian)
         {
-            if (raw & (1ull << dst))
-            {
-                b[src / 8] |= 1ull << (src % 8);
-            }
-            else
-            {
-                b[src / 8] &= ~(1ull << (src % 8));
-            }
-            if ((src % 8) == 0)
-            {
-                src += 15;
-            }
-            else
-            {
-                src--;
-            }
-            dst--;
+            data &= ~sigi->_mask;
+            data |= (raw >> sigi->_fixed_start_bit_0) & sigi->_mask;
+            mask1 = uint8_t(((1u << sigi->_fixed_start_bit_0) - 1u) << sigi->_fixed_start_bit_1);
+            data1 = (data1 & ~mask1) | (uint8_t(raw << sigi->_fixed_start_bit_1) & mask1);
         }
+        else
+        {
+            data &= ~(~0ull << sigi->_fixed_start_bit_0);
+            data |= raw << sigi->_fixed_start_bit_0;
+            mask1 = uint8_t(sigi->_mask);
+            data1 = (data1 & ~mask1) | (uint8_t(raw >> sigi->_fixed_start_bit_1) & mask1);
+        }
+        nbytes[8] = data1;
     }
     else
     {
-        uint64_t src = sigi->StartBit();
-        uint64_t dst = 0;
-        for (uint64_t i = 0; i < sigi->BitSize(); i++)
+        data &= ~(sigi->_mask << sigi->_fixed_start_bit_0);
+        data |= (raw & sigi->_mask) << sigi->_fixed_start_bit_0;
+    }
+    if constexpr (aByteOrder == ISignal::EByteOrder::BigEndian)
+    {
+        big_to_native_inplace(data);
+    }
+    else
+    {
+        little_to_native_inplace(data);
+    }
+    if constexpr (aAlignment == Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit)
+    {
+        std::memcpy(nbytes, &data, 8);
+    }
+    else
+    {
+        store_span(sigi, nbytes, data);
+    }
+}
+using encode_func_t = void (*)(const ISignal*, ISignal::raw_t, void*) noexcept;
+encode_func_t make_encode(Alignment a, ISignal::EByteOrder bo)
+{
+    constexpr auto si64b            = Alignment::size_inbetween_first_64_bit;
+    constexpr auto se64bsbsfi64b    = Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit;
+    constexpr auto se64bsasdnfi64b  = Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit;
+    constexpr auto le               = ISignal::EByteOrder::LittleEndian;
+    constexpr auto be               = ISignal::EByteOrder::BigEndian;
+    // the value type doesn't matter for encoding, the raw value is masked anyway
+    switch (a)
+    {
+    case si64b:           return bo == le ? template_encode<si64b, le> : template_encode<si64b, be>;
+    case se64bsbsfi64b:   return bo == le ? template_encode<se64bsbsfi64b, le> : template_encode<se64bsbsfi64b, be>;
+    case se64bsasdnfi64b: return bo == le ? template_encode<se64bsasdnfi64b, le> : template_encode<se64bsasdnfi64b, be>;
+    }
+    return nullptr;
+}
+#if defined(DBCPPP_BMI2_KERNELS)
+// whether pext and pdep are available and fast, they are microcoded on AMD CPUs before Zen 3
+bool cpu_has_fast_bmi2() noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    __cpuid(regs, 0);
+    const bool amd = regs[1] == 0x68747541 && regs[3] == 0x69746E65 && regs[2] == 0x444D4163;
+    if (regs[0] < 7)
+    {
+        return false;
+    }
+    __cpuid(regs, 1);
+    const int family = ((regs[0] >> 8) & 0xF) + ((regs[0] >> 20) & 0xFF);
+    __cpuidex(regs, 7, 0);
+    const bool bmi2 = (regs[1] & (1 << 8)) != 0;
+    return bmi2 && !(amd && family < 0x19);
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("bmi2")
+        && !__builtin_cpu_is("amdfam15h")
+        && !__builtin_cpu_is("amdfam17h");
+#endif
+}
+bool has_fast_bmi2() noexcept
+{
+    static const bool result = cpu_has_fast_bmi2();
+    return result;
+}
+std::atomic<bool> bmi2_enabled{true};
+// extracts the bits of the signal with one pext instead of shifting and masking, the signal has to lie in the
+// first 64 bit at the byte position, big endian frames are byte swapped first like in template_decode
+template <ISignal::EByteOrder aByteOrder, ISignal::EValueType aValueType, ISignal::EExtendedValueType aExtendedValueType>
+DBCPPP_TARGET_BMI2 ISignal::raw_t bmi2_decode(const ISignal* sig, const void* nbytes) noexcept
+{
+    const SignalImpl* sigi = static_cast<const SignalImpl*>(sig);
+    uint64_t data = *reinterpret_cast<const uint64_t*>(nbytes);
+    if constexpr (aByteOrder == ISignal::EByteOrder::BigEndian)
+    {
+        native_to_big_inplace(data);
+    }
+    else
+    {
+        native_to_little_inplace(data);
+    }
+    data = _pext_u64(data, sigi->_pext_mask);
+    if constexpr (aExtendedValueType == ISignal::EExtendedValueType::Integer &&
+        aValueType == ISignal::EValueType::Signed)
+    {
+        if (data & sigi->_mask_signed)
         {
-            if (raw & (1ull << dst))
-            {
-                b[src / 8] |= 1ull << (src % 8);
-            }
-            else
-            {
-                b[src / 8] &= ~(1ull << (src % 8));
-            }
-            src++;
-            dst++;
+            data |= sigi->_mask_signed;
         }
     }
+    return data;
+}
+template <ISignal::EByteOrder aByteOrder>
+DBCPPP_TARGET_BMI2 void bmi2_encode(const ISignal* sig, ISignal::raw_t raw, void* buffer) noexcept
+{
+    const SignalImpl* sigi = static_cast<const SignalImpl*>(sig);
+    uint8_t* nbytes = reinterpret_cast<uint8_t*>(buffer) + sigi->BytePos();
+    uint64_t data = load_span(sigi, nbytes);
+    if constexpr (aByteOrder == ISignal::EByteOrder::BigEndian)
+    {
+        native_to_big_inplace(data);
+    }
+    else
+    {
+        native_to_little_inplace(data);
+    }
+    data = (data & ~sigi->_pext_mask) | _pdep_u64(raw, sigi->_pext_mask);
+    if constexpr (aByteOrder == ISignal::EByteOrder::BigEndian)
+    {
+        big_to_native_inplace(data);
+    }
+    else
+    {
+        little_to_native_inplace(data);
+    }
+    store_span(sigi, nbytes, data);
 }
+// returns nullptr for the signals which are left to the portable templates: the ones spanning nine bytes, which
+// would need a second pext, and doubles, which are returned without extracting anything
+decode_func_t make_bmi2_decode(Alignment a, ISignal::EByteOrder bo, ISignal::EValueType vt, ISignal::EExtendedValueType evt)
+{
+    constexpr auto si64b            = Alignment::size_inbetween_first_64_bit;
+    constexpr auto se64bsasdnfi64b  = Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit;
+    constexpr auto le               = ISignal::EByteOrder::LittleEndian;
+    constexpr auto be               = ISignal::EByteOrder::BigEndian;
+    constexpr auto sig              = ISignal::EValueType::Signed;
+    constexpr auto usig             = ISignal::EValueType::Unsigned;
+    constexpr auto i                = ISignal::EExtendedValueType::Integer;
+    constexpr auto f                = ISignal::EExtendedValueType::Float;
+    if (a == se64bsasdnfi64b)
+    {
+        return nullptr;
+    }
+    // both remaining alignments read the word at the byte position, so only the first one is switched on
+    switch (enum_mask(si64b, bo, vt, evt))
+    {
+    case enum_mask(si64b, le, sig, i):            return bmi2_decode<le, sig, i>;
+    case enum_mask(si64b, le, sig, f):            return bmi2_decode<le, sig, f>;
+    case enum_mask(si64b, le, usig, i):           return bmi2_decode<le, usig, i>;
+    case enum_mask(si64b, le, usig, f):           return bmi2_decode<le, usig, f>;
+    case enum_mask(si64b, be, sig, i):            return bmi2_decode<be, sig, i>;
+    case enum_mask(si64b, be, sig, f):            return bmi2_decode<be, sig, f>;
+    case enum_mask(si64b, be, usig, i):           return bmi2_decode<be, usig, i>;
+    case enum_mask(si64b, be, usig, f):           return bmi2_decode<be, usig, f>;
+    }
+    return nullptr;
+}
+encode_func_t make_bmi2_encode(Alignment a, ISignal::EByteOrder bo)
+{
+    if (a == Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit)
+    {
+        return nullptr;
+    }
+    return bo == ISignal::EByteOrder::LittleEndian
+        ? bmi2_encode<ISignal::EByteOrder::LittleEndian>
+        : bmi2_encode<ISignal::EByteOrder::BigEndian>;
+}
+#endif
 template <class T>
 double raw_to_phys(const ISignal* sig, ISignal::raw_t raw) noexcept
 {
@@ -373,6 +804,7 @@ SignalImpl::SignalImpl(
     , _signal_multiplexer_values(std::move(signal_multiplexer_values))
     , _error(EErrorCode::NoError)
 {
+    _value_description_index.Build(_value_encoding_descriptions);
     message_size = message_size < 8 ? 8 : message_size;
     // check for out of frame size error
     switch (byte_order)
@@ -490,8 +922,31 @@ SignalImpl::SignalImpl(
         }
     }
 
+    // the bytes of the word at the byte position which the signal spans
+    _span_offset = _start_bit / 8 - _byte_pos;
+    _span_size = nbytes;
+
     _decode = ::make_decode(alignment, _byte_order, _value_type, _extended_value_type);
-    _encode = ::encode;
+    _decode_column = ::make_decode_column(alignment, _byte_order, _value_type, _extended_value_type);
+    _encode = ::make_encode(alignment, _byte_order);
+    _pext_mask = 0;
+#if defined(DBCPPP_AVX2_KERNELS)
+    if (::has_avx2() && ::avx2_enabled.load(std::memory_order_relaxed))
+    {
+        _decode_column = ::make_avx2_decode_column(alignment, _byte_order, _value_type, _extended_value_type);
+    }
+#endif
+#if defined(DBCPPP_BMI2_KERNELS)
+    if (::has_fast_bmi2() && ::bmi2_enabled.load(std::memory_order_relaxed) && alignment != Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit)
+    {
+        _pext_mask = _mask << _fixed_start_bit_0;
+        if (auto decode = ::make_bmi2_decode(alignment, _byte_order, _value_type, _extended_value_type))
+        {
+            _decode = decode;
+        }
+        _encode = ::make_bmi2_encode(alignment, _byte_order);
+    }
+#endif
     switch (_extended_value_type)
     {
     case EExtendedValueType::Integer:
@@ -517,6 +972,24 @@ SignalImpl::SignalImpl(
         break;
     }
 }
+bool SignalImpl::EnableBMI2Kernels(bool enable) noexcept
+{
+#if defined(DBCPPP_BMI2_KERNELS)
+    ::bmi2_enabled.store(enable, std::memory_order_relaxed);
+    return enable && ::has_fast_bmi2();
+#else
+    return false;
+#endif
+}
+bool SignalImpl::EnableAVX2Kernels(bool enable) noexcept
+{
+#if defined(DBCPPP_AVX2_KERNELS)
+    ::avx2_enabled.store(enable, std::memory_order_relaxed);
+    return enable && ::has_avx2();
+#else
+    return false;
+#endif
+}
 std::unique_ptr<ISignal> SignalImpl::Clone() const
 {
     return std::make_unique<SignalImpl>(*this);
@@ -585,16 +1058,29 @@ uint64_t SignalImpl::ValueEncodingDescriptions_Size() const
 {
     return _value_encoding_descriptions.size();
 }
+const IValueEncodingDescription* SignalImpl::ValueEncodingDescriptionByValue(int64_t value) const
+{
+    uint32_t i = _value_description_index.FindValue(value);
+    return i != ValueDescriptionIndex::npos ? &_value_encoding_descriptions[i] : nullptr;
+}
+const IValueEncodingDescription* SignalImpl::ValueEncodingDescriptionByDescription(std::string_view description) const
+{
+    uint32_t i = _value_description_index.FindDescription(_value_encoding_descriptions, description);
+    return i != ValueDescriptionIndex::npos ? &_value_encoding_descriptions[i] : nullptr;
+}
 const IAttribute& SignalImpl::AttributeValues_Get(std::size_t i) const
 {
+    _lazy_metadata.Load();
     return _attribute_values[i];
 }
 uint64_t SignalImpl::AttributeValues_Size() const
 {
+    _lazy_metadata.Load();
     return _attribute_values.size();
 }
 const std::string& SignalImpl::Comment() const
 {
+    _lazy_metadata.Load();
     return _comment;
 }
 ISignal::EExtendedValueType SignalImpl::ExtendedValueType() const
@@ -619,6 +1105,7 @@ void SignalImpl::SetError(EErrorCode code)
 }
 bool SignalImpl::operator==(const ISignal& rhs) const
 {
+    _lazy_metadata.Load();
     bool equal = true;
     equal &= _name == rhs.Name();
     equal &= _multiplexer_indicator == rhs.MultiplexerIndicator();
@@ -663,4 +1150,16 @@ bool SignalImpl::operator==(const ISignal& rhs) const
 bool SignalImpl::operator!=(const ISignal& rhs) const
 {
     return !(*this == rhs);
-}
\ No newline at end of file
+}
+std::string& SignalImpl::comment()
+{
+    return _comment;
+}
+std::vector<AttributeImpl>& SignalImpl::attributeValues()
+{
+    return _attribute_values;
+}
+void SignalImpl::SetLazyMetadata(const LazyMetadata* lazy)
+{
+    _lazy_metadata.Set(lazy);
+}
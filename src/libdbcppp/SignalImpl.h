@@ -6,8 +6,10 @@
 #include <dbcppp/Signal.h>
 #include <dbcppp/Node.h>
 #include "AttributeImpl.h"
+#include "LazyMetadata.h"
 #include "SignalMultiplexerValueImpl.h"
 #include "ValueEncodingDescriptionImpl.h"
+#include "ValueDescriptionIndex.h"
 
 namespace dbcppp
 {
@@ -54,6 +56,8 @@ namespace dbcppp
         virtual uint64_t Receivers_Size() const override;
         virtual const IValueEncodingDescription& ValueEncodingDescriptions_Get(std::size_t i) const override;
         virtual uint64_t ValueEncodingDescriptions_Size() const override;
+        virtual const IValueEncodingDescription* ValueEncodingDescriptionByValue(int64_t value) const override;
+        virtual const IValueEncodingDescription* ValueEncodingDescriptionByDescription(std::string_view description) const override;
         virtual const IAttribute& AttributeValues_Get(std::size_t i) const override;
         virtual uint64_t AttributeValues_Size() const override;
         virtual const std::string& Comment() const override;
@@ -65,9 +69,21 @@ namespace dbcppp
         virtual bool operator==(const ISignal& rhs) const override;
         virtual bool operator!=(const ISignal& rhs) const override;
 
+        // don't load the lazy metadata, used to move it in
+        std::string& comment();
+        std::vector<AttributeImpl>& attributeValues();
+        void SetLazyMetadata(const LazyMetadata* lazy);
+
+        // selects the BMI2 kernels for the signals created afterwards if the CPU supports them, they are enabled by
+        // default, returns whether they are used, lets the tests and benchmarks compare them to the portable ones
+        static bool EnableBMI2Kernels(bool enable) noexcept;
+        // the same for the AVX2 kernels of DecodeColumn
+        static bool EnableAVX2Kernels(bool enable) noexcept;
+
     private:
         void SetError(EErrorCode code);
 
+        LazyMetadataRef _lazy_metadata;
         std::string _name;
         EMultiplexer _multiplexer_indicator;
         uint64_t _multiplexer_switch_value;
@@ -83,6 +99,7 @@ namespace dbcppp
         std::vector<std::string> _receivers;
         std::vector<AttributeImpl> _attribute_values;
         std::vector<ValueEncodingDescriptionImpl> _value_encoding_descriptions;
+        ValueDescriptionIndex _value_description_index;
         std::string _comment;
         EExtendedValueType _extended_value_type;
         std::vector<SignalMultiplexerValueImpl> _signal_multiplexer_values;
@@ -93,6 +110,11 @@ namespace dbcppp
         uint64_t _mask_signed;
         uint64_t _fixed_start_bit_0;
         uint64_t _fixed_start_bit_1;
+        // the bytes of the signal relative to the byte position, Encode doesn't touch the others
+        uint64_t _span_offset;
+        uint64_t _span_size;
+        // the bits of the signal in the word at the byte position, only used by the BMI2 kernels
+        uint64_t _pext_mask;
 
         EErrorCode _error;
     };
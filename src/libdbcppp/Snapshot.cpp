@@ -0,0 +1,1096 @@
+#include <array>
+#include <string>
+#include <vector>
+#include <random>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include "../../include/dbcppp/CApi.h"
+#include "Snapshot.h"
+#include "MappedFile.h"
+#include "NetworkImpl.h"
+#include "CompiledNetworkImpl.h"
+
+using namespace dbcppp;
+
+namespace dbcppp
+{
+    enum class ESnapshotSection
+        : uint32_t
+    {
+        Strings,
+        Model,
+        Messages,
+        Signals,
+        Groups,
+        MessageNames,
+        SignalNames,
+        Units,
+        ExtendedMux,
+        Count
+    };
+    struct SnapshotSection
+    {
+        uint64_t offset;
+        uint64_t size;
+    };
+    struct SnapshotHeader
+    {
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint32_t byte_order_mark;
+        uint64_t file_size;
+        uint64_t dbc_hash;
+        // hash of everything behind the header
+        uint64_t checksum;
+        uint32_t descriptor_size;
+        uint32_t message_record_size;
+        std::array<SnapshotSection, std::size_t(ESnapshotSection::Count)> sections;
+
+        const SnapshotSection& Get(ESnapshotSection section) const
+        {
+            return sections[std::size_t(section)];
+        }
+    };
+    // reference into the string pool
+    struct SnapshotStringRef
+    {
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    class SnapshotWriter
+    {
+    public:
+        template <class T>
+        void Write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            WriteBytes(&value, sizeof(T));
+        }
+        void WriteBytes(const void* data, std::size_t size)
+        {
+            _stream.append(static_cast<const char*>(data), size);
+        }
+        void WriteSize(std::size_t size)
+        {
+            Write(uint64_t(size));
+        }
+        void WriteString(std::string_view str)
+        {
+            Write(Intern(str));
+        }
+        // strings are stored once in the string pool
+        SnapshotStringRef Intern(std::string_view str)
+        {
+            auto iter = _interned.find(std::string(str));
+            if (iter != _interned.end())
+            {
+                return iter->second;
+            }
+            if (_strings.size() + str.size() > std::numeric_limits<uint32_t>::max())
+            {
+                _overflow = true;
+                return {0, 0};
+            }
+            SnapshotStringRef ref{uint32_t(_strings.size()), uint32_t(str.size())};
+            _strings.append(str);
+            _interned.emplace(std::string(str), ref);
+            return ref;
+        }
+        // moves everything written since the last call into the section
+        void EndSection(ESnapshotSection section)
+        {
+            _sections[std::size_t(section)] = std::move(_stream);
+            _stream.clear();
+        }
+        bool Finish(const std::filesystem::path& filename, uint64_t dbc_hash);
+
+    private:
+        std::string _stream;
+        std::array<std::string, std::size_t(ESnapshotSection::Count)> _sections;
+        std::string _strings;
+        std::unordered_map<std::string, SnapshotStringRef> _interned;
+        bool _overflow = false;
+    };
+
+    class SnapshotReader
+    {
+    public:
+        // validates the header and the checksum
+        bool Open(std::shared_ptr<const MappedFile> file, uint64_t dbc_hash);
+        std::string_view Section(ESnapshotSection section) const
+        {
+            const auto& s = _header->Get(section);
+            return {_file->data() + s.offset, std::size_t(s.size)};
+        }
+        template <class T>
+        bool Array(ESnapshotSection section, std::span<const T>& result) const
+        {
+            auto data = Section(section);
+            if (data.size() % sizeof(T) != 0)
+            {
+                return false;
+            }
+            result = {reinterpret_cast<const T*>(data.data()), data.size() / sizeof(T)};
+            return true;
+        }
+        bool String(SnapshotStringRef ref, std::string_view& result) const
+        {
+            auto strings = Section(ESnapshotSection::Strings);
+            if (uint64_t(ref.offset) + ref.size > strings.size())
+            {
+                return false;
+            }
+            result = strings.substr(ref.offset, ref.size);
+            return true;
+        }
+        const std::shared_ptr<const MappedFile>& File() const
+        {
+            return _file;
+        }
+
+    private:
+        std::shared_ptr<const MappedFile> _file;
+        const SnapshotHeader* _header = nullptr;
+    };
+}
+
+namespace
+{
+    constexpr std::array<char, 8> snapshot_magic = {'D', 'B', 'C', 'P', 'P', 'S', 'N', 'P'};
+    // has to be incremented with every change of the format or of the compiled network
+    constexpr uint32_t snapshot_version = 1;
+    constexpr uint32_t byte_order_mark = 0x01020304;
+    constexpr uint64_t section_alignment = 64;
+
+    // sequential reader for the sections which aren't used in place
+    class SnapshotStream
+    {
+    public:
+        SnapshotStream(const SnapshotReader& reader, std::string_view data)
+            : _reader(reader)
+            , _cur(data.data())
+            , _end(data.data() + data.size())
+        {}
+        template <class T>
+        T Read()
+        {
+            T value{};
+            if (std::size_t(_end - _cur) < sizeof(T))
+            {
+                _ok = false;
+                return value;
+            }
+            std::memcpy(&value, _cur, sizeof(T));
+            _cur += sizeof(T);
+            return value;
+        }
+        // every element occupies at least one byte, so bigger sizes can only come from a corrupted snapshot
+        std::size_t ReadSize()
+        {
+            uint64_t size = Read<uint64_t>();
+            if (size > uint64_t(_end - _cur))
+            {
+                _ok = false;
+                return 0;
+            }
+            return std::size_t(size);
+        }
+        std::string ReadString()
+        {
+            std::string_view str;
+            if (!_reader.String(Read<SnapshotStringRef>(), str))
+            {
+                _ok = false;
+            }
+            return std::string(str);
+        }
+        std::vector<std::string> ReadStrings()
+        {
+            std::vector<std::string> result(ReadSize());
+            for (auto& str : result)
+            {
+                str = ReadString();
+            }
+            return result;
+        }
+        bool Ok() const
+        {
+            return _ok;
+        }
+        bool AtEnd() const
+        {
+            return _cur == _end;
+        }
+
+    private:
+        const SnapshotReader& _reader;
+        const char* _cur;
+        const char* _end;
+        bool _ok = true;
+    };
+
+    template <class Get, class WriteElement>
+    void write_seq(SnapshotWriter& w, std::size_t size, Get&& get, WriteElement&& write_element)
+    {
+        w.WriteSize(size);
+        for (std::size_t i = 0; i < size; i++)
+        {
+            write_element(w, get(i));
+        }
+    }
+    template <class T, class ReadElement>
+    std::vector<T> read_seq(SnapshotStream& s, ReadElement&& read_element)
+    {
+        std::vector<T> result(s.ReadSize());
+        for (auto& e : result)
+        {
+            e = read_element(s);
+        }
+        return result;
+    }
+    void write_strings(SnapshotWriter& w, std::size_t size, const std::function<const std::string&(std::size_t)>& get)
+    {
+        w.WriteSize(size);
+        for (std::size_t i = 0; i < size; i++)
+        {
+            w.WriteString(get(i));
+        }
+    }
+
+    void write_ved(SnapshotWriter& w, const IValueEncodingDescription& ved)
+    {
+        w.Write(int64_t(ved.Value()));
+        w.WriteString(ved.Description());
+    }
+    std::unique_ptr<IValueEncodingDescription> read_ved(SnapshotStream& s)
+    {
+        auto value = s.Read<int64_t>();
+        return IValueEncodingDescription::Create(value, s.ReadString());
+    }
+    void write_attribute(SnapshotWriter& w, const IAttribute& attr)
+    {
+        w.WriteString(attr.Name());
+        w.Write(uint32_t(attr.ObjectType()));
+        w.Write(uint32_t(attr.Value().which()));
+        switch (attr.Value().which())
+        {
+        case 0: w.Write(boost::get<int64_t>(attr.Value())); break;
+        case 1: w.Write(boost::get<double>(attr.Value())); break;
+        case 2: w.WriteString(boost::get<std::string>(attr.Value())); break;
+        }
+    }
+    std::unique_ptr<IAttribute> read_attribute(SnapshotStream& s)
+    {
+        auto name = s.ReadString();
+        auto object_type = IAttributeDefinition::EObjectType(s.Read<uint32_t>());
+        IAttribute::value_t value;
+        switch (s.Read<uint32_t>())
+        {
+        case 0: value = s.Read<int64_t>(); break;
+        case 1: value = s.Read<double>(); break;
+        case 2: value = s.ReadString(); break;
+        }
+        return IAttribute::Create(std::move(name), object_type, std::move(value));
+    }
+    void write_attribute_definition(SnapshotWriter& w, const IAttributeDefinition& ad)
+    {
+        w.WriteString(ad.Name());
+        w.Write(uint32_t(ad.ObjectType()));
+        w.Write(uint32_t(ad.ValueType().index()));
+        std::visit(
+            [&](const auto& vt)
+            {
+                using T = std::decay_t<decltype(vt)>;
+                if constexpr (std::is_same_v<T, IAttributeDefinition::ValueTypeEnum>)
+                {
+                    write_strings(w, vt.values.size(), [&](std::size_t i) -> const std::string& { return vt.values[i]; });
+                }
+                else if constexpr (!std::is_same_v<T, IAttributeDefinition::ValueTypeString>)
+                {
+                    w.Write(vt.minimum);
+                    w.Write(vt.maximum);
+                }
+            }, ad.ValueType());
+    }
+    std::unique_ptr<IAttributeDefinition> read_attribute_definition(SnapshotStream& s)
+    {
+        auto name = s.ReadString();
+        auto object_type = IAttributeDefinition::EObjectType(s.Read<uint32_t>());
+        IAttributeDefinition::value_type_t value_type;
+        switch (s.Read<uint32_t>())
+        {
+        case 0:
+        {
+            IAttributeDefinition::ValueTypeInt vt;
+            vt.minimum = s.Read<int64_t>();
+            vt.maximum = s.Read<int64_t>();
+            value_type = vt;
+            break;
+        }
+        case 1:
+        {
+            IAttributeDefinition::ValueTypeHex vt;
+            vt.minimum = s.Read<int64_t>();
+            vt.maximum = s.Read<int64_t>();
+            value_type = vt;
+            break;
+        }
+        case 2:
+        {
+            IAttributeDefinition::ValueTypeFloat vt;
+            vt.minimum = s.Read<double>();
+            vt.maximum = s.Read<double>();
+            value_type = vt;
+            break;
+        }
+        case 3:
+            value_type = IAttributeDefinition::ValueTypeString{};
+            break;
+        case 4:
+            value_type = IAttributeDefinition::ValueTypeEnum{s.ReadStrings()};
+            break;
+        }
+        return IAttributeDefinition::Create(std::move(name), object_type, std::move(value_type));
+    }
+    void write_signal(SnapshotWriter& w, const ISignal& sig)
+    {
+        w.WriteString(sig.Name());
+        w.Write(uint32_t(sig.MultiplexerIndicator()));
+        w.Write(uint64_t(sig.MultiplexerSwitchValue()));
+        w.Write(uint64_t(sig.StartBit()));
+        w.Write(uint64_t(sig.BitSize()));
+        w.Write(uint32_t(sig.ByteOrder()));
+        w.Write(uint32_t(sig.ValueType()));
+        w.Write(sig.Factor());
+        w.Write(sig.Offset());
+        w.Write(sig.Minimum());
+        w.Write(sig.Maximum());
+        w.WriteString(sig.Unit());
+        write_strings(w, sig.Receivers_Size(), [&](std::size_t i) -> const std::string& { return sig.Receivers_Get(i); });
+        write_seq(w, sig.AttributeValues_Size(),
+            [&](std::size_t i) -> const IAttribute& { return sig.AttributeValues_Get(i); }, write_attribute);
+        write_seq(w, sig.ValueEncodingDescriptions_Size(),
+            [&](std::size_t i) -> const IValueEncodingDescription& { return sig.ValueEncodingDescriptions_Get(i); }, write_ved);
+        w.WriteString(sig.Comment());
+        w.Write(uint32_t(sig.ExtendedValueType()));
+        w.WriteSize(sig.SignalMultiplexerValues_Size());
+        for (const auto& smv : sig.SignalMultiplexerValues())
+        {
+            w.WriteString(smv.SwitchName());
+            w.WriteSize(smv.ValueRanges_Size());
+            for (const auto& r : smv.ValueRanges())
+            {
+                w.Write(uint64_t(r.from));
+                w.Write(uint64_t(r.to));
+            }
+        }
+    }
+    std::unique_ptr<ISignal> read_signal(SnapshotStream& s, uint64_t message_size)
+    {
+        auto name = s.ReadString();
+        auto multiplexer_indicator = ISignal::EMultiplexer(s.Read<uint32_t>());
+        auto multiplexer_switch_value = s.Read<uint64_t>();
+        auto start_bit = s.Read<uint64_t>();
+        auto bit_size = s.Read<uint64_t>();
+        auto byte_order = ISignal::EByteOrder(s.Read<uint32_t>());
+        auto value_type = ISignal::EValueType(s.Read<uint32_t>());
+        auto factor = s.Read<double>();
+        auto offset = s.Read<double>();
+        auto minimum = s.Read<double>();
+        auto maximum = s.Read<double>();
+        auto unit = s.ReadString();
+        auto receivers = s.ReadStrings();
+        auto attribute_values = read_seq<std::unique_ptr<IAttribute>>(s, read_attribute);
+        auto value_encoding_descriptions = read_seq<std::unique_ptr<IValueEncodingDescription>>(s, read_ved);
+        auto comment = s.ReadString();
+        auto extended_value_type = ISignal::EExtendedValueType(s.Read<uint32_t>());
+        auto signal_multiplexer_values = read_seq<std::unique_ptr<ISignalMultiplexerValue>>(s,
+            [](SnapshotStream& s)
+            {
+                auto switch_name = s.ReadString();
+                std::vector<ISignalMultiplexerValue::Range> value_ranges(s.ReadSize());
+                for (auto& r : value_ranges)
+                {
+                    r.from = std::size_t(s.Read<uint64_t>());
+                    r.to = std::size_t(s.Read<uint64_t>());
+                }
+                return ISignalMultiplexerValue::Create(std::move(switch_name), std::move(value_ranges));
+            });
+        if (!s.Ok())
+        {
+            return nullptr;
+        }
+        return ISignal::Create(
+              message_size
+            , std::move(name)
+            , multiplexer_indicator
+            , multiplexer_switch_value
+            , start_bit
+            , bit_size
+            , byte_order
+            , value_type
+            , factor
+            , offset
+            , minimum
+            , maximum
+            , std::move(unit)
+            , std::move(receivers)
+            , std::move(attribute_values)
+            , std::move(value_encoding_descriptions)
+            , std::move(comment)
+            , extended_value_type
+            , std::move(signal_multiplexer_values));
+    }
+    void write_message(SnapshotWriter& w, const IMessage& msg)
+    {
+        w.Write(uint64_t(msg.Id()));
+        w.WriteString(msg.Name());
+        w.Write(uint64_t(msg.MessageSize()));
+        w.WriteString(msg.Transmitter());
+        write_strings(w, msg.MessageTransmitters_Size(), [&](std::size_t i) -> const std::string& { return msg.MessageTransmitters_Get(i); });
+        write_seq(w, msg.Signals_Size(),
+            [&](std::size_t i) -> const ISignal& { return msg.Signals_Get(i); }, write_signal);
+        write_seq(w, msg.AttributeValues_Size(),
+            [&](std::size_t i) -> const IAttribute& { return msg.AttributeValues_Get(i); }, write_attribute);
+        w.WriteString(msg.Comment());
+        w.WriteSize(msg.SignalGroups_Size());
+        for (const auto& sg : msg.SignalGroups())
+        {
+            w.Write(uint64_t(sg.MessageId()));
+            w.WriteString(sg.Name());
+            w.Write(uint64_t(sg.Repetitions()));
+            write_strings(w, sg.SignalNames_Size(), [&](std::size_t i) -> const std::string& { return sg.SignalNames_Get(i); });
+        }
+    }
+    std::unique_ptr<IMessage> read_message(SnapshotStream& s)
+    {
+        auto id = s.Read<uint64_t>();
+        auto name = s.ReadString();
+        auto message_size = s.Read<uint64_t>();
+        auto transmitter = s.ReadString();
+        auto message_transmitters = s.ReadStrings();
+        auto signals = read_seq<std::unique_ptr<ISignal>>(s,
+            [&](SnapshotStream& s) { return read_signal(s, message_size); });
+        auto attribute_values = read_seq<std::unique_ptr<IAttribute>>(s, read_attribute);
+        auto comment = s.ReadString();
+        auto signal_groups = read_seq<std::unique_ptr<ISignalGroup>>(s,
+            [](SnapshotStream& s)
+            {
+                auto message_id = s.Read<uint64_t>();
+                auto name = s.ReadString();
+                auto repetitions = s.Read<uint64_t>();
+                return ISignalGroup::Create(message_id, std::move(name), repetitions, s.ReadStrings());
+            });
+        if (!s.Ok())
+        {
+            return nullptr;
+        }
+        return IMessage::Create(
+              id
+            , std::move(name)
+            , message_size
+            , std::move(transmitter)
+            , std::move(message_transmitters)
+            , std::move(signals)
+            , std::move(attribute_values)
+            , std::move(comment)
+            , std::move(signal_groups));
+    }
+    void write_node(SnapshotWriter& w, const INode& node)
+    {
+        w.WriteString(node.Name());
+        w.WriteString(node.Comment());
+        write_seq(w, node.AttributeValues_Size(),
+            [&](std::size_t i) -> const IAttribute& { return node.AttributeValues_Get(i); }, write_attribute);
+    }
+    std::unique_ptr<INode> read_node(SnapshotStream& s)
+    {
+        auto name = s.ReadString();
+        auto comment = s.ReadString();
+        auto attribute_values = read_seq<std::unique_ptr<IAttribute>>(s, read_attribute);
+        return INode::Create(std::move(name), std::move(comment), std::move(attribute_values));
+    }
+    void write_value_table(SnapshotWriter& w, const IValueTable& vt)
+    {
+        w.WriteString(vt.Name());
+        auto st = vt.SignalType();
+        w.Write(uint8_t(st.has_value()));
+        if (st)
+        {
+            const ISignalType& t = *st;
+            w.WriteString(t.Name());
+            w.Write(uint64_t(t.SignalSize()));
+            w.Write(uint32_t(t.ByteOrder()));
+            w.Write(uint32_t(t.ValueType()));
+            w.Write(t.Factor());
+            w.Write(t.Offset());
+            w.Write(t.Minimum());
+            w.Write(t.Maximum());
+            w.WriteString(t.Unit());
+            w.Write(t.DefaultValue());
+            w.WriteString(t.ValueTable());
+        }
+        write_seq(w, vt.ValueEncodingDescriptions_Size(),
+            [&](std::size_t i) -> const IValueEncodingDescription& { return vt.ValueEncodingDescriptions_Get(i); }, write_ved);
+    }
+    std::unique_ptr<IValueTable> read_value_table(SnapshotStream& s)
+    {
+        auto name = s.ReadString();
+        std::optional<std::unique_ptr<ISignalType>> signal_type;
+        if (s.Read<uint8_t>())
+        {
+            auto st_name = s.ReadString();
+            auto signal_size = s.Read<uint64_t>();
+            auto byte_order = ISignal::EByteOrder(s.Read<uint32_t>());
+            auto value_type = ISignal::EValueType(s.Read<uint32_t>());
+            auto factor = s.Read<double>();
+            auto offset = s.Read<double>();
+            auto minimum = s.Read<double>();
+            auto maximum = s.Read<double>();
+            auto unit = s.ReadString();
+            auto default_value = s.Read<double>();
+            auto value_table = s.ReadString();
+            signal_type = ISignalType::Create(
+                  std::move(st_name)
+                , signal_size
+                , byte_order
+                , value_type
+                , factor
+                , offset
+                , minimum
+                , maximum
+                , std::move(unit)
+                , default_value
+                , std::move(value_table));
+        }
+        auto value_encoding_descriptions = read_seq<std::unique_ptr<IValueEncodingDescription>>(s, read_ved);
+        return IValueTable::Create(std::move(name), std::move(signal_type), std::move(value_encoding_descriptions));
+    }
+    void write_environment_variable(SnapshotWriter& w, const IEnvironmentVariable& ev)
+    {
+        w.WriteString(ev.Name());
+        w.Write(uint32_t(ev.VarType()));
+        w.Write(ev.Minimum());
+        w.Write(ev.Maximum());
+        w.WriteString(ev.Unit());
+        w.Write(ev.InitialValue());
+        w.Write(uint64_t(ev.EvId()));
+        w.Write(uint32_t(ev.AccessType()));
+        write_strings(w, ev.AccessNodes_Size(), [&](std::size_t i) -> const std::string& { return ev.AccessNodes_Get(i); });
+        write_seq(w, ev.ValueEncodingDescriptions_Size(),
+            [&](std::size_t i) -> const IValueEncodingDescription& { return ev.ValueEncodingDescriptions_Get(i); }, write_ved);
+        w.Write(uint64_t(ev.DataSize()));
+        write_seq(w, ev.AttributeValues_Size(),
+            [&](std::size_t i) -> const IAttribute& { return ev.AttributeValues_Get(i); }, write_attribute);
+        w.WriteString(ev.Comment());
+    }
+    std::unique_ptr<IEnvironmentVariable> read_environment_variable(SnapshotStream& s)
+    {
+        auto name = s.ReadString();
+        auto var_type = IEnvironmentVariable::EVarType(s.Read<uint32_t>());
+        auto minimum = s.Read<double>();
+        auto maximum = s.Read<double>();
+        auto unit = s.ReadString();
+        auto initial_value = s.Read<double>();
+        auto ev_id = s.Read<uint64_t>();
+        auto access_type = IEnvironmentVariable::EAccessType(s.Read<uint32_t>());
+        auto access_nodes = s.ReadStrings();
+        auto value_encoding_descriptions = read_seq<std::unique_ptr<IValueEncodingDescription>>(s, read_ved);
+        auto data_size = s.Read<uint64_t>();
+        auto attribute_values = read_seq<std::unique_ptr<IAttribute>>(s, read_attribute);
+        auto comment = s.ReadString();
+        return IEnvironmentVariable::Create(
+              std::move(name)
+            , var_type
+            , minimum
+            , maximum
+            , std::move(unit)
+            , initial_value
+            , ev_id
+            , access_type
+            , std::move(access_nodes)
+            , std::move(value_encoding_descriptions)
+            , data_size
+            , std::move(attribute_values)
+            , std::move(comment));
+    }
+    void write_network(SnapshotWriter& w, const INetwork& net)
+    {
+        w.WriteString(net.Version());
+        write_strings(w, net.NewSymbols_Size(), [&](std::size_t i) -> const std::string& { return net.NewSymbols_Get(i); });
+        w.Write(uint64_t(net.BitTiming().Baudrate()));
+        w.Write(uint64_t(net.BitTiming().BTR1()));
+        w.Write(uint64_t(net.BitTiming().BTR2()));
+        write_seq(w, net.Nodes_Size(),
+            [&](std::size_t i) -> const INode& { return net.Nodes_Get(i); }, write_node);
+        write_seq(w, net.ValueTables_Size(),
+            [&](std::size_t i) -> const IValueTable& { return net.ValueTables_Get(i); }, write_value_table);
+        write_seq(w, net.Messages_Size(),
+            [&](std::size_t i) -> const IMessage& { return net.Messages_Get(i); }, write_message);
+        write_seq(w, net.EnvironmentVariables_Size(),
+            [&](std::size_t i) -> const IEnvironmentVariable& { return net.EnvironmentVariables_Get(i); }, write_environment_variable);
+        write_seq(w, net.AttributeDefinitions_Size(),
+            [&](std::size_t i) -> const IAttributeDefinition& { return net.AttributeDefinitions_Get(i); }, write_attribute_definition);
+        write_seq(w, net.AttributeDefaults_Size(),
+            [&](std::size_t i) -> const IAttribute& { return net.AttributeDefaults_Get(i); }, write_attribute);
+        write_seq(w, net.AttributeValues_Size(),
+            [&](std::size_t i) -> const IAttribute& { return net.AttributeValues_Get(i); }, write_attribute);
+        w.WriteString(net.Comment());
+    }
+    std::unique_ptr<INetwork> read_network(SnapshotStream& s)
+    {
+        auto version = s.ReadString();
+        auto new_symbols = s.ReadStrings();
+        auto baudrate = s.Read<uint64_t>();
+        auto btr1 = s.Read<uint64_t>();
+        auto btr2 = s.Read<uint64_t>();
+        auto nodes = read_seq<std::unique_ptr<INode>>(s, read_node);
+        auto value_tables = read_seq<std::unique_ptr<IValueTable>>(s, read_value_table);
+        auto messages = read_seq<std::unique_ptr<IMessage>>(s, read_message);
+        auto environment_variables = read_seq<std::unique_ptr<IEnvironmentVariable>>(s, read_environment_variable);
+        auto attribute_definitions = read_seq<std::unique_ptr<IAttributeDefinition>>(s, read_attribute_definition);
+        auto attribute_defaults = read_seq<std::unique_ptr<IAttribute>>(s, read_attribute);
+        auto attribute_values = read_seq<std::unique_ptr<IAttribute>>(s, read_attribute);
+        auto comment = s.ReadString();
+        if (!s.Ok() || !s.AtEnd())
+        {
+            return nullptr;
+        }
+        return INetwork::Create(
+              std::move(version)
+            , std::move(new_symbols)
+            , IBitTiming::Create(baudrate, btr1, btr2)
+            , std::move(nodes)
+            , std::move(value_tables)
+            , std::move(messages)
+            , std::move(environment_variables)
+            , std::move(attribute_definitions)
+            , std::move(attribute_defaults)
+            , std::move(attribute_values)
+            , std::move(comment));
+    }
+}
+
+bool SnapshotWriter::Finish(const std::filesystem::path& filename, uint64_t dbc_hash)
+{
+    if (_overflow)
+    {
+        return false;
+    }
+    _sections[std::size_t(ESnapshotSection::Strings)] = std::move(_strings);
+
+    SnapshotHeader header{};
+    header.magic = snapshot_magic;
+    header.version = snapshot_version;
+    header.byte_order_mark = byte_order_mark;
+    header.dbc_hash = dbc_hash;
+    header.descriptor_size = uint32_t(sizeof(CompiledNetwork::SignalDescriptor));
+    header.message_record_size = uint32_t(sizeof(CompiledNetwork::Message));
+    uint64_t offset = sizeof(SnapshotHeader);
+    for (std::size_t i = 0; i < _sections.size(); i++)
+    {
+        offset = (offset + section_alignment - 1) / section_alignment * section_alignment;
+        header.sections[i].offset = offset;
+        header.sections[i].size = _sections[i].size();
+        offset += _sections[i].size();
+    }
+    header.file_size = offset;
+    std::string file(std::size_t(offset), '\0');
+    for (std::size_t i = 0; i < _sections.size(); i++)
+    {
+        std::memcpy(file.data() + header.sections[i].offset, _sections[i].data(), _sections[i].size());
+    }
+    header.checksum = Snapshot::Hash(file.data() + sizeof(SnapshotHeader), file.size() - sizeof(SnapshotHeader));
+    std::memcpy(file.data(), &header, sizeof(header));
+
+    // write to a temporary file and rename it, so concurrent readers never see a partially written snapshot
+    auto tmp = filename;
+    tmp += ".tmp" + std::to_string(std::random_device{}());
+    {
+        std::ofstream os(tmp, std::ios::binary | std::ios::trunc);
+        if (!os.write(file.data(), file.size()) || !os.flush())
+        {
+            os.close();
+            std::error_code ec;
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, filename, ec);
+    if (ec)
+    {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+bool SnapshotReader::Open(std::shared_ptr<const MappedFile> file, uint64_t dbc_hash)
+{
+    if (!file || file->size() < sizeof(SnapshotHeader))
+    {
+        return false;
+    }
+    // the header is at the start of the mapping, so it's suitably aligned
+    const auto* header = reinterpret_cast<const SnapshotHeader*>(file->data());
+    if (header->magic != snapshot_magic
+        || header->version != snapshot_version
+        || header->byte_order_mark != byte_order_mark
+        || header->descriptor_size != sizeof(CompiledNetwork::SignalDescriptor)
+        || header->message_record_size != sizeof(CompiledNetwork::Message)
+        || header->file_size != file->size()
+        || header->dbc_hash != dbc_hash)
+    {
+        return false;
+    }
+    for (const auto& section : header->sections)
+    {
+        if (section.offset % section_alignment != 0
+            || section.offset < sizeof(SnapshotHeader)
+            || section.offset > file->size()
+            || section.size > file->size() - section.offset)
+        {
+            return false;
+        }
+    }
+    if (Snapshot::Hash(file->data() + sizeof(SnapshotHeader), file->size() - sizeof(SnapshotHeader)) != header->checksum)
+    {
+        return false;
+    }
+    _file = std::move(file);
+    _header = header;
+    return true;
+}
+
+uint64_t Snapshot::Hash(const void* data, std::size_t size) noexcept
+{
+    // word wise multiply and xorshift, fast enough to verify big snapshots on every load
+    constexpr uint64_t m = 0xff51afd7ed558ccdull;
+    const char* bytes = static_cast<const char*>(data);
+    uint64_t h = 0x9e3779b97f4a7c15ull ^ (uint64_t(size) * m);
+    std::size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        h = (h ^ word) * m;
+        h ^= h >> 29;
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, bytes + i, size - i);
+    h = (h ^ tail) * m;
+    h ^= h >> 32;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 29;
+    return h;
+}
+bool Snapshot::Save(const INetwork& net, const std::filesystem::path& filename, uint64_t dbc_hash)
+{
+    std::unique_ptr<CompiledNetwork> compiled;
+    try
+    {
+        compiled = CompiledNetwork::Create(net);
+    }
+    catch (const std::length_error&)
+    {
+        return false;
+    }
+    SnapshotWriter writer;
+    write_network(writer, net);
+    writer.EndSection(ESnapshotSection::Model);
+    WriteCompiledNetwork(writer, *compiled);
+    return writer.Finish(filename, dbc_hash);
+}
+std::unique_ptr<INetwork> Snapshot::LoadNetwork(const std::filesystem::path& filename, uint64_t dbc_hash)
+{
+    SnapshotReader reader;
+    if (!reader.Open(MappedFile::Open(filename), dbc_hash))
+    {
+        return nullptr;
+    }
+    SnapshotStream s(reader, reader.Section(ESnapshotSection::Model));
+    return read_network(s);
+}
+std::unique_ptr<CompiledNetwork> Snapshot::LoadCompiledNetwork(const std::filesystem::path& filename, uint64_t dbc_hash)
+{
+    SnapshotReader reader;
+    if (!reader.Open(MappedFile::Open(filename), dbc_hash))
+    {
+        return nullptr;
+    }
+    std::unique_ptr<CompiledNetwork> result{new CompiledNetwork()};
+    if (!ReadCompiledNetwork(reader, *result))
+    {
+        return nullptr;
+    }
+    return result;
+}
+void Snapshot::WriteCompiledNetwork(SnapshotWriter& writer, const CompiledNetwork& compiled)
+{
+    writer.WriteBytes(compiled._messages.data(), compiled._messages.size_bytes());
+    writer.EndSection(ESnapshotSection::Messages);
+    writer.WriteBytes(compiled._signals.data(), compiled._signals.size_bytes());
+    writer.EndSection(ESnapshotSection::Signals);
+    writer.WriteBytes(compiled._groups.data(), compiled._groups.size_bytes());
+    writer.EndSection(ESnapshotSection::Groups);
+    const CompiledNetwork::Cold& cold = *compiled._cold;
+    auto write_names =
+        [&](const std::vector<std::string_view>& names, ESnapshotSection section)
+        {
+            for (auto name : names)
+            {
+                writer.Write(writer.Intern(name));
+            }
+            writer.EndSection(section);
+        };
+    write_names(cold.message_names, ESnapshotSection::MessageNames);
+    write_names(cold.signal_names, ESnapshotSection::SignalNames);
+    write_names(cold.units, ESnapshotSection::Units);
+
+    for (std::size_t i = 0; i < cold.extended.size(); i++)
+    {
+        if (!cold.extended[i])
+        {
+            continue;
+        }
+        const ExtendedMuxGraph& graph = cold.extended[i]->graph;
+        writer.Write(uint32_t(i));
+        writer.WriteSize(graph._n_extended);
+        writer.WriteSize(graph._nodes.size());
+        for (const auto& node : graph._nodes)
+        {
+            writer.Write(node.signal);
+            writer.Write(node.ordinal);
+            writer.Write(node.first_condition);
+            writer.Write(node.n_conditions);
+            writer.Write(uint8_t(node.always));
+            writer.Write(uint8_t(node.is_switch));
+        }
+        writer.WriteSize(graph._conditions.size());
+        for (const auto& cond : graph._conditions)
+        {
+            writer.Write(cond.switch_node);
+            writer.Write(cond.first_range);
+            writer.Write(cond.n_ranges);
+        }
+        writer.WriteSize(graph._ranges.size());
+        for (const auto& range : graph._ranges)
+        {
+            writer.Write(range.from);
+            writer.Write(range.to);
+        }
+        writer.WriteSize(cold.extended[i]->descriptors.size());
+        writer.WriteBytes(cold.extended[i]->descriptors.data(), cold.extended[i]->descriptors.size() * sizeof(uint32_t));
+    }
+    writer.EndSection(ESnapshotSection::ExtendedMux);
+}
+bool Snapshot::ReadCompiledNetwork(const SnapshotReader& reader, CompiledNetwork& compiled)
+{
+    using Message = CompiledNetwork::Message;
+    using MuxGroup = CompiledNetwork::MuxGroup;
+    using SignalDescriptor = CompiledNetwork::SignalDescriptor;
+
+    std::span<const Message> messages;
+    std::span<const SignalDescriptor> signals;
+    std::span<const MuxGroup> groups;
+    if (!reader.Array(ESnapshotSection::Messages, messages)
+        || !reader.Array(ESnapshotSection::Signals, signals)
+        || !reader.Array(ESnapshotSection::Groups, groups))
+    {
+        return false;
+    }
+    // decoding doesn't check any bounds, so the checksum alone isn't trusted
+    for (std::size_t i = 0; i < messages.size(); i++)
+    {
+        const Message& msg = messages[i];
+        if ((i != 0 && messages[i - 1].id > msg.id)
+            || uint64_t(msg.first_signal) + msg.n_signals > signals.size()
+            || uint64_t(msg.n_always) + msg.n_extended > msg.n_signals
+            || uint64_t(msg.first_group) + msg.n_groups > groups.size())
+        {
+            return false;
+        }
+        for (uint32_t j = 0; j < msg.n_signals; j++)
+        {
+            // decoding reads 8 bytes from the byte position, 9 for a signal spanning nine bytes, a signal of the
+            // message can't make it read further than 8 bytes behind the end of the message
+            const SignalDescriptor& sig = signals[msg.first_signal + j];
+            const uint64_t n_read = sig.flags & SignalDescriptor::NineBytes ? 9 : 8;
+            if (sig.index >= msg.n_signals
+                || sig.bit_size == 0 || sig.bit_size > 64
+                || sig.fixed_start_bit_0 >= 64 || sig.fixed_start_bit_1 >= 64
+                || sig.byte_pos + n_read > msg.message_size + 8)
+            {
+                return false;
+            }
+        }
+        for (uint32_t j = 0; j < msg.n_groups; j++)
+        {
+            const MuxGroup& group = groups[msg.first_group + j];
+            if (group.first_signal < msg.n_always
+                || uint64_t(group.first_signal) + group.n_signals > msg.n_signals - msg.n_extended)
+            {
+                return false;
+            }
+        }
+    }
+
+    CompiledNetwork::Cold& cold = *compiled._cold;
+    auto read_names =
+        [&](ESnapshotSection section, std::size_t size, std::vector<std::string_view>& names)
+        {
+            std::span<const SnapshotStringRef> refs;
+            if (!reader.Array(section, refs) || refs.size() != size)
+            {
+                return false;
+            }
+            names.resize(size);
+            for (std::size_t i = 0; i < size; i++)
+            {
+                if (!reader.String(refs[i], names[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+    if (!read_names(ESnapshotSection::MessageNames, messages.size(), cold.message_names)
+        || !read_names(ESnapshotSection::SignalNames, signals.size(), cold.signal_names)
+        || !read_names(ESnapshotSection::Units, signals.size(), cold.units))
+    {
+        return false;
+    }
+
+    cold.extended.resize(messages.size());
+    SnapshotStream s(reader, reader.Section(ESnapshotSection::ExtendedMux));
+    while (s.Ok() && !s.AtEnd())
+    {
+        auto i = s.Read<uint32_t>();
+        if (i >= messages.size() || cold.extended[i])
+        {
+            return false;
+        }
+        const Message& msg = messages[i];
+        auto extended = std::make_unique<CompiledNetwork::Cold::ExtendedMux>();
+        ExtendedMuxGraph& graph = extended->graph;
+        graph._n_extended = s.ReadSize();
+        graph._nodes.resize(s.ReadSize());
+        for (auto& node : graph._nodes)
+        {
+            node.signal = s.Read<uint32_t>();
+            node.ordinal = s.Read<uint32_t>();
+            node.first_condition = s.Read<uint32_t>();
+            node.n_conditions = s.Read<uint32_t>();
+            node.always = s.Read<uint8_t>() != 0;
+            node.is_switch = s.Read<uint8_t>() != 0;
+        }
+        graph._conditions.resize(s.ReadSize());
+        for (auto& cond : graph._conditions)
+        {
+            cond.switch_node = s.Read<uint32_t>();
+            cond.first_range = s.Read<uint32_t>();
+            cond.n_ranges = s.Read<uint32_t>();
+        }
+        graph._ranges.resize(s.ReadSize());
+        for (auto& range : graph._ranges)
+        {
+            range.from = s.Read<uint64_t>();
+            range.to = s.Read<uint64_t>();
+        }
+        extended->descriptors.resize(s.ReadSize());
+        for (auto& desc : extended->descriptors)
+        {
+            desc = s.Read<uint32_t>();
+        }
+        if (!s.Ok()
+            || graph._n_extended != msg.n_extended
+            || extended->descriptors.size() != msg.n_signals)
+        {
+            return false;
+        }
+        for (auto desc : extended->descriptors)
+        {
+            if (desc >= msg.n_signals)
+            {
+                return false;
+            }
+        }
+        for (std::size_t j = 0; j < graph._nodes.size(); j++)
+        {
+            const auto& node = graph._nodes[j];
+            if (node.signal >= msg.n_signals
+                || (node.ordinal != ExtendedMuxGraph::npos && node.ordinal >= msg.n_extended)
+                || uint64_t(node.first_condition) + node.n_conditions > graph._conditions.size())
+            {
+                return false;
+            }
+            for (uint32_t k = node.first_condition; k < node.first_condition + node.n_conditions; k++)
+            {
+                const auto& cond = graph._conditions[k];
+                // the nodes are in topological order
+                if (cond.switch_node >= j || uint64_t(cond.first_range) + cond.n_ranges > graph._ranges.size())
+                {
+                    return false;
+                }
+            }
+        }
+        graph.AllocateScratch();
+        cold.extended[i] = std::move(extended);
+    }
+    if (!s.Ok())
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < messages.size(); i++)
+    {
+        if (messages[i].n_extended != 0 && !cold.extended[i])
+        {
+            return false;
+        }
+    }
+    compiled._messages = messages;
+    compiled._signals = signals;
+    compiled._groups = groups;
+    cold.snapshot = reader.File();
+    return true;
+}
+
+uint64_t INetwork::ContentHash(std::string_view content)
+{
+    return Snapshot::Hash(content.data(), content.size());
+}
+std::unique_ptr<INetwork> INetwork::LoadSnapshot(const std::filesystem::path& filename, uint64_t dbc_hash)
+{
+    return Snapshot::LoadNetwork(filename, dbc_hash);
+}
+bool INetwork::SaveSnapshot(const std::filesystem::path& filename, uint64_t dbc_hash) const
+{
+    return Snapshot::Save(*this, filename, dbc_hash);
+}
+std::unique_ptr<CompiledNetwork> CompiledNetwork::LoadSnapshot(const std::filesystem::path& filename, uint64_t dbc_hash)
+{
+    return Snapshot::LoadCompiledNetwork(filename, dbc_hash);
+}
+extern "C"
+{
+    DBCPPP_API uint64_t dbcppp_NetworkContentHash(const char* data, uint64_t size)
+    {
+        return INetwork::ContentHash(std::string_view(data, std::size_t(size)));
+    }
+    DBCPPP_API const dbcppp_Network* dbcppp_NetworkLoadSnapshot(const char* filename, uint64_t dbc_hash)
+    {
+        auto net = INetwork::LoadSnapshot(filename, dbc_hash);
+        return reinterpret_cast<const dbcppp_Network*>(net.release());
+    }
+    DBCPPP_API int dbcppp_NetworkSaveSnapshot(const dbcppp_Network* net, const char* filename, uint64_t dbc_hash)
+    {
+        auto neti = reinterpret_cast<const NetworkImpl*>(net);
+        return neti->SaveSnapshot(filename, dbc_hash);
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+#include <cstdint>
+#include <filesystem>
+
+#include "../../include/dbcppp/Network.h"
+#include "../../include/dbcppp/CompiledNetwork.h"
+
+namespace dbcppp
+{
+    class SnapshotWriter;
+    class SnapshotReader;
+    class MappedFile;
+
+    // Versioned binary snapshot of a network.
+    //
+    // The file starts with a header holding the format version, a checksum over the rest of the file, the
+    // hash of the DBC content the snapshot was created from and a table of sections. Sections are addressed
+    // by offsets relative to the start of the file and aligned on 64 bytes, strings are stored once in a
+    // string pool and referenced by offset and size. Besides the network model the snapshot contains the
+    // compiled network, its descriptors are used in place from the mapped file.
+    class Snapshot
+    {
+    public:
+        static bool Save(const INetwork& net, const std::filesystem::path& filename, uint64_t dbc_hash);
+        static std::unique_ptr<INetwork> LoadNetwork(const std::filesystem::path& filename, uint64_t dbc_hash);
+        static std::unique_ptr<CompiledNetwork> LoadCompiledNetwork(const std::filesystem::path& filename, uint64_t dbc_hash);
+        static uint64_t Hash(const void* data, std::size_t size) noexcept;
+
+    private:
+        static void WriteCompiledNetwork(SnapshotWriter& writer, const CompiledNetwork& compiled);
+        static bool ReadCompiledNetwork(const SnapshotReader& reader, CompiledNetwork& compiled);
+    };
+}
@@ -0,0 +1,51 @@
+#include <algorithm>
+#include "ValueDescriptionIndex.h"
+
+using namespace dbcppp;
+
+void ValueDescriptionIndex::Build(const std::vector<ValueEncodingDescriptionImpl>& veds)
+{
+    _dense_min = 0;
+    _dense.clear();
+    _sparse.clear();
+    _sparse.reserve(veds.size());
+    for (std::size_t i = 0; i < veds.size(); i++)
+    {
+        _sparse.emplace_back(veds[i].Value(), uint32_t(i));
+    }
+    // stable to let the first of duplicated values win
+    std::stable_sort(_sparse.begin(), _sparse.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    _sparse.erase(std::unique(_sparse.begin(), _sparse.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first == rhs.first; }), _sparse.end());
+    if (!_sparse.empty())
+    {
+        // small enums are stored in a dense array if at least every fourth entry is used
+        constexpr uint64_t min_dense_size = 64;
+        uint64_t range = uint64_t(_sparse.back().first) - uint64_t(_sparse.front().first);
+        if (range < std::max<uint64_t>(min_dense_size, _sparse.size() * 4))
+        {
+            _dense_min = _sparse.front().first;
+            _dense.assign(range + 1, npos);
+            for (const auto& [value, i] : _sparse)
+            {
+                _dense[uint64_t(value) - uint64_t(_dense_min)] = i;
+            }
+            _sparse.clear();
+            _sparse.shrink_to_fit();
+        }
+    }
+    _descriptions.Build(veds.size(),
+        [&](std::size_t i) -> std::string_view { return veds[i].Description(); });
+}
+uint32_t ValueDescriptionIndex::FindSparse(int64_t value) const noexcept
+{
+    auto iter = std::lower_bound(_sparse.begin(), _sparse.end(), value,
+        [](const auto& entry, int64_t v) { return entry.first < v; });
+    return iter != _sparse.end() && iter->first == value ? iter->second : npos;
+}
+uint32_t ValueDescriptionIndex::FindDescription(const std::vector<ValueEncodingDescriptionImpl>& veds, std::string_view description) const
+{
+    return _descriptions.Find(description,
+        [&](std::size_t i) -> std::string_view { return veds[i].Description(); });
+}
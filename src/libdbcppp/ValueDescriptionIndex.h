@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+#include "ValueEncodingDescriptionImpl.h"
+#include "NameIndex.h"
+
+namespace dbcppp
+{
+    // Lookup of value encoding descriptions by value and by description. Depending on the density of the
+    // values they are looked up in a dense array or in a sorted flat map, descriptions are looked up in a
+    // hash table. Positions are stored, so the index is valid as long as the descriptions aren't modified.
+    class ValueDescriptionIndex
+    {
+    public:
+        static constexpr uint32_t npos = uint32_t(-1);
+
+        // for duplicated values or descriptions the first one wins
+        void Build(const std::vector<ValueEncodingDescriptionImpl>& veds);
+        inline uint32_t FindValue(int64_t value) const noexcept
+        {
+            if (!_dense.empty())
+            {
+                uint64_t i = uint64_t(value) - uint64_t(_dense_min);
+                return i < _dense.size() ? _dense[i] : npos;
+            }
+            return FindSparse(value);
+        }
+        uint32_t FindDescription(const std::vector<ValueEncodingDescriptionImpl>& veds, std::string_view description) const;
+
+    private:
+        uint32_t FindSparse(int64_t value) const noexcept;
+
+        int64_t _dense_min = 0;
+        std::vector<uint32_t> _dense;
+        std::vector<std::pair<int64_t, uint32_t>> _sparse;
+        NameIndex _descriptions;
+    };
+}
@@ -32,7 +32,9 @@ ValueTableImpl::ValueTableImpl(
     : _name(std::move(name))
     , _signal_type(std::move(signal_type))
     , _value_encoding_descriptions(std::move(value_encoding_descriptions))
-{}
+{
+    _value_description_index.Build(_value_encoding_descriptions);
+}
 std::unique_ptr<IValueTable> ValueTableImpl::Clone() const
 {
     return std::make_unique<ValueTableImpl>(*this);
@@ -58,6 +60,16 @@ uint64_t ValueTableImpl::ValueEncodingDescriptions_Size() const
 {
     return _value_encoding_descriptions.size();
 }
+const IValueEncodingDescription* ValueTableImpl::ValueEncodingDescriptionByValue(int64_t value) const
+{
+    uint32_t i = _value_description_index.FindValue(value);
+    return i != ValueDescriptionIndex::npos ? &_value_encoding_descriptions[i] : nullptr;
+}
+const IValueEncodingDescription* ValueTableImpl::ValueEncodingDescriptionByDescription(std::string_view description) const
+{
+    uint32_t i = _value_description_index.FindDescription(_value_encoding_descriptions, description);
+    return i != ValueDescriptionIndex::npos ? &_value_encoding_descriptions[i] : nullptr;
+}
 bool ValueTableImpl::operator==(const IValueTable& rhs) const
 {
     bool equal = true;
@@ -8,6 +8,7 @@
 #include "../../include/dbcppp/ValueTable.h"
 #include "SignalTypeImpl.h"
 #include "ValueEncodingDescriptionImpl.h"
+#include "ValueDescriptionIndex.h"
 
 namespace dbcppp
 {
@@ -27,6 +28,8 @@ namespace dbcppp
         virtual std::optional<std::reference_wrapper<const ISignalType>> SignalType() const override;
         virtual const IValueEncodingDescription& ValueEncodingDescriptions_Get(std::size_t i) const override;
         virtual uint64_t ValueEncodingDescriptions_Size() const override;
+        virtual const IValueEncodingDescription* ValueEncodingDescriptionByValue(int64_t value) const override;
+        virtual const IValueEncodingDescription* ValueEncodingDescriptionByDescription(std::string_view description) const override;
         
         virtual bool operator==(const IValueTable& rhs) const override;
         virtual bool operator!=(const IValueTable& rhs) const override;
@@ -35,5 +38,6 @@ namespace dbcppp
         std::string _name;
         std::optional<SignalTypeImpl> _signal_type;
         std::vector<ValueEncodingDescriptionImpl> _value_encoding_descriptions;
+        ValueDescriptionIndex _value_description_index;
     };
 }
\ No newline at end of file
@@ -1,7 +1,19 @@
 
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <filesystem>
+#include <functional>
+#include <thread>
+
 #include "Catch2.h"
+#include "Config.h"
 #include <dbcppp/CApi.h>
 #include <dbcppp/Network.h>
+#include <dbcppp/Network2Functions.h>
+#include <dbcppp/CompiledNetwork.h>
 
 using namespace dbcppp;
 
@@ -244,3 +256,926 @@ TEST_CASE("API Test: Message", "[]")
         REQUIRE(dbcppp_MessageSignals_Size(msg) == 3);
     }
 }
+TEST_CASE("API Test: Iterable", "[]")
+{
+    constexpr char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_: Recv0 Recv1\n"
+        "BO_ 1 Msg0: 8 Recv0\n"
+        "  SG_ Sig0: 0|1@1+ (1,0) [1|12] \"Unit0\" Recv0\n"
+        "  SG_ Sig1 m0 : 1|1@0- (1,0) [1|12] \"Unit1\" Recv0, Recv1\n"
+        "  SG_ Sig2 M : 2|1@0- (1,0) [1|12] \"Unit2\" Recv0, Recv1\n"
+        "BO_ 2 Msg1: 8 Recv0\n"
+        "BO_ 3 Msg2: 8 Recv0\n"
+        "  SG_ Sig0: 0|1@1+ (1,0) [1|12] \"Unit0\" Recv0\n";
+    
+    SECTION("CPP API")
+    {
+        std::istringstream iss(test_dbc);
+        auto net = INetwork::LoadDBCFromIs(iss);
+        REQUIRE(net);
+        REQUIRE(net->Messages_Size() == 3);
+
+        // the stride is taken from the first two elements, so views of 0, 1 and N elements are checked against _Get
+        auto check = [](const IMessage& msg, std::size_t size)
+        {
+            auto sigs = msg.Signals();
+            REQUIRE(sigs.size() == size);
+            REQUIRE(sigs.size() == msg.Signals_Size());
+            REQUIRE(sigs.empty() == (size == 0));
+            REQUIRE(std::size_t(sigs.end() - sigs.begin()) == size);
+            REQUIRE((sigs.begin() == sigs.end()) == (size == 0));
+            std::size_t i = 0;
+            for (const ISignal& sig : sigs)
+            {
+                REQUIRE(&sig == &msg.Signals_Get(i));
+                REQUIRE(&sigs[i] == &msg.Signals_Get(i));
+                i++;
+            }
+            REQUIRE(i == size);
+        };
+        check(net->Messages_Get(0), 3);
+        check(net->Messages_Get(1), 0);
+        check(net->Messages_Get(2), 1);
+
+        const IMessage& msg = net->Messages_Get(0);
+        auto sigs = msg.Signals();
+        REQUIRE((sigs.begin() + 2)->Name() == "Sig2");
+        REQUIRE((sigs.end() - 1)->Name() == "Sig2");
+        auto iter = std::find_if(sigs.begin(), sigs.end(), [](const ISignal& sig) { return sig.Name() == "Sig1"; });
+        REQUIRE(iter - sigs.begin() == 1);
+        REQUIRE(std::count_if(sigs.begin(), sigs.end(), [](const ISignal& sig) { return sig.Receivers_Size() == 2; }) == 2);
+
+        auto receivers = msg.Signals_Get(0).Receivers();
+        REQUIRE(receivers.size() == 1);
+        REQUIRE(*receivers.begin() == "Recv0");
+        REQUIRE(++receivers.begin() == receivers.end());
+        REQUIRE(msg.SignalGroups().empty());
+        REQUIRE(msg.SignalGroups().begin() == msg.SignalGroups().end());
+        std::size_t n = 0;
+        for (const IMessage& m : net->Messages())
+        {
+            REQUIRE(&m == &net->Messages_Get(n));
+            n++;
+        }
+        REQUIRE(n == 3);
+    }
+}
+TEST_CASE("API Test: Iterable benchmark", "[.][benchmark]")
+{
+    std::string content =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_:\n";
+    for (std::size_t i = 0; i < 2000; i++)
+    {
+        std::string id = std::to_string(i);
+        content += "BO_ " + id + " Msg" + id + ": 8 Vector__XXX\n";
+        for (std::size_t j = 0; j < 16; j++)
+        {
+            content += " SG_ Sig" + std::to_string(j) + " : " + std::to_string(j * 4) + "|4@1+ (1,0) [0|0] \"\" Vector__XXX\n";
+        }
+    }
+    auto net = INetwork::LoadDBCFromMemory(content.data(), content.size());
+    REQUIRE(net);
+
+    // walks all signals like the std::function based iterators did before the views
+    BENCHMARK("std::function iterator")
+    {
+        using namespace std::placeholders;
+        uint64_t sum = 0;
+        std::function<const IMessage& (std::size_t)> get_msg = std::bind(&INetwork::Messages_Get, net.get(), _1);
+        for (std::size_t i = 0; i < net->Messages_Size(); i++)
+        {
+            const IMessage& msg = get_msg(i);
+            std::function<const ISignal& (std::size_t)> get_sig = std::bind(&IMessage::Signals_Get, &msg, _1);
+            for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+            {
+                sum += get_sig(j).BitSize();
+            }
+        }
+        return sum;
+    };
+    BENCHMARK("_Get")
+    {
+        uint64_t sum = 0;
+        for (std::size_t i = 0; i < net->Messages_Size(); i++)
+        {
+            const IMessage& msg = net->Messages_Get(i);
+            for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+            {
+                sum += msg.Signals_Get(j).BitSize();
+            }
+        }
+        return sum;
+    };
+    BENCHMARK("view")
+    {
+        uint64_t sum = 0;
+        for (const IMessage& msg : net->Messages())
+        {
+            for (const ISignal& sig : msg.Signals())
+            {
+                sum += sig.BitSize();
+            }
+        }
+        return sum;
+    };
+}
+TEST_CASE("API Test: MessageById", "[]")
+{
+    constexpr char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_:\n"
+        "BO_ 1 Msg0: 8 Sender0\n"
+        "BO_ 2047 Msg1: 8 Sender0\n"
+        "BO_ 2147483649 Msg2: 8 Sender0\n"
+        "BO_ 2365587456 Msg3: 8 Sender0\n";
+    
+    SECTION("CPP API")
+    {
+        std::istringstream iss(test_dbc);
+        auto net = INetwork::LoadDBCFromIs(iss);
+        REQUIRE(net);
+
+        REQUIRE(net->MessageById(1));
+        REQUIRE(net->MessageById(1)->Name() == "Msg0");
+        REQUIRE(net->MessageById(2047)->Name() == "Msg1");
+        REQUIRE(net->MessageById(2147483649)->Name() == "Msg2");
+        REQUIRE(net->MessageById(2365587456)->Name() == "Msg3");
+        REQUIRE(!net->MessageById(0));
+        REQUIRE(!net->MessageById(2));
+        REQUIRE(!net->MessageById(2048));
+        REQUIRE(!net->MessageById(2147483650));
+
+        std::vector<std::unique_ptr<IMessage>> msgs;
+        for (uint64_t id = 0x80000000; id < 0x80000000 + 1000; id++)
+        {
+            msgs.push_back(IMessage::Create(id * 7, "Msg", 8, "", {}, {}, {}, "", {}));
+        }
+        net->Merge(INetwork::Create("", {}, IBitTiming::Create(0, 0, 0), {}, {}, std::move(msgs), {}, {}, {}, {}, ""));
+        REQUIRE(net->MessageById(2365587456)->Name() == "Msg3");
+        for (uint64_t id = 0x80000000; id < 0x80000000 + 1000; id++)
+        {
+            REQUIRE(net->MessageById(id * 7));
+            REQUIRE(net->MessageById(id * 7)->Id() == id * 7);
+            REQUIRE(!net->MessageById(id * 7 + 1));
+        }
+    }
+    SECTION("C API")
+    {
+        auto net = dbcppp_NetworkLoadDBCFromMemory(test_dbc);
+        REQUIRE(net);
+
+        REQUIRE(dbcppp_NetworkMessageById(net, 2147483649));
+        REQUIRE(dbcppp_MessageName(dbcppp_NetworkMessageById(net, 2147483649)) == std::string("Msg2"));
+        REQUIRE(!dbcppp_NetworkMessageById(net, 3));
+    }
+}
+TEST_CASE("API Test: Lookup by name", "[]")
+{
+    constexpr char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_: Node0 Node1\n"
+        "VAL_TABLE_ VT0 0 \"Zero\" 1 \"One\" ;\n"
+        "BO_ 1 Msg0: 8 Node0\n"
+        " SG_ Sig0 : 0|8@1+ (1,0) [0|0] \"\" Node1\n"
+        " SG_ Sig1 : 8|8@1+ (1,0) [0|0] \"\" Node1\n"
+        "BO_ 2 Msg1: 8 Node1\n"
+        " SG_ Sig0 : 0|16@1+ (1,0) [0|0] \"\" Node0\n";
+    
+    SECTION("CPP API")
+    {
+        std::istringstream iss(test_dbc);
+        auto net = INetwork::LoadDBCFromIs(iss);
+        REQUIRE(net);
+
+        REQUIRE(net->MessageByName("Msg0"));
+        REQUIRE(net->MessageByName("Msg0")->Id() == 1);
+        REQUIRE(net->MessageByName("Msg1")->Id() == 2);
+        REQUIRE(!net->MessageByName("Msg2"));
+        REQUIRE(net->MessageByName("Msg1")->SignalByName("Sig0")->BitSize() == 16);
+        REQUIRE(!net->MessageByName("Msg1")->SignalByName("Sig1"));
+        REQUIRE(net->FindSignal("Msg0.Sig1"));
+        REQUIRE(net->FindSignal("Msg0.Sig1")->StartBit() == 8);
+        REQUIRE(!net->FindSignal("Msg0.Sig2"));
+        REQUIRE(!net->FindSignal("Msg2.Sig0"));
+        REQUIRE(!net->FindSignal("Msg0"));
+        REQUIRE(net->NodeByName("Node1"));
+        REQUIRE(net->NodeByName("Node1")->Name() == "Node1");
+        REQUIRE(!net->NodeByName("Node2"));
+        REQUIRE(net->ValueTableByName("VT0"));
+        REQUIRE(!net->ValueTableByName("VT1"));
+
+        std::vector<std::unique_ptr<IMessage>> msgs;
+        for (std::size_t i = 0; i < 1000; i++)
+        {
+            msgs.push_back(IMessage::Create(1000 + i, "Msg" + std::to_string(1000 + i), 8, "", {}, {}, {}, "", {}));
+        }
+        net->Merge(INetwork::Create("", {}, IBitTiming::Create(0, 0, 0), {}, {}, std::move(msgs), {}, {}, {}, {}, ""));
+        REQUIRE(net->MessageByName("Msg0")->Id() == 1);
+        for (std::size_t i = 0; i < 1000; i++)
+        {
+            REQUIRE(net->MessageByName("Msg" + std::to_string(1000 + i)));
+            REQUIRE(net->MessageByName("Msg" + std::to_string(1000 + i))->Id() == 1000 + i);
+        }
+        auto clone = net->Clone();
+        REQUIRE(clone->FindSignal("Msg1.Sig0") == &clone->MessageByName("Msg1")->Signals_Get(0));
+    }
+    SECTION("C API")
+    {
+        auto net = dbcppp_NetworkLoadDBCFromMemory(test_dbc);
+        REQUIRE(net);
+
+        auto msg = dbcppp_NetworkMessageByName(net, "Msg1");
+        REQUIRE(msg);
+        REQUIRE(dbcppp_MessageId(msg) == 2);
+        REQUIRE(dbcppp_MessageSignalByName(msg, "Sig0"));
+        REQUIRE(dbcppp_NetworkFindSignal(net, "Msg0.Sig1") == dbcppp_MessageSignalByName(dbcppp_NetworkMessageByName(net, "Msg0"), "Sig1"));
+        REQUIRE(!dbcppp_NetworkFindSignal(net, "Msg1.Sig1"));
+        REQUIRE(dbcppp_NetworkNodeByName(net, "Node0"));
+        REQUIRE(dbcppp_NetworkValueTableByName(net, "VT0"));
+        REQUIRE(!dbcppp_NetworkValueTableByName(net, "VT1"));
+    }
+}
+TEST_CASE("API Test: Relations", "[]")
+{
+    constexpr char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_: Node0 Node1 Node2\n"
+        "BO_ 1 Msg0: 8 Node0\n"
+        " SG_ Sig0 : 0|8@1+ (1,0) [0|0] \"\" Node1,Node2\n"
+        " SG_ Sig1 : 8|8@1+ (1,0) [0|0] \"\" Node1\n"
+        "BO_ 2 Msg1: 8 Node1\n"
+        " SG_ Sig2 : 0|16@1+ (1,0) [0|0] \"\" Node0\n"
+        "BO_TX_BU_ 1 : Node0,Node2;\n";
+    
+    SECTION("CPP API")
+    {
+        std::istringstream iss(test_dbc);
+        auto net = INetwork::LoadDBCFromIs(iss);
+        REQUIRE(net);
+
+        const IMessage* msg0 = net->MessageByName("Msg0");
+        const IMessage* msg1 = net->MessageByName("Msg1");
+        REQUIRE(net->ParentMessage(&msg0->Signals_Get(1)) == msg0);
+        REQUIRE(net->ParentMessage(&msg1->Signals_Get(0)) == msg1);
+        auto sig = msg0->Signals_Get(0).Clone();
+        REQUIRE(!net->ParentMessage(sig.get()));
+
+        auto tx0 = net->TransmittedMessages(*net->NodeByName("Node0"));
+        REQUIRE(tx0.size() == 1);
+        REQUIRE(tx0[0] == msg0);
+        auto tx2 = net->TransmittedMessages(*net->NodeByName("Node2"));
+        REQUIRE(tx2.size() == 1);
+        REQUIRE(tx2[0] == msg0);
+        auto rx1 = net->ReceivedSignals(*net->NodeByName("Node1"));
+        REQUIRE(rx1.size() == 2);
+        REQUIRE(rx1[0] == net->FindSignal("Msg0.Sig0"));
+        REQUIRE(rx1[1] == net->FindSignal("Msg0.Sig1"));
+        auto node = net->NodeByName("Node1")->Clone();
+        REQUIRE(net->ReceivedSignals(*node).empty());
+
+        std::vector<std::unique_ptr<IMessage>> msgs;
+        std::vector<std::unique_ptr<ISignal>> sigs;
+        sigs.push_back(ISignal::Create(8, "Sig3", ISignal::EMultiplexer::NoMux, 0, 0, 8, ISignal::EByteOrder::LittleEndian,
+            ISignal::EValueType::Unsigned, 1.0, 0.0, 0.0, 0.0, "", {"Node2"}, {}, {}, "", ISignal::EExtendedValueType::Integer, {}));
+        msgs.push_back(IMessage::Create(3, "Msg2", 8, "Node2", {}, std::move(sigs), {}, "", {}));
+        net->Merge(INetwork::Create("", {}, IBitTiming::Create(0, 0, 0), {}, {}, std::move(msgs), {}, {}, {}, {}, ""));
+        REQUIRE(net->TransmittedMessages(*net->NodeByName("Node2")).size() == 2);
+        REQUIRE(net->ReceivedSignals(*net->NodeByName("Node2")).size() == 2);
+        REQUIRE(net->ParentMessage(net->FindSignal("Msg2.Sig3")) == net->MessageByName("Msg2"));
+    }
+    SECTION("C API")
+    {
+        auto net = dbcppp_NetworkLoadDBCFromMemory(test_dbc);
+        REQUIRE(net);
+
+        auto node = dbcppp_NetworkNodeByName(net, "Node1");
+        REQUIRE(dbcppp_NetworkTransmittedMessages_Size(net, node) == 1);
+        REQUIRE(dbcppp_NetworkTransmittedMessages_Get(net, node, 0) == dbcppp_NetworkMessageByName(net, "Msg1"));
+        REQUIRE(dbcppp_NetworkReceivedSignals_Size(net, node) == 2);
+        auto sig = dbcppp_NetworkReceivedSignals_Get(net, node, 1);
+        REQUIRE(dbcppp_NetworkParentMessage(net, sig) == dbcppp_NetworkMessageByName(net, "Msg0"));
+    }
+}
+TEST_CASE("API Test: Value encoding description lookup", "[]")
+{
+    constexpr char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_:\n"
+        "VAL_TABLE_ VT0 1000000 \"Big\" -5 \"Negative\" 3 \"Three\" ;\n"
+        "BO_ 1 Msg0: 8 Sender0\n"
+        " SG_ Sig0 : 0|8@1+ (1,0) [0|0] \"\" Receiver0\n"
+        " SG_ Sig1 : 8|8@1- (1,0) [0|0] \"\" Receiver0\n"
+        "VAL_ 1 Sig0 0 \"Off\" 1 \"On\" 2 \"Error\" 1 \"Duplicate\" ;\n"
+        "VAL_ 1 Sig1 -1 \"MinusOne\" 100000 \"Far\" ;\n";
+    
+    SECTION("CPP API")
+    {
+        std::istringstream iss(test_dbc);
+        auto net = INetwork::LoadDBCFromIs(iss);
+        REQUIRE(net);
+
+        const ISignal* sig0 = net->FindSignal("Msg0.Sig0");
+        REQUIRE(sig0);
+        REQUIRE(sig0->ValueEncodingDescriptionByValue(0)->Description() == "Off");
+        REQUIRE(sig0->ValueEncodingDescriptionByValue(1)->Description() == "On");
+        REQUIRE(sig0->ValueEncodingDescriptionByValue(2)->Description() == "Error");
+        REQUIRE(!sig0->ValueEncodingDescriptionByValue(3));
+        REQUIRE(!sig0->ValueEncodingDescriptionByValue(-1));
+        REQUIRE(sig0->ValueEncodingDescriptionByDescription("Error")->Value() == 2);
+        REQUIRE(sig0->ValueEncodingDescriptionByDescription("Duplicate")->Value() == 1);
+        REQUIRE(!sig0->ValueEncodingDescriptionByDescription("Unknown"));
+
+        const ISignal* sig1 = net->FindSignal("Msg0.Sig1");
+        uint8_t data[8] = {0, 0xFF};
+        REQUIRE(sig1->ValueEncodingDescriptionByValue(sig1->Decode(data))->Description() == "MinusOne");
+        REQUIRE(sig1->ValueEncodingDescriptionByValue(100000)->Description() == "Far");
+        REQUIRE(!sig1->ValueEncodingDescriptionByValue(0));
+        REQUIRE(sig1->ValueEncodingDescriptionByDescription("Far")->Value() == 100000);
+
+        const IValueTable* vt = net->ValueTableByName("VT0");
+        REQUIRE(vt);
+        REQUIRE(vt->ValueEncodingDescriptionByValue(-5)->Description() == "Negative");
+        REQUIRE(vt->ValueEncodingDescriptionByValue(1000000)->Description() == "Big");
+        REQUIRE(!vt->ValueEncodingDescriptionByValue(4));
+        REQUIRE(vt->ValueEncodingDescriptionByDescription("Three")->Value() == 3);
+
+        auto clone = sig0->Clone();
+        REQUIRE(clone->ValueEncodingDescriptionByValue(2) == &clone->ValueEncodingDescriptions_Get(2));
+    }
+    SECTION("C API")
+    {
+        auto net = dbcppp_NetworkLoadDBCFromMemory(test_dbc);
+        REQUIRE(net);
+
+        auto sig = dbcppp_NetworkFindSignal(net, "Msg0.Sig0");
+        REQUIRE(dbcppp_ValueEncodingDescriptionDescription(dbcppp_SignalValueEncodingDescriptionByValue(sig, 1)) == std::string("On"));
+        REQUIRE(dbcppp_ValueEncodingDescriptionValue(dbcppp_SignalValueEncodingDescriptionByDescription(sig, "Off")) == 0);
+        REQUIRE(!dbcppp_SignalValueEncodingDescriptionByValue(sig, 7));
+        auto vt = dbcppp_NetworkValueTableByName(net, "VT0");
+        REQUIRE(dbcppp_ValueEncodingDescriptionDescription(dbcppp_ValueTableValueEncodingDescriptionByValue(vt, -5)) == std::string("Negative"));
+        REQUIRE(!dbcppp_ValueTableValueEncodingDescriptionByDescription(vt, "Four"));
+    }
+}
+TEST_CASE("API Test: Snapshot", "[]")
+{
+    auto snapshot = std::filesystem::temp_directory_path() / "dbcppp_api_test.snapshot";
+    SECTION("CPP API")
+    {
+        for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+        {
+            if (dbc_file.path().extension() != ".dbc")
+            {
+                continue;
+            }
+            std::ifstream is(dbc_file.path());
+            std::string content((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+            std::istringstream iss(content);
+            auto net = INetwork::LoadDBCFromIs(iss);
+            REQUIRE(net);
+            auto hash = INetwork::ContentHash(content);
+            REQUIRE(net->SaveSnapshot(snapshot, hash));
+
+            auto loaded = INetwork::LoadSnapshot(snapshot, hash);
+            REQUIRE(loaded);
+            REQUIRE(*loaded == *net);
+            REQUIRE(!INetwork::LoadSnapshot(snapshot, hash + 1));
+
+            auto compiled = CompiledNetwork::Create(*net);
+            auto mapped = CompiledNetwork::LoadSnapshot(snapshot, hash);
+            REQUIRE(mapped);
+            REQUIRE(mapped->Messages().size() == compiled->Messages().size());
+            for (const auto& msg : compiled->Messages())
+            {
+                const auto* mapped_msg = &mapped->Messages()[&msg - compiled->Messages().data()];
+                REQUIRE(mapped->Name(*mapped_msg) == compiled->Name(msg));
+                auto sigs = compiled->Signals(msg);
+                auto mapped_sigs = mapped->Signals(*mapped_msg);
+                REQUIRE(sigs.size() == mapped_sigs.size());
+                for (std::size_t i = 0; i < sigs.size(); i++)
+                {
+                    REQUIRE(std::memcmp(&sigs[i], &mapped_sigs[i], sizeof(sigs[i])) == 0);
+                    REQUIRE(mapped->Name(mapped_sigs[i]) == compiled->Name(sigs[i]));
+                    REQUIRE(mapped->Unit(mapped_sigs[i]) == compiled->Unit(sigs[i]));
+                }
+                std::vector<uint8_t> frame(72, 0xA5);
+                std::vector<ISignal::raw_t> raw(sigs.size()), mapped_raw(sigs.size());
+                compiled->Decode(msg, frame.data(), raw, {});
+                mapped->Decode(*mapped_msg, frame.data(), mapped_raw, {});
+                REQUIRE(raw == mapped_raw);
+            }
+        }
+
+        // a corrupted snapshot is rejected
+        std::istringstream iss("VERSION \"\"\nNS_ :\nBS_:\nBU_:\nBO_ 1 Msg0: 8 Sender0\n SG_ Sig0 : 0|8@1+ (1,0) [0|0] \"\" Receiver0\n");
+        auto net = INetwork::LoadDBCFromIs(iss);
+        REQUIRE(net);
+        REQUIRE(net->SaveSnapshot(snapshot, 0));
+        REQUIRE(INetwork::LoadSnapshot(snapshot, 0));
+        {
+            std::fstream fs(snapshot, std::ios::in | std::ios::out | std::ios::binary);
+            fs.seekp(-1, std::ios::end);
+            fs.put('\x7F');
+        }
+        REQUIRE(!INetwork::LoadSnapshot(snapshot, 0));
+        REQUIRE(!CompiledNetwork::LoadSnapshot(snapshot, 0));
+        REQUIRE(!INetwork::LoadSnapshot(snapshot.string() + ".missing", 0));
+
+        // a descriptor which would make decoding read out of bounds is rejected even with a valid checksum
+        using SignalDescriptor = CompiledNetwork::SignalDescriptor;
+        auto compiled = CompiledNetwork::Create(*net);
+        const SignalDescriptor desc = compiled->Signals(compiled->Messages()[0])[0];
+        auto load_corrupted =
+            [&](std::function<void(SignalDescriptor&)> change)
+            {
+                REQUIRE(net->SaveSnapshot(snapshot, 0));
+                std::string file;
+                {
+                    std::ifstream is(snapshot, std::ios::binary);
+                    file.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+                }
+                // the checksum is the hash of everything behind the header, so the header ends at the offset
+                // whose hash is stored in it
+                std::size_t header_size = 0;
+                std::size_t checksum_pos = 0;
+                for (std::size_t i = 8; i < file.size() && !header_size; i += 8)
+                {
+                    const uint64_t hash = INetwork::ContentHash(std::string_view(file).substr(i));
+                    for (std::size_t j = 0; j < i && !header_size; j += 8)
+                    {
+                        if (std::memcmp(file.data() + j, &hash, sizeof(hash)) == 0)
+                        {
+                            header_size = i;
+                            checksum_pos = j;
+                        }
+                    }
+                }
+                REQUIRE(header_size != 0);
+                auto pos = file.find(std::string_view(reinterpret_cast<const char*>(&desc), sizeof(desc)));
+                REQUIRE(pos != std::string::npos);
+                SignalDescriptor changed = desc;
+                change(changed);
+                std::memcpy(file.data() + pos, &changed, sizeof(changed));
+                const uint64_t hash = INetwork::ContentHash(std::string_view(file).substr(header_size));
+                std::memcpy(file.data() + checksum_pos, &hash, sizeof(hash));
+                {
+                    std::ofstream os(snapshot, std::ios::binary | std::ios::trunc);
+                    os.write(file.data(), file.size());
+                }
+                return CompiledNetwork::LoadSnapshot(snapshot, 0);
+            };
+        REQUIRE(load_corrupted([](SignalDescriptor&) {}));
+        REQUIRE(!load_corrupted([](SignalDescriptor& sig) { sig.bit_size = 0; }));
+        REQUIRE(!load_corrupted([](SignalDescriptor& sig) { sig.bit_size = 65; }));
+        REQUIRE(!load_corrupted([](SignalDescriptor& sig) { sig.fixed_start_bit_0 = 64; }));
+        REQUIRE(!load_corrupted([](SignalDescriptor& sig) { sig.fixed_start_bit_1 = 64; }));
+        REQUIRE(!load_corrupted([](SignalDescriptor& sig) { sig.byte_pos = 9; }));
+        REQUIRE(!load_corrupted([](SignalDescriptor& sig) { sig.byte_pos = 8; sig.flags |= SignalDescriptor::NineBytes; }));
+        REQUIRE(load_corrupted([](SignalDescriptor& sig) { sig.byte_pos = 8; }));
+    }
+    SECTION("C API")
+    {
+        const char* test_dbc =
+            "VERSION \"\"\n"
+            "NS_ :\n"
+            "BS_:\n"
+            "BU_:\n"
+            "BO_ 1 Msg0: 8 Sender0\n"
+            " SG_ Sig0 : 0|8@1+ (1,0) [0|0] \"\" Receiver0\n";
+        auto net = dbcppp_NetworkLoadDBCFromMemory(test_dbc);
+        REQUIRE(net);
+        auto hash = dbcppp_NetworkContentHash(test_dbc, std::strlen(test_dbc));
+        REQUIRE(dbcppp_NetworkSaveSnapshot(net, snapshot.string().c_str(), hash));
+        auto loaded = dbcppp_NetworkLoadSnapshot(snapshot.string().c_str(), hash);
+        REQUIRE(loaded);
+        REQUIRE(dbcppp_NetworkMessages_Size(loaded) == 1);
+        REQUIRE(!dbcppp_NetworkLoadSnapshot(snapshot.string().c_str(), hash + 1));
+        dbcppp_NetworkFree(loaded);
+        dbcppp_NetworkFree(net);
+    }
+    std::filesystem::remove(snapshot);
+}
+TEST_CASE("API Test: LoadDBCFromFile and LoadDBCFromMemory", "[]")
+{
+    for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+    {
+        if (dbc_file.path().extension() != ".dbc")
+        {
+            continue;
+        }
+        std::ifstream is(dbc_file.path());
+        std::string content((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+        std::istringstream iss(content);
+        auto net = INetwork::LoadDBCFromIs(iss);
+        REQUIRE(net);
+        SECTION("CPP API")
+        {
+            auto from_file = INetwork::LoadDBCFromFile(dbc_file.path());
+            REQUIRE(from_file);
+            REQUIRE(*from_file == *net);
+            // the content doesn't need to be null terminated
+            std::vector<char> buffer(content.begin(), content.end());
+            auto from_memory = INetwork::LoadDBCFromMemory(buffer.data(), buffer.size());
+            REQUIRE(from_memory);
+            REQUIRE(*from_memory == *net);
+        }
+        SECTION("C API")
+        {
+            auto from_file = dbcppp_NetworkLoadDBCFromFile(dbc_file.path().string().c_str());
+            REQUIRE(from_file);
+            REQUIRE(dbcppp_NetworkMessages_Size(from_file) == net->Messages_Size());
+            auto from_memory = dbcppp_NetworkLoadDBCFromMemory(content.c_str());
+            REQUIRE(from_memory);
+            REQUIRE(dbcppp_NetworkMessages_Size(from_memory) == net->Messages_Size());
+            dbcppp_NetworkFree(from_file);
+            dbcppp_NetworkFree(from_memory);
+        }
+    }
+    REQUIRE(!INetwork::LoadDBCFromFile(std::filesystem::path(TEST_FILES_PATH) / "does_not_exist.dbc"));
+}
+TEST_CASE("API Test: Parallel DBC parsing", "[]")
+{
+    std::string header =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_: A B\n";
+    std::string messages;
+    std::string comments;
+    std::string attribute_values;
+    std::string value_descriptions;
+    for (std::size_t i = 0; i < 8000; i++)
+    {
+        std::string id = std::to_string(i);
+        messages +=
+            "BO_ " + id + " Msg" + id + ": 8 A\n"
+            " SG_ Sig" + id + "_0 : 0|16@1+ (0.1,-5) [0|0] \"km/h\" B\n"
+            " SG_ Sig" + id + "_1 : 23|16@0- (1,0) [0|0] \"\" B\n\n";
+        // comments with statement keywords at the beginning of a line must not be split at
+        comments += "CM_ BO_ " + id + " \"line\nBO_ 1 X: 8 A\n// no comment\";\n";
+        attribute_values += "BA_ \"GenMsgCycleTime\" BO_ " + id + " " + std::to_string(i % 100) + ";\n";
+        value_descriptions += "VAL_ " + id + " Sig" + id + "_0 0 \"Zero\" 1 \"One\" ;\n";
+    }
+    std::string attribute_definitions = "BA_DEF_ BO_ \"GenMsgCycleTime\" INT 0 1000;\n";
+    std::string content = header + messages + comments + attribute_definitions + attribute_values + value_descriptions;
+    REQUIRE(content.size() > 4 * 256 * 1024);
+
+    SECTION("CPP API")
+    {
+        // the networks are compared by their DBC output, comparing them directly is quadratic
+        auto to_dbc =
+            [](const INetwork& net)
+            {
+                using namespace Network2DBC;
+                std::ostringstream os;
+                os << net;
+                return os.str();
+            };
+        auto sequential = INetwork::LoadDBCFromMemory(content.data(), content.size());
+        REQUIRE(sequential);
+        REQUIRE(sequential->Messages_Size() == 8000);
+        const std::string expected = to_dbc(*sequential);
+        for (std::size_t threads : {0, 2, 3, 4})
+        {
+            DBCLoadOptions options;
+            options.threads = threads;
+            auto parallel = INetwork::LoadDBCFromMemory(content.data(), content.size(), options);
+            REQUIRE(parallel);
+            REQUIRE(to_dbc(*parallel) == expected);
+            REQUIRE(parallel->Messages_Get(7999).Name() == "Msg7999");
+        }
+        // the statements have to be in the order of the grammar across the whole file
+        std::string misordered = header + messages + attribute_values + comments + attribute_definitions + value_descriptions;
+        DBCLoadOptions options;
+        options.threads = 4;
+        REQUIRE(!INetwork::LoadDBCFromMemory(misordered.data(), misordered.size(), options));
+        std::string broken = content;
+        broken.replace(broken.find("BO_ 6000 "), 9, "BO_ x6000 ");
+        REQUIRE(!INetwork::LoadDBCFromMemory(broken.data(), broken.size(), options));
+    }
+}
+TEST_CASE("API Test: Selective loading", "[]")
+{
+    std::string dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_: A\n"
+        "BO_ 1 EngineSpeed: 8 A\n"
+        " SG_ Speed : 0|16@1+ (1,0) [0|0] \"rpm\" A\n"
+        "BO_ 2 EngineTemp: 8 A\n"
+        " SG_ Temp : 0|8@1- (1,-40) [0|0] \"degC\" A\n"
+        "BO_ 100 Brake: 8 A\n"
+        " SG_ Pressure : 0|32@1+ (0.1,0) [0|0] \"bar\" A\n"
+        "BO_ 200 Door: 8 A\n"
+        " SG_ Open : 0|1@1+ (1,0) [0|1] \"\" A\n"
+        "BO_TX_BU_ 200 : A;\n"
+        "CM_ \"Network\";\n"
+        "CM_ BO_ 2 \"Temperature\";\n"
+        "CM_ SG_ 200 Open \"Door open\";\n"
+        "BA_DEF_ BO_ \"GenMsgCycleTime\" INT 0 1000;\n"
+        "BA_ \"GenMsgCycleTime\" BO_ 2 100;\n"
+        "BA_ \"GenMsgCycleTime\" BO_ 200 1000;\n"
+        "VAL_ 200 Open 0 \"Closed\" 1 \"Open\" ;\n"
+        "SIG_VALTYPE_ 100 Pressure : 1;\n";
+
+    SECTION("CPP API")
+    {
+        auto names =
+            [](const INetwork& net)
+            {
+                std::vector<std::string> result;
+                for (const auto& msg : net.Messages())
+                {
+                    result.push_back(msg.Name());
+                }
+                return result;
+            };
+        for (bool fast_parse : {false, true})
+        {
+            DBCLoadOptions options;
+            options.fast_parse = fast_parse;
+            auto all = INetwork::LoadDBCFromMemory(dbc.data(), dbc.size(), options);
+            REQUIRE(all);
+            REQUIRE(all->Messages_Size() == 4);
+
+            options.messages.ids = {2, 200};
+            auto net = INetwork::LoadDBCFromMemory(dbc.data(), dbc.size(), options);
+            REQUIRE(net);
+            REQUIRE(names(*net) == std::vector<std::string>{"EngineTemp", "Door"});
+            REQUIRE(net->Comment() == "Network");
+            REQUIRE(net->AttributeDefinitions_Size() == 1);
+            // the kept messages are loaded like without a filter
+            for (const auto& msg : net->Messages())
+            {
+                const IMessage* spec = nullptr;
+                for (const auto& m : all->Messages())
+                {
+                    spec = m.Id() == msg.Id() ? &m : spec;
+                }
+                REQUIRE(spec);
+                REQUIRE(msg == *spec);
+            }
+
+            options.messages.ids.clear();
+            options.messages.id_ranges = {{50, 150}};
+            options.messages.name_patterns = {"Engine*p", "D?or"};
+            net = INetwork::LoadDBCFromMemory(dbc.data(), dbc.size(), options);
+            REQUIRE(net);
+            REQUIRE(names(*net) == std::vector<std::string>{"EngineTemp", "Brake", "Door"});
+            REQUIRE(net->Messages_Get(1).Signals_Get(0).ExtendedValueType() == ISignal::EExtendedValueType::Float);
+
+            options.messages.id_ranges.clear();
+            options.messages.name_patterns = {"Unknown*"};
+            net = INetwork::LoadDBCFromMemory(dbc.data(), dbc.size(), options);
+            REQUIRE(net);
+            REQUIRE(net->Messages_Size() == 0);
+        }
+        DBCMessageFilter filter;
+        REQUIRE(filter.Empty());
+        REQUIRE(filter.Matches(1, "Any"));
+        filter.name_patterns = {"*Speed*"};
+        REQUIRE(filter.Matches(1, "EngineSpeed"));
+        REQUIRE(filter.Matches(1, "SpeedLimit"));
+        REQUIRE(!filter.Matches(1, "EngineSpee"));
+        filter.name_patterns = {"a*b*c"};
+        REQUIRE(filter.Matches(1, "abc"));
+        REQUIRE(filter.Matches(1, "aXbYbZc"));
+        REQUIRE(!filter.Matches(1, "aXbYcZ"));
+    }
+}
+TEST_CASE("API Test: Lazy metadata", "[]")
+{
+    std::string dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_: A B\n"
+        "BO_ 1 Msg1: 8 A\n"
+        " SG_ Sig1 : 0|8@1+ (1,0) [0|0] \"\" B\n"
+        " SG_ Sig2 : 8|8@1+ (1,0) [0|0] \"\" B\n"
+        "BO_ 2 Msg2: 8 B\n"
+        " SG_ Sig1 : 0|8@1+ (1,0) [0|0] \"\" A\n"
+        "EV_ Env: 0 [0|1] \"\" 0 1 DUMMY_NODE_VECTOR0 Vector__XXX;\n"
+        "CM_ \"Network comment\";\n"
+        "CM_ BU_ A \"Node comment\";\n"
+        "CM_ BO_ 1 \"Message comment; with a semicolon\";\n"
+        "CM_ SG_ 1 Sig1 \"Signal comment /* not a comment */\";\n"
+        "CM_ EV_ Env \"Env var comment\";\n"
+        "BA_DEF_ \"NetAttr\" STRING;\n"
+        "BA_DEF_ BO_ \"GenMsgCycleTime\" INT 0 1000;\n"
+        "BA_DEF_ SG_ \"GenSigStartValue\" INT 0 255;\n"
+        "BA_DEF_DEF_ \"GenMsgCycleTime\" 100;\n"
+        "BA_ \"NetAttr\" \"Value\";\n"
+        "BA_ \"GenMsgCycleTime\" BO_ 1 10;\n"
+        "BA_ \"GenSigStartValue\" SG_ 1 Sig2 42;\n"
+        "VAL_ 1 Sig1 0 \"Zero\" ;\n"
+        "VAL_ Env 0 \"Off\" 1 \"On\" ;\n";
+
+    SECTION("CPP API")
+    {
+        auto eager = INetwork::LoadDBCFromMemory(dbc.data(), dbc.size());
+        REQUIRE(eager);
+        DBCLoadOptions options;
+        options.lazy_metadata = true;
+        auto lazy = INetwork::LoadDBCFromMemory(dbc.data(), dbc.size(), options);
+        REQUIRE(lazy);
+        // the hot statements are available without loading
+        REQUIRE(lazy->Messages_Get(0).Signals_Get(0).ValueEncodingDescriptions_Size() == 1);
+        REQUIRE(lazy->AttributeDefaults_Size() == 1);
+
+        // concurrent first accesses
+        std::vector<std::thread> threads;
+        std::vector<std::string> comments(4);
+        for (std::size_t i = 0; i < comments.size(); i++)
+        {
+            threads.emplace_back([&, i] { comments[i] = lazy->Messages_Get(0).Signals_Get(0).Comment(); });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        for (const auto& comment : comments)
+        {
+            REQUIRE(comment == "Signal comment /* not a comment */");
+        }
+        REQUIRE(*lazy == *eager);
+        REQUIRE(*eager == *lazy);
+        REQUIRE(lazy->Comment() == "Network comment");
+        REQUIRE(lazy->Nodes_Get(0).Comment() == "Node comment");
+        REQUIRE(lazy->Messages_Get(0).Comment() == "Message comment; with a semicolon");
+        REQUIRE(lazy->Messages_Get(0).AttributeValues_Size() == 1);
+        REQUIRE(lazy->Messages_Get(0).Signals_Get(1).AttributeValues_Size() == 1);
+        REQUIRE(lazy->EnvironmentVariables_Size() == 1);
+        REQUIRE(lazy->EnvironmentVariables_Get(0).Comment() == "Env var comment");
+        REQUIRE(lazy->EnvironmentVariables_Get(0).ValueEncodingDescriptions_Size() == 2);
+
+        // copies don't depend on the network they are copied from
+        auto other = INetwork::LoadDBCFromMemory(dbc.data(), dbc.size(), options);
+        auto msg = other->Messages_Get(0).Clone();
+        auto clone = other->Clone();
+        other.reset();
+        REQUIRE(msg->Comment() == "Message comment; with a semicolon");
+        REQUIRE(*clone == *eager);
+        auto merged = INetwork::LoadDBCFromMemory(dbc.data(), dbc.size(), options);
+        merged->Merge(INetwork::LoadDBCFromMemory(dbc.data(), dbc.size(), options));
+        REQUIRE(merged->Messages_Size() == 4);
+        REQUIRE(merged->Messages_Get(3).Signals_Get(0).Comment().empty());
+        REQUIRE(merged->Messages_Get(2).Signals_Get(0).Comment() == "Signal comment /* not a comment */");
+
+        // broken cold statements are ignored instead of failing the load
+        std::string broken = dbc + "CM_ BO_ x \"Broken\";\n";
+        auto net = INetwork::LoadDBCFromMemory(broken.data(), broken.size(), options);
+        REQUIRE(net);
+        REQUIRE(net->Messages_Get(0).Comment() == "Message comment; with a semicolon");
+        REQUIRE(!INetwork::LoadDBCFromMemory(broken.data(), broken.size()));
+    }
+}
+TEST_CASE("API Test: Loading several files", "[]")
+{
+    std::vector<std::filesystem::path> files;
+    for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+    {
+        if (dbc_file.path().extension() == ".dbc" && INetwork::LoadDBCFromFile(dbc_file.path()))
+        {
+            files.push_back(dbc_file.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    REQUIRE(files.size() > 2);
+
+    SECTION("CPP API")
+    {
+        auto to_dbc =
+            [](const INetwork& net)
+            {
+                using namespace Network2DBC;
+                std::ostringstream os;
+                os << net;
+                return os.str();
+            };
+        auto sequential = INetwork::LoadDBCFromFile(files[0]);
+        for (std::size_t i = 1; i < files.size(); i++)
+        {
+            sequential->Merge(INetwork::LoadDBCFromFile(files[i]));
+        }
+        const std::string expected = to_dbc(*sequential);
+        for (std::size_t threads : {0, 1, 3})
+        {
+            auto nets = INetwork::LoadNetworkMapsFromFiles(files, threads);
+            REQUIRE(nets.size() == files.size());
+            for (std::size_t i = 0; i < files.size(); i++)
+            {
+                REQUIRE(nets[i].size() == 1);
+                REQUIRE(*nets[i][""] == *INetwork::LoadDBCFromFile(files[i]));
+            }
+            auto merged = INetwork::LoadNetworksFromFiles(files, threads);
+            REQUIRE(merged);
+            REQUIRE(merged->Messages_Size() == sequential->Messages_Size());
+            REQUIRE(to_dbc(*merged) == expected);
+        }
+        REQUIRE(INetwork::LoadNetworksFromFiles({})->Messages_Size() == 0);
+        files.insert(files.begin() + 1, std::filesystem::path(TEST_FILES_PATH) / "does_not_exist.dbc");
+        auto nets = INetwork::LoadNetworkMapsFromFiles(files, 2);
+        REQUIRE(nets[0].size() == 1);
+        REQUIRE(nets[1].empty());
+        REQUIRE(!INetwork::LoadNetworksFromFiles(files, 2));
+    }
+}
+TEST_CASE("API Test: Network2DBC", "[]")
+{
+    std::string content =
+        "VERSION \"1.0\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_: A B\n";
+    std::string comments;
+    std::string attribute_values;
+    std::string value_descriptions;
+    for (std::size_t i = 0; i < 3000; i++)
+    {
+        std::string id = std::to_string(i);
+        content +=
+            "BO_ " + id + " Msg" + id + ": 8 A\n"
+            " SG_ Sig" + id + "_0 : 0|16@1+ (0.1,-5) [0|6548.5] \"km/h\" B\n"
+            " SG_ Sig" + id + "_1 : 23|16@0- (0.333333333333,1e-9) [-10922.6666666|10922.6666666] \"\" A, B\n\n";
+        comments += "CM_ SG_ " + id + " Sig" + id + "_1 \"Comment " + id + "\";\n";
+        attribute_values += "BA_ \"GenMsgCycleTime\" BO_ " + id + " " + std::to_string(i % 100) + ";\n";
+        value_descriptions += "VAL_ " + id + " Sig" + id + "_0 0 \"Zero\" 1 \"One\" ;\n";
+    }
+    content += comments + "BA_DEF_ BO_ \"GenMsgCycleTime\" INT 0 1000;\n" + attribute_values + value_descriptions;
+    auto net = INetwork::LoadDBCFromMemory(content.data(), content.size());
+    REQUIRE(net);
+
+    SECTION("CPP API")
+    {
+        using namespace Network2DBC;
+        for (int precision : {6, 10})
+        {
+            std::ostringstream os;
+            os << std::setprecision(precision) << *net;
+            const std::string dbc = os.str();
+            // the messages are written like on their own
+            std::ostringstream messages;
+            messages << std::setprecision(precision);
+            for (const IMessage& msg : net->Messages())
+            {
+                messages << msg;
+            }
+            REQUIRE(dbc.find("BU_: A B\n" + messages.str() + "CM_ SG_ 0 Sig0_1 \"Comment 0\";\n") != std::string::npos);
+            auto test = INetwork::LoadDBCFromMemory(dbc.data(), dbc.size());
+            REQUIRE(test);
+            std::ostringstream test_os;
+            test_os << std::setprecision(precision) << *test;
+            REQUIRE(test_os.str() == dbc);
+        }
+        // the formatting of the stream is used
+        const auto& sig = net->Messages_Get(0).Signals_Get(0);
+        std::ostringstream os;
+        os << sig;
+        REQUIRE(os.str() == "\tSG_ Sig0_0 : 0|16@1+ (0.1,-5) [0|6548.5] \"km/h\" B\n");
+        os.str("");
+        os << std::fixed << std::setprecision(2) << sig;
+        REQUIRE(os.str() == "\tSG_ Sig0_0 : 0|16@1+ (0.10,-5.00) [0.00|6548.50] \"km/h\" B\n");
+    }
+}
+TEST_CASE("API Test: Network2Human", "[]")
+{
+    std::string content =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_:\n"
+        "BO_ 1 Msg: 3 Vector__XXX\n"
+        " SG_ Mux M : 0|4@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        " SG_ A m1 : 4|4@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        " SG_ B : 13|4@0+ (1,0) [0|0] \"\" Vector__XXX\n";
+    auto net = INetwork::LoadDBCFromMemory(content.data(), content.size());
+    REQUIRE(net);
+
+    SECTION("CPP API")
+    {
+        using namespace Network2Human;
+        std::ostringstream os;
+        os << net->Messages_Get(0);
+        const std::string human = os.str();
+        REQUIRE(human.find("Mux: 1\n") != std::string::npos);
+        REQUIRE(human.find("0 |<-------------x|<-------------x|\n") != std::string::npos);
+        // the big endian signal only occupies bit 13 to 10
+        REQUIRE(human.find("1 |   |   |----------------   |   |\n") != std::string::npos);
+        REQUIRE(human.find("2 |   |   |   |   |   |   |   |   |\n") != std::string::npos);
+    }
+}
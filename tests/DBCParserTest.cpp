@@ -48,3 +48,109 @@ TEST_CASE("DBCParserTest", "[]")
         i++;
     }
 }
+TEST_CASE("DBCParserTest: shared keys", "[]")
+{
+    // comments and attributes of messages sharing an id and of signals sharing a name belong to each of them
+    std::string dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_: A\n"
+        "BO_ 1 Msg1: 8 A\n"
+        " SG_ Sig : 0|8@1+ (1,0) [0|0] \"\" A\n"
+        " SG_ Sig : 8|8@1+ (1,0) [0|0] \"\" A\n"
+        "BO_ 1 Msg2: 8 A\n"
+        "CM_ BO_ 1 \"A message comment which doesn't fit into a small string\";\n"
+        "CM_ SG_ 1 Sig \"A signal comment which doesn't fit into a small string\";\n"
+        "BA_DEF_ BO_ \"MsgAttr\" STRING;\n"
+        "BA_ \"MsgAttr\" BO_ 1 \"A message attribute which doesn't fit into a small string\";\n"
+        "VAL_ 1 Sig 0 \"A value description which doesn't fit into a small string\";\n";
+    auto net = dbcppp::INetwork::LoadDBCFromMemory(dbc.data(), dbc.size());
+    REQUIRE(net);
+    REQUIRE(net->Messages_Size() == 2);
+    for (const auto& msg : net->Messages())
+    {
+        REQUIRE(msg.Comment() == "A message comment which doesn't fit into a small string");
+        REQUIRE(msg.AttributeValues_Size() == 1);
+        REQUIRE(msg.AttributeValues_Get(0).Value() == dbcppp::IAttribute::value_t(std::string("A message attribute which doesn't fit into a small string")));
+    }
+    const auto& msg = net->Messages_Get(0);
+    REQUIRE(msg.Signals_Size() == 2);
+    for (const auto& sig : msg.Signals())
+    {
+        REQUIRE(sig.Comment() == "A signal comment which doesn't fit into a small string");
+        REQUIRE(sig.ValueEncodingDescriptions_Size() == 1);
+        REQUIRE(sig.ValueEncodingDescriptions_Get(0).Description() == "A value description which doesn't fit into a small string");
+    }
+}
+TEST_CASE("DBCParserTest: fast parse", "[]")
+{
+    dbcppp::DBCLoadOptions fast;
+    fast.fast_parse = true;
+    for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+    {
+        if (dbc_file.path().extension() != ".dbc")
+        {
+            continue;
+        }
+        auto spec = dbcppp::INetwork::LoadDBCFromFile(dbc_file.path());
+        auto test = dbcppp::INetwork::LoadDBCFromFile(dbc_file.path(), fast);
+        INFO(dbc_file.path());
+        REQUIRE(bool(spec) == bool(test));
+        if (spec)
+        {
+            REQUIRE(*spec == *test);
+        }
+    }
+    // statements the hand written parser leaves to the grammar are mixed in
+    std::string dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_: A B\n"
+        "VAL_TABLE_ Table 1 \"One\" 0 \"Zero\" ;\n"
+        "BO_ 1 Msg1: 8 A\n"
+        " SG_ Mux M : 0|8@1+ (1,0) [0|0] \"\" A\n"
+        " SG_ Sig m1 : 8|8@0- (0.1,-1e3) [-1.5|+2.25] \"\\\"\\\\unit\\q\" A, B\n"
+        "/* block /* nested */ comment */ // line comment\n"
+        "BO_ 2 Msg2: 8 B\n"
+        " SG_ Big : 0|64@1+ (0.123456789012345678,0) [0|18446744073709551615] \"\xc2\xb0\" B\n"
+        "BO_TX_BU_ 1 : A,B;\n"
+        "EV_ Env: 0 [0|1] \"\" 0 1 DUMMY_NODE_VECTOR0 Vector__XXX;\n"
+        "CM_ \"Network comment\";\n"
+        "CM_ BU_ A \"Node comment\";\n"
+        "CM_ BO_ 1 \"Message\r\ncomment\";\n"
+        "CM_ SG_ 1 Sig \"Signal comment\";\n"
+        "CM_ EV_ Env \"Env var comment\";\n"
+        "BA_DEF_ \"Int\" INT -1 +1;\n"
+        "BA_DEF_ BU_ \"Hex\" HEX 0 255;\n"
+        "BA_DEF_ BO_ \"Float\" FLOAT -0.5 1E3;\n"
+        "BA_DEF_ SG_ \"String\" STRING;\n"
+        "BA_DEF_ EV_ \"Enum\" ENUM \"A\",\"B\";\n"
+        "BA_DEF_DEF_ \"Int\" 0;\n"
+        "BA_DEF_DEF_ \"String\" \"\";\n"
+        "BA_DEF_DEF_REL_ \"Float\" 0;\n"
+        "BA_ \"Int\" 1;\n"
+        "BA_ \"Hex\" BU_ A 255;\n"
+        "BA_ \"Hex\" BU_ B 16;\n"
+        "BA_ \"Float\" BO_ 1 1.25e-2;\n"
+        "BA_ \"String\" SG_ 1 Sig \"Value\";\n"
+        "BA_ \"Enum\" EV_ Env 1;\n"
+        "VAL_ 1 Mux 1 \"One\" 0 \"Zero\" ;\n"
+        "VAL_ Env 0 \"Off\";\n"
+        "SIG_VALTYPE_ 2 Big : 2;\n";
+    auto spec = dbcppp::INetwork::LoadDBCFromMemory(dbc.data(), dbc.size());
+    auto test = dbcppp::INetwork::LoadDBCFromMemory(dbc.data(), dbc.size(), fast);
+    REQUIRE(spec);
+    REQUIRE(test);
+    REQUIRE(*spec == *test);
+    REQUIRE(test->Messages_Get(0).Signals_Get(1).Unit() == "\"\\unit\\q");
+    REQUIRE(test->Messages_Get(1).Signals_Get(0).Factor() == spec->Messages_Get(1).Signals_Get(0).Factor());
+
+    // errors are still reported
+    for (std::string broken : {"BO_ 3 Msg3: 8 A\n", "CM_ \"unterminated;\n", "/* unterminated\n"})
+    {
+        std::string content = dbc + broken;
+        REQUIRE(!dbcppp::INetwork::LoadDBCFromMemory(content.data(), content.size(), fast));
+    }
+}
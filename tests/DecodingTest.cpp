@@ -6,12 +6,19 @@
 #include <ctime>
 #include <chrono>
 #include <random>
+#include <thread>
+#include <sstream>
 #include <string>
 #include <iomanip>
+#include <filesystem>
 
 #include "../include/dbcppp/Network2Functions.h"
 #include "../include/dbcppp/CApi.h"
 #include "../include/dbcppp/Network.h"
+#include "../include/dbcppp/CompiledNetwork.h"
+#include "../src/libdbcppp/SignalImpl.h"
+
+#include "Config.h"
 
 #include "Catch2.h"
 
@@ -142,6 +149,54 @@ uint64_t easy_decode(dbcppp::ISignal& sig, std::vector<uint8_t>& data)
     }
     return result;
 }
+// reference for the activity of a signal, the multiplexing is evaluated recursively by the names of the switches
+bool easy_is_active(const dbcppp::IMessage& msg, std::size_t i, const std::function<uint64_t(std::size_t)>& get_raw, std::size_t depth = 0)
+{
+    using namespace dbcppp;
+    const ISignal& sig = msg.Signals_Get(i);
+    if (depth > msg.Signals_Size())
+    {
+        return false;
+    }
+    if (sig.SignalMultiplexerValues_Size() != 0)
+    {
+        for (const auto& smv : sig.SignalMultiplexerValues())
+        {
+            for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+            {
+                if (msg.Signals_Get(j).Name() != smv.SwitchName())
+                {
+                    continue;
+                }
+                if (easy_is_active(msg, j, get_raw, depth + 1))
+                {
+                    uint64_t raw = get_raw(j);
+                    for (const auto& r : smv.ValueRanges())
+                    {
+                        if (r.from <= raw && raw <= r.to)
+                        {
+                            return true;
+                        }
+                    }
+                }
+                break;
+            }
+        }
+        return false;
+    }
+    if (sig.MultiplexerIndicator() == ISignal::EMultiplexer::MuxValue)
+    {
+        for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+        {
+            if (&msg.Signals_Get(j) == msg.MuxSignal())
+            {
+                return get_raw(j) == sig.MultiplexerSwitchValue();
+            }
+        }
+        return false;
+    }
+    return true;
+}
 TEST_CASE("Decoding")
 {
     using namespace dbcppp;
@@ -183,4 +238,546 @@ TEST_CASE("Decoding")
         REQUIRE(*reinterpret_cast<uint64_t*>(&dec_easy) == *reinterpret_cast<uint64_t*>(&dec_sig));
     }
     //BOOST_TEST_MESSAGE("Done!");
-}
\ No newline at end of file
+}
+TEST_CASE("DecodeAll")
+{
+    using namespace dbcppp;
+
+    std::default_random_engine rng(static_cast<uint32_t>(time(0)));
+    for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+    {
+        if (dbc_file.path().extension() != ".dbc")
+        {
+            continue;
+        }
+        std::ifstream dbc(dbc_file.path());
+        auto net = INetwork::LoadDBCFromIs(dbc);
+        REQUIRE(net);
+        for (const IMessage& msg : net->Messages())
+        {
+            std::vector<ISignal::raw_t> raw(msg.Signals_Size());
+            std::vector<double> phys(msg.Signals_Size());
+            for (std::size_t i = 0; i < 16; i++)
+            {
+                auto data = generate_random_data(64, rng);
+                msg.DecodeAll(&data[0], raw, phys);
+                auto get_raw = [&](std::size_t j) { return msg.Signals_Get(j).Decode(&data[0]); };
+                for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+                {
+                    const ISignal& sig = msg.Signals_Get(j);
+                    if (!easy_is_active(msg, j, get_raw))
+                    {
+                        REQUIRE(std::isnan(phys[j]));
+                        continue;
+                    }
+                    auto dec_raw = sig.Decode(&data[0]);
+                    auto dec_phys = sig.RawToPhys(dec_raw);
+                    REQUIRE(raw[j] == dec_raw);
+                    REQUIRE((phys[j] == dec_phys || (std::isnan(phys[j]) && std::isnan(dec_phys))));
+                }
+            }
+        }
+    }
+}
+TEST_CASE("CompiledNetwork")
+{
+    using namespace dbcppp;
+
+    std::default_random_engine rng(static_cast<uint32_t>(time(0)));
+    for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+    {
+        if (dbc_file.path().extension() != ".dbc")
+        {
+            continue;
+        }
+        std::ifstream dbc(dbc_file.path());
+        auto net = INetwork::LoadDBCFromIs(dbc);
+        REQUIRE(net);
+        auto compiled = CompiledNetwork::Create(*net);
+        REQUIRE(compiled->Messages().size() == net->Messages_Size());
+        for (const IMessage& msg : net->Messages())
+        {
+            const auto* cmsg = compiled->MessageById(msg.Id());
+            REQUIRE(cmsg);
+            if (&net->Messages_Get(cmsg->index) != &msg)
+            {
+                // duplicated id
+                continue;
+            }
+            REQUIRE(compiled->Name(*cmsg) == msg.Name());
+            REQUIRE(cmsg->n_signals == msg.Signals_Size());
+            for (const auto& desc : compiled->Signals(*cmsg))
+            {
+                REQUIRE(compiled->Name(desc) == msg.Signals_Get(desc.index).Name());
+                REQUIRE(compiled->Unit(desc) == msg.Signals_Get(desc.index).Unit());
+            }
+            std::vector<ISignal::raw_t> raw(msg.Signals_Size());
+            std::vector<double> phys(msg.Signals_Size());
+            std::vector<ISignal::raw_t> expected_raw(msg.Signals_Size());
+            std::vector<double> expected_phys(msg.Signals_Size());
+            for (std::size_t i = 0; i < 16; i++)
+            {
+                auto data = generate_random_data(64, rng);
+                msg.DecodeAll(&data[0], expected_raw, expected_phys);
+                compiled->Decode(*cmsg, &data[0], raw, phys);
+                for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+                {
+                    if (std::isnan(expected_phys[j]))
+                    {
+                        REQUIRE(std::isnan(phys[j]));
+                        continue;
+                    }
+                    REQUIRE(raw[j] == expected_raw[j]);
+                    REQUIRE(phys[j] == expected_phys[j]);
+                }
+            }
+        }
+        REQUIRE(compiled->MessageById(uint64_t(-1)) == nullptr);
+    }
+}
+TEST_CASE("DecodeColumn")
+{
+    using namespace dbcppp;
+
+    std::size_t n_tests = 1000;
+    std::size_t max_msg_byte_size = 64;
+    std::size_t n_frames = 37;
+
+    std::default_random_engine rng(static_cast<uint32_t>(time(0)));
+    // the portable kernels and the AVX2 ones if the CPU supports them
+    for (bool avx2 : {false, true})
+    {
+        if (SignalImpl::EnableAVX2Kernels(avx2) != avx2)
+        {
+            continue;
+        }
+        for (std::size_t i = 0; i < n_tests; i++)
+        {
+            auto sig = generate_random_signal(max_msg_byte_size, rng);
+            auto frames = generate_random_data(max_msg_byte_size * n_frames + 8, rng);
+            std::vector<ISignal::raw_t> column(n_frames);
+            sig->DecodeColumn(&frames[0], max_msg_byte_size, n_frames, &column[0]);
+            INFO((avx2 ? "AVX2" : "portable") << " kernels");
+            for (std::size_t j = 0; j < n_frames; j++)
+            {
+                REQUIRE(column[j] == sig->Decode(&frames[j * max_msg_byte_size]));
+            }
+        }
+    }
+    SignalImpl::EnableAVX2Kernels(true);
+}
+void easy_encode(dbcppp::ISignal& sig, uint64_t raw, std::vector<uint8_t>& data)
+{
+    if (sig.ByteOrder() == dbcppp::ISignal::EByteOrder::BigEndian)
+    {
+        auto dstBit = sig.StartBit();
+        auto srcBit = sig.BitSize() - 1;
+        for (auto i = 0; i < sig.BitSize(); i++)
+        {
+            if (raw & (1ull << srcBit))
+            {
+                data[dstBit / 8] |= 1ull << (dstBit % 8);
+            }
+            else
+            {
+                data[dstBit / 8] &= ~(1ull << (dstBit % 8));
+            }
+            if ((dstBit % 8) == 0)
+            {
+                dstBit += 15;
+            }
+            else
+            {
+                --dstBit;
+            }
+            --srcBit;
+        }
+    }
+    else
+    {
+        auto dstBit = sig.StartBit();
+        auto srcBit = 0;
+        for (auto i = 0; i < sig.BitSize(); i++)
+        {
+            if (raw & (1ull << srcBit))
+            {
+                data[dstBit / 8] |= 1ull << (dstBit % 8);
+            }
+            else
+            {
+                data[dstBit / 8] &= ~(1ull << (dstBit % 8));
+            }
+            ++dstBit;
+            ++srcBit;
+        }
+    }
+}
+TEST_CASE("Encoding")
+{
+    using namespace dbcppp;
+
+    std::size_t n_tests = 10000;
+    std::size_t max_msg_byte_size = 64;
+
+    std::default_random_engine rng(static_cast<uint32_t>(time(0)));
+    std::uniform_int_distribution<uint64_t> dist;
+    for (std::size_t i = 0; i < n_tests; i++)
+    {
+        auto sig = generate_random_signal(max_msg_byte_size, rng);
+        auto data = generate_random_data(max_msg_byte_size, rng);
+        auto expected = data;
+        uint64_t raw = dist(rng);
+        easy_encode(*sig, raw, expected);
+        sig->Encode(raw, &data[0]);
+        REQUIRE(data == expected);
+    }
+}
+TEST_CASE("Encoding into exactly sized buffers")
+{
+    using namespace dbcppp;
+
+    std::size_t n_tests = 10000;
+    std::size_t max_msg_byte_size = 64;
+
+    std::default_random_engine rng(static_cast<uint32_t>(time(0)));
+    std::uniform_int_distribution<uint64_t> dist;
+    // the portable kernels and the BMI2 ones if the CPU supports them
+    for (bool bmi2 : {false, true})
+    {
+        if (SignalImpl::EnableBMI2Kernels(bmi2) != bmi2)
+        {
+            continue;
+        }
+        for (std::size_t i = 0; i < n_tests; i++)
+        {
+            auto sig = generate_random_signal(max_msg_byte_size, rng);
+            // the buffer ends with the last byte of the signal, so out of bounds accesses are caught by ASan
+            std::size_t end;
+            if (sig->ByteOrder() == ISignal::EByteOrder::LittleEndian)
+            {
+                end = (sig->StartBit() + sig->BitSize() - 1) / 8 + 1;
+            }
+            else
+            {
+                end = sig->StartBit() / 8 + (sig->BitSize() + (7 - sig->StartBit() % 8) + 7) / 8;
+            }
+            auto data = generate_random_data(max_msg_byte_size, rng);
+            std::vector<uint8_t> frame(data.begin(), data.begin() + end);
+            auto expected = frame;
+            uint64_t raw = dist(rng);
+            easy_encode(*sig, raw, expected);
+            sig->Encode(raw, frame.data());
+            INFO((bmi2 ? "BMI2" : "portable") << " kernels");
+            REQUIRE(frame == expected);
+        }
+    }
+    SignalImpl::EnableBMI2Kernels(true);
+}
+TEST_CASE("EncodeAll")
+{
+    using namespace dbcppp;
+
+    std::default_random_engine rng(static_cast<uint32_t>(time(0)));
+    std::uniform_int_distribution<uint64_t> dist;
+    for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+    {
+        if (dbc_file.path().extension() != ".dbc")
+        {
+            continue;
+        }
+        std::ifstream dbc(dbc_file.path());
+        auto net = INetwork::LoadDBCFromIs(dbc);
+        REQUIRE(net);
+        for (const IMessage& msg : net->Messages())
+        {
+            std::vector<double> phys(msg.Signals_Size());
+            for (std::size_t i = 0; i < 16; i++)
+            {
+                for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+                {
+                    const ISignal& sig = msg.Signals_Get(j);
+                    phys[j] = sig.RawToPhys(sig.PhysToRaw(sig.RawToPhys(dist(rng))));
+                }
+                std::vector<uint8_t> frame(msg.MessageSize() + 8, 0xAA);
+                msg.EncodeAll(phys, &frame[0]);
+                for (std::size_t j = msg.MessageSize(); j < frame.size(); j++)
+                {
+                    REQUIRE(frame[j] == 0xAA);
+                }
+                // reference: start values first, then every active signal
+                std::vector<uint8_t> expected(std::max<std::size_t>(msg.MessageSize(), 8) + 8, 0);
+                for (const ISignal& sig : msg.Signals())
+                {
+                    if (sig.MultiplexerIndicator() == ISignal::EMultiplexer::MuxValue)
+                    {
+                        continue;
+                    }
+                    for (const IAttribute& attr : sig.AttributeValues())
+                    {
+                        if (attr.Name() == "GenSigStartValue")
+                        {
+                            if (auto v = boost::get<int64_t>(&attr.Value())) sig.Encode(*v, &expected[0]);
+                            if (auto v = boost::get<double>(&attr.Value())) sig.Encode(int64_t(*v), &expected[0]);
+                        }
+                    }
+                }
+                auto get_raw = [&](std::size_t j) { return msg.Signals_Get(j).PhysToRaw(phys[j]); };
+                for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+                {
+                    const ISignal& sig = msg.Signals_Get(j);
+                    if (!easy_is_active(msg, j, get_raw))
+                    {
+                        continue;
+                    }
+                    sig.Encode(sig.PhysToRaw(phys[j]), &expected[0]);
+                }
+                INFO(dbc_file.path().string() << " " << msg.Name());
+                REQUIRE(std::equal(frame.begin(), frame.begin() + msg.MessageSize(), expected.begin()));
+            }
+        }
+    }
+}
+TEST_CASE("Multiplexer dispatch")
+{
+    using namespace dbcppp;
+
+    std::default_random_engine rng(static_cast<uint32_t>(time(0)));
+    // 256 dense pages are looked up directly, an additional large switch value forces the binary search
+    for (uint64_t extra_switch_value : {uint64_t(0), uint64_t(40000)})
+    {
+        std::vector<uint64_t> switch_values;
+        for (uint64_t v = 0; v < 256; v++)
+        {
+            switch_values.push_back(v);
+        }
+        if (extra_switch_value)
+        {
+            switch_values.push_back(extra_switch_value);
+        }
+        std::vector<std::unique_ptr<ISignal>> sigs;
+        sigs.push_back(ISignal::Create(8, "Switch", ISignal::EMultiplexer::MuxSwitch, 0, 0, 16,
+            ISignal::EByteOrder::LittleEndian, ISignal::EValueType::Unsigned, 1.0, 0.0, 0.0, 0.0, "", {}, {}, {}, "",
+            ISignal::EExtendedValueType::Integer, {}));
+        for (auto v : switch_values)
+        {
+            sigs.push_back(ISignal::Create(8, "Page", ISignal::EMultiplexer::MuxValue, v, 16 + v % 8, 8 + v % 24,
+                ISignal::EByteOrder::LittleEndian, ISignal::EValueType::Unsigned, 2.0, 1.0, 0.0, 0.0, "", {}, {}, {}, "",
+                ISignal::EExtendedValueType::Integer, {}));
+        }
+        sigs.push_back(ISignal::Create(8, "Always", ISignal::EMultiplexer::NoMux, 0, 48, 16,
+            ISignal::EByteOrder::LittleEndian, ISignal::EValueType::Signed, 1.0, 0.0, 0.0, 0.0, "", {}, {}, {}, "",
+            ISignal::EExtendedValueType::Integer, {}));
+        auto msg = IMessage::Create(1, "Msg", 8, "", {}, std::move(sigs), {}, "", {});
+        REQUIRE(msg->Error() == IMessage::EErrorCode::NoError);
+
+        std::vector<uint64_t> tested = switch_values;
+        tested.push_back(256);
+        tested.push_back(39999);
+        std::vector<ISignal::raw_t> raw(msg->Signals_Size());
+        std::vector<double> phys(msg->Signals_Size());
+        for (auto v : tested)
+        {
+            auto data = generate_random_data(16, rng);
+            msg->Signals_Get(0).Encode(v, &data[0]);
+            msg->DecodeAll(&data[0], raw, phys);
+            for (std::size_t j = 0; j < msg->Signals_Size(); j++)
+            {
+                const ISignal& sig = msg->Signals_Get(j);
+                if (sig.MultiplexerIndicator() == ISignal::EMultiplexer::MuxValue && sig.MultiplexerSwitchValue() != v)
+                {
+                    REQUIRE(std::isnan(phys[j]));
+                    continue;
+                }
+                REQUIRE(raw[j] == sig.Decode(&data[0]));
+                REQUIRE(phys[j] == sig.RawToPhys(sig.Decode(&data[0])));
+            }
+
+            std::vector<uint8_t> frame(8);
+            msg->EncodeAll(phys, &frame[0]);
+            std::vector<uint8_t> expected(16, 0);
+            for (std::size_t j = 0; j < msg->Signals_Size(); j++)
+            {
+                const ISignal& sig = msg->Signals_Get(j);
+                if (sig.MultiplexerIndicator() != ISignal::EMultiplexer::MuxValue || sig.MultiplexerSwitchValue() == v)
+                {
+                    sig.Encode(sig.PhysToRaw(phys[j]), &expected[0]);
+                }
+            }
+            REQUIRE(std::equal(frame.begin(), frame.end(), expected.begin()));
+        }
+    }
+}
+TEST_CASE("ActiveSignals")
+{
+    using namespace dbcppp;
+
+    std::default_random_engine rng(static_cast<uint32_t>(time(0)));
+    for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+    {
+        if (dbc_file.path().extension() != ".dbc")
+        {
+            continue;
+        }
+        std::ifstream dbc(dbc_file.path());
+        auto net = INetwork::LoadDBCFromIs(dbc);
+        REQUIRE(net);
+        for (const IMessage& msg : net->Messages())
+        {
+            std::vector<std::size_t> active(msg.Signals_Size());
+            for (std::size_t i = 0; i < 64; i++)
+            {
+                // every second frame with small values so that the switches hit the multiplexer values more often
+                auto data = generate_random_data(64, rng);
+                for (auto& b : data)
+                {
+                    b &= i % 2 ? 0xFF : 0x3;
+                }
+                auto get_raw = [&](std::size_t j) { return msg.Signals_Get(j).Decode(&data[0]); };
+                std::vector<std::size_t> expected;
+                for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+                {
+                    if (easy_is_active(msg, j, get_raw))
+                    {
+                        expected.push_back(j);
+                    }
+                }
+                std::size_t n = msg.ActiveSignals(&data[0], active);
+                INFO(dbc_file.path().string() << " " << msg.Name());
+                REQUIRE(n == expected.size());
+                REQUIRE(std::equal(expected.begin(), expected.end(), active.begin()));
+            }
+        }
+    }
+}
+TEST_CASE("Extended multiplexing of big messages")
+{
+    using namespace dbcppp;
+
+    // more signals with extended multiplexing than fit on the stack, so they're evaluated in the scratch space
+    std::ostringstream dbc;
+    dbc << "VERSION \"\"\nNS_ :\nBS_:\nBU_:\nBO_ 1 Msg0: 64 Vector__XXX\n";
+    dbc << " SG_ Sw M : 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n";
+    const std::size_t n_extended = 300;
+    for (std::size_t i = 0; i < n_extended; i++)
+    {
+        dbc << " SG_ Sig" << i << " m" << i % 4 << " : " << 8 + i % 56 * 8 << "|8@1+ (2,1) [0|0] \"\" Vector__XXX\n";
+    }
+    for (std::size_t i = 0; i < n_extended; i++)
+    {
+        dbc << "SG_MUL_VAL_ 1 Sig" << i << " Sw " << i % 4 << "-" << i % 4 + i % 2 << ";\n";
+    }
+    std::istringstream iss(dbc.str());
+    auto net = INetwork::LoadDBCFromIs(iss);
+    REQUIRE(net);
+    const IMessage& msg = net->Messages_Get(0);
+    REQUIRE(msg.Signals_Size() == n_extended + 1);
+    auto compiled = CompiledNetwork::Create(*net);
+    const auto& cmsg = compiled->Messages()[0];
+
+    std::default_random_engine rng(static_cast<uint32_t>(time(0)));
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<std::vector<std::size_t>> expected;
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        auto data = generate_random_data(64, rng);
+        data[0] = uint8_t(i % 5);
+        auto get_raw = [&](std::size_t j) { return msg.Signals_Get(j).Decode(&data[0]); };
+        expected.emplace_back();
+        for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+        {
+            if (easy_is_active(msg, j, get_raw))
+            {
+                expected.back().push_back(j);
+            }
+        }
+        frames.push_back(std::move(data));
+    }
+    // the threads evaluate the same graphs concurrently
+    std::vector<uint8_t> ok(4, 1);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < ok.size(); t++)
+    {
+        threads.emplace_back(
+            [&, t]
+            {
+                std::vector<std::size_t> active(msg.Signals_Size());
+                std::vector<ISignal::raw_t> raw(msg.Signals_Size());
+                std::vector<double> phys(msg.Signals_Size());
+                std::vector<ISignal::raw_t> compiled_raw(msg.Signals_Size());
+                std::vector<double> compiled_phys(msg.Signals_Size());
+                for (std::size_t round = 0; round < 100; round++)
+                {
+                    for (std::size_t i = 0; i < frames.size(); i++)
+                    {
+                        std::size_t n = msg.ActiveSignals(&frames[i][0], active);
+                        msg.DecodeAll(&frames[i][0], raw, phys);
+                        compiled->Decode(cmsg, &frames[i][0], compiled_raw, compiled_phys);
+                        bool equal = n == expected[i].size() && std::equal(expected[i].begin(), expected[i].end(), active.begin());
+                        for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+                        {
+                            bool is_active = std::binary_search(expected[i].begin(), expected[i].end(), j);
+                            equal &= is_active != std::isnan(phys[j]);
+                            equal &= is_active != std::isnan(compiled_phys[j]);
+                            equal &= !is_active || (raw[j] == compiled_raw[j] && phys[j] == compiled_phys[j]);
+                        }
+                        ok[t] &= equal;
+                    }
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    REQUIRE(std::count(ok.begin(), ok.end(), 1) == ok.size());
+}
+TEST_CASE("Decoding benchmark", "[.][benchmark]")
+{
+    using namespace dbcppp;
+
+    struct Layout
+    {
+        const char* name;
+        uint64_t start_bit;
+        uint64_t bit_size;
+        ISignal::EByteOrder byte_order;
+    };
+    // one signal per alignment class and byte order in a 16 byte frame
+    const Layout layouts[] =
+    {
+        {"first 64 bit, little endian", 4, 12, ISignal::EByteOrder::LittleEndian},
+        {"first 64 bit, big endian", 15, 12, ISignal::EByteOrder::BigEndian},
+        {"beyond 64 bit, little endian", 68, 12, ISignal::EByteOrder::LittleEndian},
+        {"beyond 64 bit, big endian", 79, 12, ISignal::EByteOrder::BigEndian},
+        {"nine bytes, little endian", 4, 62, ISignal::EByteOrder::LittleEndian},
+        {"nine bytes, big endian", 3, 62, ISignal::EByteOrder::BigEndian}
+    };
+    std::default_random_engine rng(static_cast<uint32_t>(time(0)));
+    auto data = generate_random_data(16, rng);
+    for (bool bmi2 : {false, true})
+    {
+        if (SignalImpl::EnableBMI2Kernels(bmi2) != bmi2)
+        {
+            continue;
+        }
+        const std::string kernels = bmi2 ? " (BMI2): " : " (portable): ";
+        for (const auto& layout : layouts)
+        {
+            auto sig = ISignal::Create(16, "Signal", ISignal::EMultiplexer::NoMux, 0, layout.start_bit, layout.bit_size,
+                layout.byte_order, ISignal::EValueType::Signed, 1.0, 0.0, 0.0, 0.0, "", {}, {}, {}, "",
+                ISignal::EExtendedValueType::Integer, {});
+            REQUIRE(sig->Error(ISignal::EErrorCode::NoError));
+            REQUIRE(sig->Decode(&data[0]) == easy_decode(*sig, data));
+            BENCHMARK("Decode" + kernels + layout.name)
+            {
+                return sig->Decode(&data[0]);
+            };
+            BENCHMARK("Encode" + kernels + layout.name)
+            {
+                sig->Encode(0x155, &data[0]);
+                return data[0];
+            };
+        }
+    }
+    SignalImpl::EnableBMI2Kernels(true);
+}
@@ -0,0 +1,77 @@
+#ifdef ENABLE_KCD
+
+#include <map>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+
+#include "dbcppp/Network.h"
+
+#include "Config.h"
+
+#include "Catch2.h"
+
+TEST_CASE("KCDParserTest", "[]")
+{
+    const std::map<std::string, std::size_t> n_messages = {
+        {"Test.kcd", 25}, {"bad_message_length.kcd", 1}, {"dump.kcd", 4}, {"empty.kcd", 0},
+        {"message_layout.kcd", 8}, {"signal_range.kcd", 4}, {"tester.kcd", 3}, {"the_homer.kcd", 33}};
+    std::size_t n_files = 0;
+    for (const auto& kcd_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "kcd"))
+    {
+        if (kcd_file.path().extension() != ".kcd")
+        {
+            continue;
+        }
+        INFO(kcd_file.path());
+        std::ifstream is(kcd_file.path());
+        auto nets = dbcppp::INetwork::LoadKCDFromIs(is);
+        std::size_t n = 0;
+        for (const auto& [name, net] : nets)
+        {
+            REQUIRE(net);
+            n += net->Messages_Size();
+        }
+        REQUIRE(n == n_messages.at(kcd_file.path().filename().string()));
+        n_files++;
+    }
+    REQUIRE(n_files == n_messages.size());
+
+    auto nets = dbcppp::INetwork::LoadNetworkFromFile(std::filesystem::path(TEST_FILES_PATH) / "kcd" / "the_homer.kcd");
+    REQUIRE(nets.size() == 3);
+    const auto& motor = *nets.at("Motor");
+    REQUIRE(motor.BitTiming().Baudrate() == 500000);
+    REQUIRE(motor.Nodes_Size() > 0);
+    const auto* airbag = motor.MessageById(0x00A);
+    REQUIRE(airbag);
+    REQUIRE(airbag->Name() == "Airbag");
+    REQUIRE(airbag->MessageSize() == 3);
+    REQUIRE(airbag->Signals_Size() == 8);
+    REQUIRE(airbag->Signals_Get(6).BitSize() == 8);
+    const auto* abs = motor.MessageById(0x0B2);
+    REQUIRE(abs);
+    // the multiplexer comes first, followed by the multiplexed signals of all groups
+    REQUIRE(abs->Signals_Get(0).Name() == "ABS_InfoMux");
+    REQUIRE(abs->Signals_Get(0).MultiplexerIndicator() == dbcppp::ISignal::EMultiplexer::MuxSwitch);
+    REQUIRE(abs->Signals_Get(3).Name() == "Info2");
+    REQUIRE(abs->Signals_Get(3).MultiplexerSwitchValue() == 1);
+    const auto* outside_temp = abs->SignalByName("OutsideTemp");
+    REQUIRE(outside_temp);
+    REQUIRE(outside_temp->Factor() == 0.05);
+    REQUIRE(outside_temp->Offset() == -40);
+    REQUIRE(outside_temp->Unit() == "Cel");
+    REQUIRE(outside_temp->Receivers_Size() == 1);
+    REQUIRE(outside_temp->ValueEncodingDescriptions_Size() > 0);
+
+    for (std::string broken : {
+            "<Bus name=\"Bus\"/>",
+            "<NetworkDefinition><Bus name=\"Bus\">",
+            "<NetworkDefinition><Node name=\"Node\"/></NetworkDefinition>",
+            "<NetworkDefinition><Bus><Message id=\"1\" name=\"Msg\"><Producer><NodeRef id=\"1\"/></Producer></Message></Bus></NetworkDefinition>"})
+    {
+        std::istringstream is(broken);
+        REQUIRE_THROWS(dbcppp::INetwork::LoadKCDFromIs(is));
+    }
+}
+
+#endif